@@ -0,0 +1,30 @@
+######################################################################
+#              Benchmarks de QElectroTech (QTest)                    #
+######################################################################
+
+# Build :  qmake benchmarks/benchmarks.pro && make
+# Run   :  ./qetbenchmarks -platform offscreen -o results.xml,xml
+# The peak memory of each benchmark is written to the json file
+# given by the QET_BENCHMARK_MEMORY environment variable
+# (qet_benchmark_memory.json by default).
+
+include(../qelectrotech.pri)
+
+TEMPLATE = app
+TARGET = qetbenchmarks
+CONFIG += c++11 warn_on console testcase no_testcase_installs
+CONFIG -= app_bundle
+QT += testlib
+
+QMAKE_CXXFLAGS += -std=c++11
+
+DEFINES += QET_ALLOW_OVERRIDE_CED_OPTION \
+           QET_ALLOW_OVERRIDE_CTBTD_OPTION \
+           QET_ALLOW_OVERRIDE_CD_OPTION \
+           QET_SOURCE_DIR=$$clean_path($$PWD/..)
+
+unix:QMAKE_LIBS_THREAD -= -lpthread
+
+# The benchmarks provide their own main()
+SOURCES -= $$PWD/../sources/main.cpp
+SOURCES += $$PWD/qetbenchmark.cpp
@@ -0,0 +1,462 @@
+/*
+	Copyright 2006-2019 The QElectroTech Team
+	This file is part of QElectroTech.
+	
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+	
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "qetapp.h"
+#include "qetproject.h"
+#include "diagram.h"
+#include "conductor.h"
+#include "exportdialog.h"
+#include "nomenclature.h"
+#include "elementslocation.h"
+#include "elementpicturefactory.h"
+#include "elementscollectionmodel.h"
+
+#include <QtTest>
+#include <QBuffer>
+#include <QDirIterator>
+#include <QDomDocument>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#endif
+
+#define QUOTE(x) STRINGIFY(x)
+#define STRINGIFY(x) #x
+
+namespace {
+	/**
+	 * @brief peakMemory
+	 * @return the peak resident memory of the process in bytes, or -1 if unknown
+	 */
+	qint64 peakMemory()
+	{
+#ifdef Q_OS_LINUX
+		QFile status("/proc/self/status");
+		if (status.open(QIODevice::ReadOnly | QIODevice::Text))
+		{
+			for (const QByteArray &line : status.readAll().split('\n')) {
+				if (line.startsWith("VmHWM:")) {
+					return line.mid(6).trimmed().split(' ').first().toLongLong() * 1024;
+				}
+			}
+		}
+#endif
+#ifdef Q_OS_UNIX
+		struct rusage usage;
+		if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef Q_OS_MAC
+			return usage.ru_maxrss;
+#else
+			return qint64(usage.ru_maxrss) * 1024;
+#endif
+		}
+#endif
+		return -1;
+	}
+
+	/**
+	 * @brief resetPeakMemory
+	 * Reset the peak resident memory of the process, only available on Linux
+	 */
+	void resetPeakMemory()
+	{
+#ifdef Q_OS_LINUX
+		QFile clear_refs("/proc/self/clear_refs");
+		if (clear_refs.open(QIODevice::WriteOnly)) {
+			clear_refs.write("5");
+		}
+#endif
+	}
+
+	/**
+	 * @brief tileDiagram
+	 * Append to @diagram @count copies of the elements and conductors of @source.
+	 * The uuids and the terminal ids of each copy are renewed, and the links
+	 * between elements are removed.
+	 */
+	void tileDiagram(QDomElement &diagram, const QDomElement &source, int count)
+	{
+		QDomElement elements = diagram.firstChildElement("elements");
+		QDomElement conductors = diagram.firstChildElement("conductors");
+		const QDomNodeList source_elements = source.firstChildElement("elements").elementsByTagName("element");
+		const QDomNodeList source_conductors = source.firstChildElement("conductors").elementsByTagName("conductor");
+
+		int max_id = 0;
+		const QDomNodeList terminals = source.elementsByTagName("terminal");
+		for (int i = 0 ; i < terminals.size() ; ++i) {
+			max_id = qMax(max_id, terminals.at(i).toElement().attribute("id").toInt());
+		}
+
+		for (int tile = 1 ; tile <= count ; ++tile)
+		{
+			const int id_offset = (max_id + 1) * tile;
+			for (int i = 0 ; i < source_elements.size() ; ++i)
+			{
+				QDomElement element = source_elements.at(i).cloneNode(true).toElement();
+				element.setAttribute("uuid", QUuid::createUuid().toString());
+				element.setAttribute("x", element.attribute("x").toDouble() + 10 * tile);
+				element.setAttribute("y", element.attribute("y").toDouble() + 10 * tile);
+				element.removeChild(element.firstChildElement("links_uuids"));
+
+				const QDomNodeList element_terminals = element.elementsByTagName("terminal");
+				for (int j = 0 ; j < element_terminals.size() ; ++j)
+				{
+					QDomElement terminal = element_terminals.at(j).toElement();
+					terminal.setAttribute("id", terminal.attribute("id").toInt() + id_offset);
+				}
+				elements.appendChild(element);
+			}
+
+			for (int i = 0 ; i < source_conductors.size() ; ++i)
+			{
+				QDomElement conductor = source_conductors.at(i).cloneNode(true).toElement();
+				conductor.setAttribute("terminal1", conductor.attribute("terminal1").toInt() + id_offset);
+				conductor.setAttribute("terminal2", conductor.attribute("terminal2").toInt() + id_offset);
+				conductors.appendChild(conductor);
+			}
+		}
+	}
+
+	/**
+	 * @brief syntheticProject
+	 * Write in @dir a project of @folios folios of at least @elements elements,
+	 * built by repeating the folios of the example @example.
+	 * @return the path of the written project, or an empty string on failure
+	 */
+	QString syntheticProject(const QString &example, int folios, int elements, const QString &dir)
+	{
+		QFile file(example);
+		QDomDocument document;
+		if (!file.open(QIODevice::ReadOnly) || !document.setContent(&file)) {
+			return QString();
+		}
+
+		QDomElement root = document.documentElement();
+		QList<QDomElement> source_diagrams;
+		for (QDomElement diagram = root.firstChildElement("diagram") ; !diagram.isNull() ; diagram = diagram.nextSiblingElement("diagram")) {
+			if (diagram.firstChildElement("elements").elementsByTagName("element").size()) {
+				source_diagrams << diagram;
+			}
+		}
+		if (source_diagrams.isEmpty()) {
+			return QString();
+		}
+		for (QDomElement diagram = root.firstChildElement("diagram") ; !diagram.isNull() ; diagram = root.firstChildElement("diagram")) {
+			root.removeChild(diagram);
+		}
+
+		for (int i = 0 ; i < folios ; ++i)
+		{
+			const QDomElement source = source_diagrams.at(i % source_diagrams.size());
+			QDomElement diagram = source.cloneNode(true).toElement();
+			diagram.setAttribute("order", i + 1);
+			diagram.setAttribute("title", QString("Folio %1").arg(i + 1));
+
+				//Each folio is a copy of its source folio, the links between folios are removed
+			const QDomNodeList links = diagram.elementsByTagName("links_uuids");
+			for (int j = links.size() - 1 ; j >= 0 ; --j) {
+				links.at(j).parentNode().removeChild(links.at(j));
+			}
+			const QDomNodeList uuids = diagram.firstChildElement("elements").elementsByTagName("element");
+			for (int j = 0 ; j < uuids.size() ; ++j) {
+				uuids.at(j).toElement().setAttribute("uuid", QUuid::createUuid().toString());
+			}
+
+			const int source_count = source.firstChildElement("elements").elementsByTagName("element").size();
+			const int tiles = (elements + source_count - 1) / source_count - 1;
+			if (tiles > 0) {
+				tileDiagram(diagram, source, tiles);
+			}
+			root.appendChild(diagram);
+		}
+
+		const QString path = QString("%1/synthetic_%2x%3.qet").arg(dir).arg(folios).arg(elements);
+		QFile output(path);
+		if (!output.open(QIODevice::WriteOnly)) {
+			return QString();
+		}
+		output.write(document.toByteArray(0));
+		return path;
+	}
+}
+
+/**
+ * @brief The QetBenchmark class
+ * Benchmarks of the main workloads of QElectroTech, over the bundled examples,
+ * synthetic projects built from them, and the common elements collection.
+ * Timings are reported by QTest (use -o file,xml or -o file,csv for a machine-readable output),
+ * the peak memory of each benchmark is written in a json file.
+ */
+class QetBenchmark : public QObject
+{
+	Q_OBJECT
+
+	private slots:
+		void initTestCase();
+		void cleanupTestCase();
+		void init();
+		void cleanup();
+
+		void openFile_data();
+		void openFile();
+		void write_data() {projectsData();}
+		void write();
+		void loadCollections();
+		void buildElementPictures();
+		void toPaintDevice_data() {projectsData();}
+		void toPaintDevice();
+		void generateSvg_data() {projectsData();}
+		void generateSvg();
+		void generateDxf_data() {projectsData();}
+		void generateDxf();
+		void nomenclature_data() {projectsData();}
+		void nomenclature();
+		void potentials_data() {projectsData();}
+		void potentials();
+
+	private:
+		void projectsData();
+		QETProject *openProject();
+
+	private:
+		QTemporaryDir m_dir;
+		QStringList m_projects;
+		QJsonObject m_memory;
+};
+
+/**
+ * @brief QetBenchmark::initTestCase
+ * Use the collections of the source tree and build the synthetic projects
+ */
+void QetBenchmark::initTestCase()
+{
+	QVERIFY(m_dir.isValid());
+	const QString source_dir(QUOTE(QET_SOURCE_DIR));
+
+	QCoreApplication::setOrganizationName("QElectroTech-benchmarks");
+	QETApp::overrideConfigDir(m_dir.path() + "/config");
+	QETApp::overrideCommonElementsDir(source_dir + "/elements");
+	QETApp::overrideCommonTitleBlockTemplatesDir(source_dir + "/titleblocks");
+
+	for (const QString &example : {"ArduinoLCD.qet", "affuteuse_250h.qet", "industrial.qet"}) {
+		m_projects << source_dir + "/examples/" + example;
+	}
+
+	const QString industrial = source_dir + "/examples/industrial.qet";
+	for (const QPair<int, int> &size : {qMakePair(10, 100), qMakePair(50, 100), qMakePair(20, 500)})
+	{
+		const QString path = syntheticProject(industrial, size.first, size.second, m_dir.path());
+		QVERIFY(!path.isEmpty());
+		m_projects << path;
+	}
+}
+
+/**
+ * @brief QetBenchmark::cleanupTestCase
+ * Write the peak memory of each benchmark
+ */
+void QetBenchmark::cleanupTestCase()
+{
+	QString path = QString::fromLocal8Bit(qgetenv("QET_BENCHMARK_MEMORY"));
+	if (path.isEmpty()) {
+		path = "qet_benchmark_memory.json";
+	}
+
+	QFile file(path);
+	if (file.open(QIODevice::WriteOnly)) {
+		file.write(QJsonDocument(m_memory).toJson());
+	}
+}
+
+void QetBenchmark::init() {
+	resetPeakMemory();
+}
+
+void QetBenchmark::cleanup()
+{
+	QString name = QTest::currentTestFunction();
+	if (QTest::currentDataTag()) {
+		name += QString(":") + QTest::currentDataTag();
+	}
+	m_memory.insert(name, peakMemory());
+}
+
+/**
+ * @brief QetBenchmark::projectsData
+ * One row per benchmarked project
+ */
+void QetBenchmark::projectsData()
+{
+	QTest::addColumn<QString>("path");
+	for (const QString &path : m_projects) {
+		QTest::newRow(qPrintable(QFileInfo(path).completeBaseName())) << path;
+	}
+}
+
+/**
+ * @brief QetBenchmark::openProject
+ * @return the project of the current row, with all its folios materialized
+ */
+QETProject *QetBenchmark::openProject()
+{
+	QFETCH(QString, path);
+	QETProject *project = new QETProject(path);
+	for (Diagram *diagram : project->diagrams()) {
+		diagram->materialize();
+	}
+	return project;
+}
+
+/**
+ * @brief QetBenchmark::openFile_data
+ * Two rows per project : the folios built at the opening,
+ * and the folios kept dehydrated (the default)
+ */
+void QetBenchmark::openFile_data()
+{
+	QTest::addColumn<QString>("path");
+	QTest::addColumn<bool>("dehydrate");
+	for (const QString &path : m_projects)
+	{
+		const QString name = QFileInfo(path).completeBaseName();
+		QTest::newRow(qPrintable(name + ":built")) << path << false;
+		QTest::newRow(qPrintable(name + ":dehydrated")) << path << true;
+	}
+}
+
+void QetBenchmark::openFile()
+{
+	QFETCH(QString, path);
+	QFETCH(bool, dehydrate);
+
+	QSettings settings;
+	settings.setValue("diagrameditor/dehydrate-folios", dehydrate);
+
+	QBENCHMARK {
+		QETProject project(path);
+		QCOMPARE(project.state(), QETProject::Ok);
+	}
+
+	settings.remove("diagrameditor/dehydrate-folios");
+}
+
+void QetBenchmark::write()
+{
+	QScopedPointer<QETProject> project(openProject());
+	project->setFilePath(m_dir.path() + "/write.qet");
+	QBENCHMARK {
+		QVERIFY(project->write().isOk());
+	}
+}
+
+void QetBenchmark::loadCollections()
+{
+	QBENCHMARK {
+		ElementsCollectionModel model;
+		model.loadCollections(true, false, QList<QETProject *>());
+	}
+}
+
+void QetBenchmark::buildElementPictures()
+{
+	const QString root = QETApp::commonElementsDir();
+	QList<ElementsLocation> locations;
+	QDirIterator it(root, QStringList("*.elmt"), QDir::Files, QDirIterator::Subdirectories);
+	while (it.hasNext()) {
+		locations << ElementsLocation("common://" + QDir(root).relativeFilePath(it.next()));
+	}
+	QVERIFY(!locations.isEmpty());
+
+	QBENCHMARK {
+		ElementPictureFactory::dropInstance();
+		QPicture picture, low_picture;
+		for (const ElementsLocation &location : locations) {
+			ElementPictureFactory::instance()->getPictures(location, picture, low_picture);
+		}
+	}
+}
+
+void QetBenchmark::toPaintDevice()
+{
+	QScopedPointer<QETProject> project(openProject());
+	QBENCHMARK {
+		for (Diagram *diagram : project->diagrams())
+		{
+			QImage image(diagram->imageSize(), QImage::Format_ARGB32);
+			diagram->toPaintDevice(image);
+		}
+	}
+}
+
+void QetBenchmark::generateSvg()
+{
+	QScopedPointer<QETProject> project(openProject());
+	ExportDialog dialog(project.data());
+	QBENCHMARK {
+		for (Diagram *diagram : project->diagrams())
+		{
+			QBuffer buffer;
+			buffer.open(QIODevice::WriteOnly);
+			const QSize size = diagram->imageSize();
+			dialog.generateSvg(diagram, size.width(), size.height(), true, buffer);
+		}
+	}
+}
+
+void QetBenchmark::generateDxf()
+{
+	QScopedPointer<QETProject> project(openProject());
+	ExportDialog dialog(project.data());
+	QString path = m_dir.path() + "/export.dxf";
+	QBENCHMARK {
+		for (Diagram *diagram : project->diagrams())
+		{
+			const QSize size = diagram->imageSize();
+			dialog.generateDxf(diagram, size.width(), size.height(), true, path);
+		}
+	}
+}
+
+void QetBenchmark::nomenclature()
+{
+	QScopedPointer<QETProject> project(openProject());
+	::nomenclature nomenclature(project.data());
+	const QString path = m_dir.path() + "/nomenclature.csv";
+	QBENCHMARK {
+		QVERIFY(nomenclature.saveToCSVFile(path, ::nomenclature::FlatList));
+	}
+}
+
+void QetBenchmark::potentials()
+{
+	QScopedPointer<QETProject> project(openProject());
+	QList<Conductor *> conductors;
+	for (Diagram *diagram : project->diagrams()) {
+		conductors << diagram->conductors();
+	}
+	QBENCHMARK {
+		for (Conductor *conductor : conductors) {
+			conductor->relatedPotentialConductors();
+		}
+	}
+}
+
+QTEST_MAIN(QetBenchmark)
+#include "qetbenchmark.moc"
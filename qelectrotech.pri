@@ -0,0 +1,102 @@
+######################################################################
+#        Sources de QElectroTech, partagees par les projets qmake     #
+######################################################################
+
+# Inclus par qelectrotech.pro et par benchmarks/benchmarks.pro
+
+include($$PWD/sources/PropertiesEditor/PropertiesEditor.pri)
+include($$PWD/sources/QetGraphicsItemModeler/QetGraphicsItemModeler.pri)
+include($$PWD/sources/QPropertyUndoCommand/QPropertyUndoCommand.pri)
+include($$PWD/SingleApplication/singleapplication.pri)
+DEFINES += QAPPLICATION_CLASS=QApplication
+
+INCLUDEPATH += $$PWD/sources \
+               $$PWD/sources/titleblock \
+               $$PWD/sources/ui $$PWD/sources/qetgraphicsitem \
+               $$PWD/sources/richtext \
+               $$PWD/sources/factory \
+               $$PWD/sources/properties \
+               $$PWD/sources/dvevent \
+               $$PWD/sources/editor \
+               $$PWD/sources/editor/esevent \
+               $$PWD/sources/editor/graphicspart \
+			   $$PWD/sources/editor/ui \
+               $$PWD/sources/undocommand \
+               $$PWD/sources/diagramevent \
+               $$PWD/sources/ElementsCollection \
+               $$PWD/sources/ElementsCollection/ui \
+               $$PWD/sources/autoNum \
+               $$PWD/sources/autoNum/ui \
+               $$PWD/sources/ui/configpage \
+			   $$PWD/sources/SearchAndReplace \
+			   $$PWD/sources/SearchAndReplace/ui \
+			   $$PWD/sources/NameList \
+			   $$PWD/sources/NameList/ui \
+			   $$PWD/sources/utils
+
+
+# Fichiers sources
+HEADERS += $$files($$PWD/sources/*.h) $$files($$PWD/sources/ui/*.h) \
+           $$files($$PWD/sources/editor/*.h) \
+           $$files($$PWD/sources/titleblock/*.h) \
+           $$files($$PWD/sources/richtext/*.h) \
+           $$files($$PWD/sources/qetgraphicsitem/*.h) \
+           $$files($$PWD/sources/factory/*.h) \
+           $$files($$PWD/sources/properties/*.h) \
+           $$files($$PWD/sources/editor/ui/*.h) \
+           $$files($$PWD/sources/editor/esevent/*.h) \
+           $$files($$PWD/sources/editor/graphicspart/*.h) \
+           $$files($$PWD/sources/dvevent/*.h) \
+           $$files($$PWD/sources/undocommand/*.h) \
+           $$files($$PWD/sources/diagramevent/*.h) \
+           $$files($$PWD/sources/ElementsCollection/*.h) \
+           $$files($$PWD/sources/ElementsCollection/ui/*.h) \
+           $$files($$PWD/sources/autoNum/*.h) \
+           $$files($$PWD/sources/autoNum/ui/*.h) \
+           $$files($$PWD/sources/ui/configpage/*.h) \
+           $$files($$PWD/sources/SearchAndReplace/*.h) \
+		   $$files($$PWD/sources/SearchAndReplace/ui/*.h) \
+		   $$files($$PWD/sources/NameList/*.h) \
+		   $$files($$PWD/sources/NameList/ui/*.h) \
+		   $$files($$PWD/sources/utils/*.h)
+
+SOURCES += $$files($$PWD/sources/*.cpp) \
+           $$files($$PWD/sources/editor/*.cpp) \
+           $$files($$PWD/sources/titleblock/*.cpp) \
+           $$files($$PWD/sources/richtext/*.cpp) \
+           $$files($$PWD/sources/ui/*.cpp) \
+           $$files($$PWD/sources/qetgraphicsitem/*.cpp) \
+           $$files($$PWD/sources/factory/*.cpp) \
+           $$files($$PWD/sources/properties/*.cpp) \
+           $$files($$PWD/sources/editor/ui/*.cpp) \
+           $$files($$PWD/sources/editor/esevent/*.cpp) \
+           $$files($$PWD/sources/editor/graphicspart/*.cpp) \
+           $$files($$PWD/sources/dvevent/*.cpp) \
+           $$files($$PWD/sources/undocommand/*.cpp) \
+           $$files($$PWD/sources/diagramevent/*.cpp) \
+           $$files($$PWD/sources/ElementsCollection/*.cpp) \
+           $$files($$PWD/sources/ElementsCollection/ui/*.cpp) \
+           $$files($$PWD/sources/autoNum/*.cpp) \
+           $$files($$PWD/sources/autoNum/ui/*.cpp) \
+           $$files($$PWD/sources/ui/configpage/*.cpp) \
+		   $$files($$PWD/sources/SearchAndReplace/*.cpp) \
+		   $$files($$PWD/sources/SearchAndReplace/ui/*.cpp) \
+		   $$files($$PWD/sources/NameList/*.cpp) \
+		   $$files($$PWD/sources/NameList/ui/*.cpp) \
+		   $$files($$PWD/sources/utils/*.cpp)
+    
+# Liste des fichiers qui seront incorpores au binaire en tant que ressources Qt
+RESOURCES += $$PWD/qelectrotech.qrc
+
+# Modules Qt utilises par l'application
+QT += xml svg network sql widgets printsupport concurrent KWidgetsAddons KCoreAddons
+
+# UI DESIGNER FILES AND GENERATION SOURCES FILES
+FORMS += $$files($$PWD/sources/richtext/*.ui) \
+         $$files($$PWD/sources/ui/*.ui) \
+         $$files($$PWD/sources/editor/ui/*.ui) \
+         $$files($$PWD/sources/ElementsCollection/ui/*.ui) \
+         $$files($$PWD/sources/autoNum/ui/*.ui) \
+         $$files($$PWD/sources/ui/configpage/*.ui) \
+		 $$files($$PWD/sources/SearchAndReplace/ui/*.ui) \
+         $$files($$PWD/sources/NameList/ui/*.ui)
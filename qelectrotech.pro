@@ -61,117 +61,25 @@ DEFINES += QET_ALLOW_OVERRIDE_CTBTD_OPTION
 # Commenter la ligne ci-dessous pour desactiver l'option --config-dir
 DEFINES += QET_ALLOW_OVERRIDE_CD_OPTION
 
+# Comment the line below to disable the tracing of the hot paths (--trace option)
+DEFINES += QET_ENABLE_TRACING
+
 # warn on *any* usage of deprecated APIs
 #DEFINES += QT_DEPRECATED_WARNINGS
 
 
 ######################################################################
 
-include(sources/PropertiesEditor/PropertiesEditor.pri)
-include(sources/QetGraphicsItemModeler/QetGraphicsItemModeler.pri)
-include(sources/QPropertyUndoCommand/QPropertyUndoCommand.pri)
-include(SingleApplication/singleapplication.pri)
-DEFINES += QAPPLICATION_CLASS=QApplication
+include(qelectrotech.pri)
 
 TEMPLATE = app
 DEPENDPATH += .
-INCLUDEPATH += sources \
-               sources/titleblock \
-               sources/ui sources/qetgraphicsitem \
-               sources/richtext \
-               sources/factory \
-               sources/properties \
-               sources/dvevent \
-               sources/editor \
-               sources/editor/esevent \
-               sources/editor/graphicspart \
-			   sources/editor/ui \
-               sources/undocommand \
-               sources/diagramevent \
-               sources/ElementsCollection \
-               sources/ElementsCollection/ui \
-               sources/autoNum \
-               sources/autoNum/ui \
-               sources/ui/configpage \
-			   sources/SearchAndReplace \
-			   sources/SearchAndReplace/ui \
-			   sources/NameList \
-			   sources/NameList/ui \
-			   sources/utils
-
-
-# Fichiers sources
-HEADERS += $$files(sources/*.h) $$files(sources/ui/*.h) \
-           $$files(sources/editor/*.h) \
-           $$files(sources/titleblock/*.h) \
-           $$files(sources/richtext/*.h) \
-           $$files(sources/qetgraphicsitem/*.h) \
-           $$files(sources/factory/*.h) \
-           $$files(sources/properties/*.h) \
-           $$files(sources/editor/ui/*.h) \
-           $$files(sources/editor/esevent/*.h) \
-           $$files(sources/editor/graphicspart/*.h) \
-           $$files(sources/dvevent/*.h) \
-           $$files(sources/undocommand/*.h) \
-           $$files(sources/diagramevent/*.h) \
-           $$files(sources/ElementsCollection/*.h) \
-           $$files(sources/ElementsCollection/ui/*.h) \
-           $$files(sources/autoNum/*.h) \
-           $$files(sources/autoNum/ui/*.h) \
-           $$files(sources/ui/configpage/*.h) \
-           $$files(sources/SearchAndReplace/*.h) \
-		   $$files(sources/SearchAndReplace/ui/*.h) \
-		   $$files(sources/NameList/*.h) \
-		   $$files(sources/NameList/ui/*.h) \
-		   $$files(sources/utils/*.h)
-
-SOURCES += $$files(sources/*.cpp) \
-           $$files(sources/editor/*.cpp) \
-           $$files(sources/titleblock/*.cpp) \
-           $$files(sources/richtext/*.cpp) \
-           $$files(sources/ui/*.cpp) \
-           $$files(sources/qetgraphicsitem/*.cpp) \
-           $$files(sources/factory/*.cpp) \
-           $$files(sources/properties/*.cpp) \
-           $$files(sources/editor/ui/*.cpp) \
-           $$files(sources/editor/esevent/*.cpp) \
-           $$files(sources/editor/graphicspart/*.cpp) \
-           $$files(sources/dvevent/*.cpp) \
-           $$files(sources/undocommand/*.cpp) \
-           $$files(sources/diagramevent/*.cpp) \
-           $$files(sources/ElementsCollection/*.cpp) \
-           $$files(sources/ElementsCollection/ui/*.cpp) \
-           $$files(sources/autoNum/*.cpp) \
-           $$files(sources/autoNum/ui/*.cpp) \
-           $$files(sources/ui/configpage/*.cpp) \
-		   $$files(sources/SearchAndReplace/*.cpp) \
-		   $$files(sources/SearchAndReplace/ui/*.cpp) \
-		   $$files(sources/NameList/*.cpp) \
-		   $$files(sources/NameList/ui/*.cpp) \
-		   $$files(sources/utils/*.cpp)
-    
-# Liste des fichiers qui seront incorpores au binaire en tant que ressources Qt
-RESOURCES += qelectrotech.qrc
-
 # Liste des ressources Windows
 #RC_FILE = ico/windows_icon/qelectrotech.rc
 
 # Fichiers de traduction qui seront installes
 TRANSLATIONS += lang/qet_en.ts lang/qet_es.ts lang/qet_fr.ts lang/qet_ru.ts lang/qet_pt.ts lang/qet_cs.ts lang/qet_pl.ts lang/qet_de.ts lang/qet_ro.ts lang/qet_it.ts lang/qet_el.ts lang/qet_nl.ts lang/qet_be.ts
 
-# Modules Qt utilises par l'application
-QT += xml svg network sql widgets printsupport concurrent KWidgetsAddons KCoreAddons
-
-# UI DESIGNER FILES AND GENERATION SOURCES FILES
-FORMS += $$files(sources/richtext/*.ui) \
-         $$files(sources/ui/*.ui) \
-         $$files(sources/editor/ui/*.ui) \
-         $$files(sources/ElementsCollection/ui/*.ui) \
-         $$files(sources/autoNum/ui/*.ui) \
-         $$files(sources/ui/configpage/*.ui) \
-		 $$files(sources/SearchAndReplace/ui/*.ui) \
-         $$files(sources/NameList/ui/*.ui)
-
 UI_SOURCES_DIR = sources/ui/
 UI_HEADERS_DIR = sources/ui/
 
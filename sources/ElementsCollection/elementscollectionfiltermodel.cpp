@@ -0,0 +1,171 @@
+/*
+	Copyright 2006-2019 The QElectroTech Team
+	This file is part of QElectroTech.
+	
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+	
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "elementscollectionfiltermodel.h"
+#include "elementcollectionitem.h"
+#include "fileelementcollectionitem.h"
+#include "elementscollectioncache.h"
+
+#include <QStandardItemModel>
+
+/**
+ * @brief ElementsCollectionFilterModel::ElementsCollectionFilterModel
+ * @param parent
+ */
+ElementsCollectionFilterModel::ElementsCollectionFilterModel(QObject *parent) :
+	QSortFilterProxyModel(parent)
+{
+	setDynamicSortFilter(false);
+}
+
+/**
+ * @brief ElementsCollectionFilterModel::setFilter
+ * Display only the elements whose the search data match @text,
+ * used when there is no collections cache.
+ * @param text : searched text, see ElementsCollectionCache::searchTerms
+ * @param source_root : if valid, only the elements under this index of the source model are displayed
+ */
+void ElementsCollectionFilterModel::setFilter(const QString &text, const QModelIndex &source_root)
+{
+	m_filtering = true;
+	m_use_file_paths = false;
+	m_terms = ElementsCollectionCache::searchTerms(text);
+	m_file_paths.clear();
+	m_source_root = source_root;
+	invalidateFilter();
+}
+
+/**
+ * @brief ElementsCollectionFilterModel::setFilter
+ * Display only the elements of the file system collections at @file_paths
+ * and the elements of the projects whose the search data match @text
+ * @param text : searched text, see ElementsCollectionCache::searchTerms
+ * @param file_paths : collection paths of the matching elements of the file system collections
+ * @param source_root : if valid, only the elements under this index of the source model are displayed
+ */
+void ElementsCollectionFilterModel::setFilter(const QString &text, const QStringList &file_paths, const QModelIndex &source_root)
+{
+	m_filtering = true;
+	m_use_file_paths = true;
+	m_terms = ElementsCollectionCache::searchTerms(text);
+	m_file_paths = QSet<QString>::fromList(file_paths);
+	m_source_root = source_root;
+	invalidateFilter();
+}
+
+/**
+ * @brief ElementsCollectionFilterModel::clearFilter
+ * Display every items of the source model
+ */
+void ElementsCollectionFilterModel::clearFilter()
+{
+	if (!m_filtering) {
+		return;
+	}
+
+	m_filtering = false;
+	m_terms.clear();
+	m_file_paths.clear();
+	m_source_root = QModelIndex();
+	invalidateFilter();
+}
+
+/**
+ * @brief ElementsCollectionFilterModel::itemForIndex
+ * @param index : index of this model
+ * @return the item of the source model displayed at @index
+ */
+ElementCollectionItem *ElementsCollectionFilterModel::itemForIndex(const QModelIndex &index) const
+{
+	QStandardItemModel *model = qobject_cast<QStandardItemModel *>(sourceModel());
+	if (!model || !index.isValid()) {
+		return nullptr;
+	}
+
+	return static_cast<ElementCollectionItem *>(model->itemFromIndex(mapToSource(index)));
+}
+
+/**
+ * @brief ElementsCollectionFilterModel::filterAcceptsRow
+ * Reimplemented from QSortFilterProxyModel.
+ * An element is accepted if it match the filter, a directory
+ * if at least one of its childs is accepted.
+ * @param source_row
+ * @param source_parent
+ * @return
+ */
+bool ElementsCollectionFilterModel::filterAcceptsRow(int source_row, const QModelIndex &source_parent) const
+{
+	if (!m_filtering) {
+		return true;
+	}
+
+	QStandardItemModel *model = qobject_cast<QStandardItemModel *>(sourceModel());
+	if (!model) {
+		return true;
+	}
+
+	QModelIndex index = model->index(source_row, 0, source_parent);
+	ElementCollectionItem *eci = static_cast<ElementCollectionItem *>(model->itemFromIndex(index));
+	if (!eci) {
+		return false;
+	}
+
+	if (eci->isElement()) {
+		return itemMatch(eci) && isInRoot(index);
+	}
+
+	for (int i = 0 ; i < model->rowCount(index) ; ++i) {
+		if (filterAcceptsRow(i, index)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief ElementsCollectionFilterModel::itemMatch
+ * @param eci
+ * @return true if the element @eci match the filter
+ */
+bool ElementsCollectionFilterModel::itemMatch(ElementCollectionItem *eci) const
+{
+	if (m_use_file_paths && eci->type() == FileElementCollectionItem::Type) {
+		return m_file_paths.contains(eci->collectionPath());
+	}
+
+	return ElementsCollectionCache::matchSearchTerms(m_terms, eci->data(Qt::UserRole+1).toString());
+}
+
+/**
+ * @brief ElementsCollectionFilterModel::isInRoot
+ * @param source_index
+ * @return true if there isn't root or if @source_index is a child of the root
+ */
+bool ElementsCollectionFilterModel::isInRoot(const QModelIndex &source_index) const
+{
+	if (!m_source_root.isValid()) {
+		return true;
+	}
+
+	for (QModelIndex index = source_index.parent() ; index.isValid() ; index = index.parent()) {
+		if (m_source_root == index) {
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,65 @@
+/*
+	Copyright 2006-2019 The QElectroTech Team
+	This file is part of QElectroTech.
+	
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+	
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef ELEMENTSCOLLECTIONFILTERMODEL_H
+#define ELEMENTSCOLLECTIONFILTERMODEL_H
+
+#include <QSortFilterProxyModel>
+#include <QPersistentModelIndex>
+#include <QSet>
+
+class ElementCollectionItem;
+
+/**
+ * @brief The ElementsCollectionFilterModel class
+ * Proxy model between an ElementsCollectionModel and the view,
+ * used to display only the elements matching a search.
+ * The elements of the file system collections are matched with the paths
+ * found by the full-text search of the collections cache
+ * (see ElementsCollectionCache::searchElements), the elements of the projects
+ * with their search data (Qt::UserRole+1). A directory is displayed
+ * if at least one of its elements is displayed.
+ */
+class ElementsCollectionFilterModel : public QSortFilterProxyModel
+{
+	Q_OBJECT
+
+	public:
+		ElementsCollectionFilterModel(QObject *parent = nullptr);
+
+		void setFilter(const QString &text, const QModelIndex &source_root = QModelIndex());
+		void setFilter(const QString &text, const QStringList &file_paths, const QModelIndex &source_root = QModelIndex());
+		void clearFilter();
+		bool isFiltering() const {return m_filtering;}
+		ElementCollectionItem *itemForIndex(const QModelIndex &index) const;
+
+	protected:
+		bool filterAcceptsRow(int source_row, const QModelIndex &source_parent) const override;
+
+	private:
+		bool itemMatch(ElementCollectionItem *eci) const;
+		bool isInRoot(const QModelIndex &source_index) const;
+
+	private:
+		bool m_filtering = false,
+			 m_use_file_paths = false;
+		QList<QStringList> m_terms;
+		QSet<QString> m_file_paths;
+		QPersistentModelIndex m_source_root;
+};
+
+#endif // ELEMENTSCOLLECTIONFILTERMODEL_H
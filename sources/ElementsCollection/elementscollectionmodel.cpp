@@ -23,8 +23,11 @@
 #include "xmlelementcollection.h"
 #include "qetproject.h"
 #include "elementcollectionhandler.h"
+#include "elementscollectioncache.h"
 
 #include <QtConcurrent>
+#include <QDir>
+#include "qettrace.h"
 
 /**
  * @brief ElementsCollectionModel::ElementsCollectionModel
@@ -34,6 +37,15 @@
 ElementsCollectionModel::ElementsCollectionModel(QObject *parent) :
 	QStandardItemModel(parent)
 {
+		//The changes in the file system come by burst (copy of a directory,
+		//synchronization of a shared drive...), they are applied all together
+		//when the file system is quiet since a moment.
+	m_watcher_timer.setSingleShot(true);
+	m_watcher_timer.setInterval(500);
+	connect(&m_watcher_timer, &QTimer::timeout, this, &ElementsCollectionModel::applyFileSystemChanges);
+	connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &ElementsCollectionModel::fileSystemChanged);
+	connect(&m_watcher, &QFileSystemWatcher::fileChanged, [this](const QString &path) {
+		this->fileSystemChanged(QFileInfo(path).absolutePath());});
 }
 
 /**
@@ -225,8 +237,15 @@ bool ElementsCollectionModel::dropMimeData(const QMimeData *data, Qt::DropAction
  */
 void ElementsCollectionModel::loadCollections(bool common_collection, bool custom_collection, QList<QETProject *> projects)
 {
+	QET_TRACE("ElementsCollectionModel::loadCollections");
 	QList <ElementCollectionItem *> list;
 
+		//The elements of the file collections use the index of the cache,
+		//only the modified elements are parsed.
+	ElementsCollectionCache *cache = QETApp::collectionCache();
+	if (cache && (common_collection || custom_collection))
+		cache->loadIndex();
+
 	if (common_collection)
 		addCommonCollection(false);
 	if (custom_collection)
@@ -246,6 +265,9 @@ void ElementsCollectionModel::loadCollections(bool common_collection, bool custo
 	while (futur.isRunning()) {
 		emit loadingProgressValue(futur.progressValue());
 	}
+
+	if (cache && (common_collection || custom_collection))
+		cache->commitIndex(common_collection && custom_collection && !m_hide_element);
 }
 
 /**
@@ -280,6 +302,174 @@ void ElementsCollectionModel::addCustomCollection(bool set_data)
 		delete feci;
 }
 
+/**
+ * @brief ElementsCollectionModel::refreshFileCollections
+ * Apply to the file collections of this model the changes made in the file system
+ * since they were loaded : the items of the removed files and directories are removed,
+ * the new ones are added and the items of the modified elements are updated.
+ * Only the new and modified elements are parsed, see ElementsCollectionCache::elementMetadata
+ */
+void ElementsCollectionModel::refreshFileCollections()
+{
+	QET_TRACE("ElementsCollectionModel::refreshFileCollections");
+	ElementsCollectionCache *cache = QETApp::collectionCache();
+	if (cache)
+		cache->loadIndex();
+
+	bool common = false, custom = false;
+	for (int i = rowCount()-1 ; i >= 0 ; --i)
+	{
+		if (item(i)->type() != FileElementCollectionItem::Type)
+			continue;
+
+		FileElementCollectionItem *feci = static_cast<FileElementCollectionItem *>(item(i));
+			//The path of the collection was changed in the configuration
+		if (!feci->isCollectionRoot()) {
+			removeRow(i);
+			continue;
+		}
+
+		if (feci->isCommonCollection())
+			common = true;
+		else
+			custom = true;
+		feci->refresh(m_hide_element);
+	}
+
+	if (!common)
+		addCommonCollection();
+	if (!custom)
+		addCustomCollection();
+
+	if (cache)
+		cache->commitIndex(!m_hide_element);
+
+	updateWatchedPaths();
+}
+
+/**
+ * @brief ElementsCollectionModel::watchFileCollections
+ * Watch the directories of the file collections (and the elements of the custom collection),
+ * the changes made in the file system by others applications are applied to this model,
+ * only for the changed directories.
+ * Call this method after loading the file collections.
+ * @param watch : true to watch, false to stop watching
+ */
+void ElementsCollectionModel::watchFileCollections(bool watch)
+{
+	m_watch_file_collections = watch;
+	if (watch) {
+		updateWatchedPaths();
+		return;
+	}
+
+	m_watcher_timer.stop();
+	m_changed_dirs.clear();
+	m_watched_dirs.clear();
+	if (!m_watcher.directories().isEmpty())
+		m_watcher.removePaths(m_watcher.directories());
+	if (!m_watcher.files().isEmpty())
+		m_watcher.removePaths(m_watcher.files());
+}
+
+/**
+ * @brief ElementsCollectionModel::updateWatchedPaths
+ * Synchronize the paths watched by m_watcher with the file items of this model :
+ * every directories, and the elements of the custom collection, whose
+ * the definition can be modified in place without change in the directory.
+ */
+void ElementsCollectionModel::updateWatchedPaths()
+{
+	if (!m_watch_file_collections)
+		return;
+
+	QHash<QString, QPersistentModelIndex> dirs;
+	QSet<QString> files;
+	QList<QStandardItem *> items_list;
+	for (int i=0 ; i<rowCount() ; i++)
+		if (item(i)->type() == FileElementCollectionItem::Type)
+			items_list.append(item(i));
+
+	while (!items_list.isEmpty())
+	{
+		FileElementCollectionItem *feci = static_cast<FileElementCollectionItem *>(items_list.takeLast());
+		if (feci->isDir())
+		{
+			dirs.insert(feci->fileSystemPath(), QPersistentModelIndex(indexFromItem(feci)));
+			for (int i=0 ; i<feci->rowCount() ; i++)
+				items_list.append(feci->child(i));
+		}
+		else if (feci->isCustomCollection())
+			files.insert(feci->fileSystemPath());
+	}
+
+	QStringList to_remove, to_add;
+	QSet<QString> watched_dirs  = m_watcher.directories().toSet(),
+				  watched_files = m_watcher.files().toSet();
+	for (const QString &path : watched_dirs)
+		if (!dirs.contains(path))
+			to_remove << path;
+	for (const QString &path : watched_files)
+		if (!files.contains(path))
+			to_remove << path;
+	for (auto it = dirs.constBegin() ; it != dirs.constEnd() ; ++it)
+		if (!watched_dirs.contains(it.key()))
+			to_add << it.key();
+	for (const QString &path : files)
+		if (!watched_files.contains(path))
+			to_add << path;
+
+	if (!to_remove.isEmpty())
+		m_watcher.removePaths(to_remove);
+	if (!to_add.isEmpty())
+		m_watcher.addPaths(to_add);
+	m_watched_dirs = dirs;
+}
+
+/**
+ * @brief ElementsCollectionModel::fileSystemChanged
+ * Called by m_watcher, the content of the directory @dir_path changed.
+ * The changes are applied by applyFileSystemChanges() when no change happen during the interval of m_watcher_timer.
+ * @param dir_path
+ */
+void ElementsCollectionModel::fileSystemChanged(const QString &dir_path)
+{
+	m_changed_dirs.insert(dir_path);
+	m_watcher_timer.start();
+}
+
+/**
+ * @brief ElementsCollectionModel::applyFileSystemChanges
+ * Synchronize the items of the changed directories with the file system,
+ * without going through their sub-directories : only the items of the added,
+ * removed or modified files of these directories are updated.
+ * See FileElementCollectionItem::refresh
+ */
+void ElementsCollectionModel::applyFileSystemChanges()
+{
+	QET_TRACE("ElementsCollectionModel::applyFileSystemChanges");
+	QSet<QString> changed_dirs;
+	changed_dirs.swap(m_changed_dirs);
+
+	for (const QString &dir_path : changed_dirs)
+	{
+			//The index is invalid if the directory was removed with its parent,
+			//a removed directory is removed from the model by the refresh of its parent
+		QPersistentModelIndex index = m_watched_dirs.value(dir_path);
+		if (!index.isValid() || !QDir(dir_path).exists())
+			continue;
+
+		FileElementCollectionItem *feci = static_cast<FileElementCollectionItem *>(itemFromIndex(index));
+		if (feci)
+			feci->refresh(m_hide_element, false);
+	}
+
+	if (ElementsCollectionCache *cache = QETApp::collectionCache())
+		cache->commitIndex();
+
+	updateWatchedPaths();
+}
+
 /**
  * @brief ElementsCollectionModel::addLocation
  * Add the element or directory to this model.
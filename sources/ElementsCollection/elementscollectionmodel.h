@@ -19,6 +19,9 @@
 #define ELEMENTSCOLLECTIONMODEL2_H
 
 #include <QStandardItemModel>
+#include <QFileSystemWatcher>
+#include <QTimer>
+#include <QSet>
 #include "elementslocation.h"
 
 class XmlProjectElementCollectionItem;
@@ -45,6 +48,8 @@ class ElementsCollectionModel : public QStandardItemModel
 
 		void addCommonCollection(bool set_data = true);
 		void addCustomCollection(bool set_data = true);
+		void refreshFileCollections();
+		void watchFileCollections(bool watch = true);
 		void addLocation(const ElementsLocation& location);
 
 		void addProject(QETProject *project, bool set_data = true);
@@ -67,11 +72,19 @@ class ElementsCollectionModel : public QStandardItemModel
 		void elementIntegratedToCollection (const QString& path);
 		void itemRemovedFromCollection (const QString& path);
 		void updateItem (const QString& path);
+		void updateWatchedPaths();
+		void fileSystemChanged(const QString &dir_path);
+		void applyFileSystemChanges();
 
 	private:
 		QList <QETProject *> m_project_list;
 		QHash <QETProject *, XmlProjectElementCollectionItem *> m_project_hash;
 		bool m_hide_element = false;
+		bool m_watch_file_collections = false;
+		QFileSystemWatcher m_watcher;
+		QTimer m_watcher_timer;
+		QSet<QString> m_changed_dirs;
+		QHash<QString, QPersistentModelIndex> m_watched_dirs;
 };
 
 #endif // ELEMENTSCOLLECTIONMODEL2_H
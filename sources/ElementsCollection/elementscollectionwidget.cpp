@@ -17,6 +17,8 @@
 */
 #include "elementscollectionwidget.h"
 #include "elementscollectionmodel.h"
+#include "elementscollectionfiltermodel.h"
+#include "elementscollectioncache.h"
 #include "elementcollectionitem.h"
 #include "qeticons.h"
 #include "fileelementcollectionitem.h"
@@ -74,8 +76,8 @@ void ElementsCollectionWidget::expandFirstItems()
 	if (!m_model)
 		return;
 
-	for (int i=0; i < m_model->rowCount() ; i++)
-		showAndExpandItem(m_model->index(i, 0), false);
+	for (int i=0; i < m_filter_model->rowCount() ; i++)
+		showAndExpandItem(m_filter_model->index(i, 0), false);
 }
 
 /**
@@ -125,7 +127,7 @@ void ElementsCollectionWidget::setCurrentLocation(const ElementsLocation &locati
 	if (!location.exist())
 		return;
 	
-	m_tree_view->setCurrentIndex(m_model->indexFromLocation(location));
+	m_tree_view->setCurrentIndex(m_filter_model->mapFromSource(m_model->indexFromLocation(location)));
 }
 
 void ElementsCollectionWidget::leaveEvent(QEvent *event)
@@ -178,6 +180,9 @@ void ElementsCollectionWidget::setUpWidget()
 	m_tree_view->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
 	m_main_vlayout->addWidget(m_tree_view);
 
+		//The view display the model through a proxy, used to filter the items while searching
+	m_filter_model = new ElementsCollectionFilterModel(this);
+
 		//Setup the progress bar
 	m_progress_bar = new QProgressBar(this);
 	m_progress_bar->setFormat(QObject::tr("chargement %p% (%v sur %m)"));
@@ -349,7 +354,8 @@ void ElementsCollectionWidget::deleteElement()
 		QFile file(loc.fileSystemPath());
 		if (file.remove())
 		{
-			m_model->removeRows(m_index_at_context_menu.row(), 1, m_index_at_context_menu.parent());
+			QModelIndex index = m_filter_model->mapToSource(m_index_at_context_menu);
+			m_model->removeRows(index.row(), 1, index.parent());
 		}
 		else
 		{
@@ -383,7 +389,8 @@ void ElementsCollectionWidget::deleteDirectory()
 		QDir dir (loc.fileSystemPath());
 		if (dir.removeRecursively())
 		{
-			m_model->removeRows(m_index_at_context_menu.row(), 1, m_index_at_context_menu.parent());
+			QModelIndex index = m_filter_model->mapToSource(m_index_at_context_menu);
+			m_model->removeRows(index.row(), 1, index.parent());
 		}
 		else
 		{
@@ -468,19 +475,19 @@ void ElementsCollectionWidget::showThisDir()
 		//Disable the yellow background of the previous index
 	if (m_showed_index.isValid())
 	{
-		ElementCollectionItem *eci = elementCollectionItemForIndex(m_showed_index);
-		if (eci)
-			eci->setBackground(QBrush());
+		QStandardItem *item = m_model->itemFromIndex(m_showed_index);
+		if (item)
+			item->setBackground(QBrush());
 	}
 
-	m_showed_index = m_index_at_context_menu;
+	m_showed_index = m_filter_model->mapToSource(m_index_at_context_menu);
 	if (m_showed_index.isValid())
 	{
 		hideCollection(true);
-		showAndExpandItem(m_showed_index, true, true);
-		ElementCollectionItem *eci = elementCollectionItemForIndex(m_showed_index);
-		if (eci)
-            eci->setBackground(QBrush(QColor(255, 204, 0, 255)));
+		showAndExpandItem(m_filter_model->mapFromSource(m_showed_index), true, true);
+		QStandardItem *item = m_model->itemFromIndex(m_showed_index);
+		if (item)
+            item->setBackground(QBrush(QColor(255, 204, 0, 255)));
 		search();
 	}
 	else
@@ -496,9 +503,9 @@ void ElementsCollectionWidget::resetShowThisDir()
 {
 	if (m_showed_index.isValid())
 	{
-		ElementCollectionItem *eci = elementCollectionItemForIndex(m_showed_index);
-		if (eci)
-			eci->setBackground(QBrush());
+		QStandardItem *item = m_model->itemFromIndex(m_showed_index);
+		if (item)
+			item->setBackground(QBrush());
 	}
 
 	m_showed_index = QModelIndex();
@@ -529,18 +536,28 @@ void ElementsCollectionWidget::dirProperties()
 
 /**
  * @brief ElementsCollectionWidget::reload, the displayed collections.
+ * The first call build the model, the next calls only apply to the model
+ * the changes made in the file collections (the project collections are
+ * already kept up to date by the model).
  */
 void ElementsCollectionWidget::reload()
 {
+	if (m_model)
+	{
+		m_index_at_context_menu = QModelIndex();
+		m_model->refreshFileCollections();
+		m_model->highlightUnusedElement();
+		if (!m_search_field->text().isEmpty())
+			search();
+		return;
+	}
+
 	m_progress_bar->show();
 	ElementsCollectionModel *new_model = new ElementsCollectionModel(m_tree_view);
 
 	QList <QETProject *> project_list;
 	project_list.append(m_waiting_project);
 	m_waiting_project.clear();
-	if (m_model)
-		project_list.append(m_model->project());
-
 
 	connect(new_model, &ElementsCollectionModel::loadingMaxValue, m_progress_bar, &QProgressBar::setMaximum);
 	connect(new_model, &ElementsCollectionModel::loadingProgressValue, m_progress_bar, &QProgressBar::setValue);
@@ -551,10 +568,13 @@ void ElementsCollectionWidget::reload()
 	disconnect(new_model, &ElementsCollectionModel::loadingProgressValue, m_progress_bar, &QProgressBar::setValue);
 
 	new_model->highlightUnusedElement();
-	m_tree_view->setModel(new_model);
+		//The changes made in the file collections by others applications
+		//(or others computers for a shared collection) are applied to the model
+	new_model->watchFileCollections();
+	m_filter_model->setSourceModel(new_model);
+	m_tree_view->setModel(m_filter_model);
 	m_index_at_context_menu = QModelIndex();
 	m_showed_index = QModelIndex();
-	if (m_model) delete m_model;
 	m_model = new_model;
 	expandFirstItems();
 	m_progress_bar->hide();
@@ -589,27 +609,34 @@ void ElementsCollectionWidget::locationWasSaved(const ElementsLocation& location
 
 /**
  * @brief ElementsCollectionWidget::search
- * Search every item (directory or element) that match the text of m_search_field
- * and display it, other item who does not match @text is hidden
+ * Search every element that match the text of m_search_field and display it,
+ * the others items are filtered by m_filter_model.
+ * The elements of the file collections are searched in the full-text index
+ * of the collections cache, the best match is selected.
  */
 void ElementsCollectionWidget::search()
 {
+	if (!m_model)
+		return;
+
 	QString text = m_search_field->text();
 		//Reset the search
 	if (text.isEmpty())
 	{
-		QModelIndex current_index = m_tree_view->currentIndex();
+		QModelIndex current_index = m_filter_model->mapToSource(m_tree_view->currentIndex());
+		m_filter_model->clearFilter();
 		m_tree_view->reset();
 
 		if (m_showed_index.isValid())
 		{
 			hideCollection(true);
-			showAndExpandItem(m_showed_index, true, true);
+			showAndExpandItem(m_filter_model->mapFromSource(m_showed_index), true, true);
 		}
 		else
 			expandFirstItems();
 
 			//Expand the tree and scroll to the last selected index
+		current_index = m_filter_model->mapFromSource(current_index);
 		if (current_index.isValid())
 		{
 			showAndExpandItem(current_index);
@@ -619,16 +646,30 @@ void ElementsCollectionWidget::search()
 		return;
 	}
 
-	hideCollection(true);
-	QStringList text_list = text.split("+", QString::SkipEmptyParts);
-	QModelIndexList match_index;
-	foreach (QString txt, text_list) {
-		match_index << m_model->match(m_showed_index.isValid() ? m_model->index(0,0,m_showed_index) : m_model->index(0,0),
-									  Qt::UserRole+1, QVariant(txt), -1, Qt::MatchContains | Qt::MatchRecursive);
+	QStringList paths;
+	if (ElementsCollectionCache *cache = QETApp::collectionCache())
+	{
+		paths = cache->searchElements(text);
+		m_filter_model->setFilter(text, paths, m_showed_index);
 	}
+	else
+		m_filter_model->setFilter(text, m_showed_index);
+
+		//The filter do the job, no need to hide rows
+	m_tree_view->reset();
+	m_tree_view->expandAll();
 
-	foreach(QModelIndex index, match_index)
-		showAndExpandItem(index);
+		//Select the best match displayed
+	for (const QString &path : paths)
+	{
+		QModelIndex index = m_filter_model->mapFromSource(m_model->indexFromLocation(ElementsLocation(path)));
+		if (index.isValid())
+		{
+			m_tree_view->setCurrentIndex(index);
+			m_tree_view->scrollTo(index);
+			break;
+		}
+	}
 }
 
 /**
@@ -638,8 +679,8 @@ void ElementsCollectionWidget::search()
  */
 void ElementsCollectionWidget::hideCollection(bool hide)
 {
-	for (int i=0 ; i <m_model->rowCount() ; i++)
-		hideItem(hide, m_model->index(i, 0), true);
+	for (int i=0 ; i <m_filter_model->rowCount() ; i++)
+		hideItem(hide, m_filter_model->index(i, 0), true);
 }
 
 /**
@@ -654,8 +695,8 @@ void ElementsCollectionWidget::hideItem(bool hide, const QModelIndex &index, boo
 	m_tree_view->setRowHidden(index.row(), index.parent(), hide);
 
 	if (recursive)
-		for (int i=0 ; i<m_model->rowCount(index) ; i++)
-			hideItem(hide, m_model->index(i, 0, index), recursive);
+		for (int i=0 ; i<m_filter_model->rowCount(index) ; i++)
+			hideItem(hide, m_filter_model->index(i, 0, index), recursive);
 }
 
 /**
@@ -681,11 +722,12 @@ void ElementsCollectionWidget::showAndExpandItem(const QModelIndex &index, bool
 /**
  * @brief ElementsCollectionWidget::elementCollectionItemForIndex
  * @param index
- * @return The internal pointer of index casted to ElementCollectionItem;
+ * @param index : index of the tree view
+ * @return The item of m_model displayed at index, casted to ElementCollectionItem;
  */
 ElementCollectionItem *ElementsCollectionWidget::elementCollectionItemForIndex(const QModelIndex &index) {
 	if (!index.isValid())
 		return nullptr;
 
-	return static_cast<ElementCollectionItem*>(m_model->itemFromIndex(index));
+	return m_filter_model->itemForIndex(index);
 }
@@ -25,6 +25,7 @@
 #include <QTimer>
 
 class ElementsCollectionModel;
+class ElementsCollectionFilterModel;
 class QVBoxLayout;
 class QMenu;
 class QLineEdit;
@@ -86,13 +87,14 @@ class ElementsCollectionWidget : public QWidget
 
 	private:
 		ElementsCollectionModel *m_model;
+		ElementsCollectionFilterModel *m_filter_model;
 		QLineEdit *m_search_field;
 		QTimer m_search_timer;
 		ElementsTreeView *m_tree_view;
 		QVBoxLayout *m_main_vlayout;
 		QMenu *m_context_menu;
 		QModelIndex m_index_at_context_menu;
-		QModelIndex m_showed_index;
+		QPersistentModelIndex m_showed_index; ///< Index of m_model
 		QProgressBar *m_progress_bar;
 
 		QAction *m_open_dir,
@@ -21,6 +21,7 @@
 #include "qetproject.h"
 #include "elementscollectioncache.h"
 #include "elementpicturefactory.h"
+#include "elementdefinitionloader.h"
 #include "element.h"
 #include "qetxml.h"
 #include <QPicture>
@@ -531,6 +532,11 @@ QDomElement ElementsLocation::xml() const
 {
 	if (!m_project)
 	{
+			//The definition is perhaps already parsed by the loader
+		QDomDocument cached_docu = ElementDefinitionLoader::cachedDocument(m_file_system_path);
+		if (!cached_docu.isNull())
+			return cached_docu.documentElement();
+
 		QFile file (m_file_system_path);
 		QDomDocument docu;
 		if (docu.setContent(&file))
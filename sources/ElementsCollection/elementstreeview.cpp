@@ -18,12 +18,15 @@
 #include "elementstreeview.h"
 #include "elementcollectionitem.h"
 #include "elementslocation.h"
-#include "elementfactory.h"
+#include "elementpicturefactory.h"
+#include "elementdefinitionloader.h"
+#include "elementscollectioncache.h"
+#include "qetapp.h"
 #include "qeticons.h"
-#include "element.h"
 
 #include <QDrag>
 #include <QStandardItemModel>
+#include <QAbstractProxyModel>
 
 static int MAX_DND_PIXMAP_WIDTH = 500;
 static int MAX_DND_PIXMAP_HEIGHT = 375;
@@ -34,7 +37,18 @@ static int MAX_DND_PIXMAP_HEIGHT = 375;
  */
 ElementsTreeView::ElementsTreeView(QWidget *parent) :
 	QTreeView(parent)
-{}
+{
+		//The hovered element is perhaps about to be dragged to a folio,
+		//we start the loading of his definition
+	setMouseTracking(true);
+	connect(this, &QAbstractItemView::entered, this, [this](const QModelIndex &index)
+	{
+		ElementsLocation location = locationFromIndex(index);
+		if (location.isElement()) {
+			ElementDefinitionLoader::instance()->prefetch(location);
+		}
+	});
+}
 
 /**
  * @brief ElementsTreeView::startDrag
@@ -43,23 +57,39 @@ ElementsTreeView::ElementsTreeView(QWidget *parent) :
  */
 void ElementsTreeView::startDrag(Qt::DropActions supportedActions)
 {
-	QModelIndex index = currentIndex();
+	ElementsLocation loc = locationFromIndex(currentIndex());
+	if (loc.exist()) {
+		startElementDrag(loc);
+		return;
+	}
+	QTreeView::startDrag(supportedActions);
+}
 
+/**
+ * @brief ElementsTreeView::locationFromIndex
+ * @param index : index of the model of this view
+ * @return the location of the item at @index, or a null location
+ */
+ElementsLocation ElementsTreeView::locationFromIndex(const QModelIndex &index) const
+{
 	if (!index.isValid()) {
-		QTreeView::startDrag(supportedActions);
-		return;
+		return ElementsLocation();
+	}
+
+		//The model is perhaps displayed through a proxy model
+	QModelIndex source_index = index;
+	QAbstractItemModel *source_model = model();
+	if (QAbstractProxyModel *proxy = qobject_cast<QAbstractProxyModel *>(source_model)) {
+		source_index = proxy->mapToSource(index);
+		source_model = proxy->sourceModel();
 	}
 
-	if (QStandardItemModel *qsim = static_cast<QStandardItemModel *>(model())) {
-		if (ElementCollectionItem *eci = static_cast<ElementCollectionItem *>(qsim->itemFromIndex(index))) {
-			ElementsLocation loc (eci->collectionPath());
-			if (loc.exist()) {
-				startElementDrag(loc);
-				return;
-			}
+	if (QStandardItemModel *qsim = qobject_cast<QStandardItemModel *>(source_model)) {
+		if (ElementCollectionItem *eci = static_cast<ElementCollectionItem *>(qsim->itemFromIndex(source_index))) {
+			return ElementsLocation(eci->collectionPath());
 		}
 	}
-	QTreeView::startDrag(supportedActions);
+	return ElementsLocation();
 }
 
 /**
@@ -87,17 +117,30 @@ void ElementsTreeView::startElementDrag(const ElementsLocation &location)
 	{
 		mime_data->setData("application/x-qet-element-uri", location_str.toLatin1());
 
-			//Build the element for set the pixmap of the QDrag
-		int elmt_creation_state;
-		Element *temp_elmt = ElementFactory::Instance()->createElement(location, nullptr, &elmt_creation_state);
-		if (elmt_creation_state)
+			//Set the pixmap of the QDrag from the pixmap of the elements panel
+			//and the hotspot from the index of the collections cache,
+			//so the definition of the element isn't parsed again.
+			//The definition of an element of a project is already in memory.
+		QPixmap elmt_pixmap;
+		QPoint elmt_hotspot;
+		ElementsCollectionCache *cache = QETApp::collectionCache();
+		ElementsLocation cache_location(location);
+		if (location.isFileSystem() && cache && cache->fetchElement(cache_location))
+		{
+			elmt_pixmap = cache->pixmap();
+			elmt_hotspot = cache->elementMetadata(location).hotspot;
+		}
+		else
 		{
-			delete temp_elmt;
+			elmt_pixmap = ElementPictureFactory::instance()->pixmap(location);
+			QDomElement dom = location.xml();
+			elmt_hotspot = QPoint(dom.attribute("hotspot_x").toInt(), dom.attribute("hotspot_y").toInt());
+		}
+		if (elmt_pixmap.isNull()) {
 			return;
 		}
-
-		QPixmap elmt_pixmap(temp_elmt->pixmap());
-		QPoint elmt_hotspot(temp_elmt->hotspot());
+		elmt_hotspot = QPoint(qMin(elmt_hotspot.x(), elmt_pixmap.width()),
+							  qMin(elmt_hotspot.y(), elmt_pixmap.height()));
 
 			//Adjust the size of the pixmap if he is too big
 		QPoint elmt_pixmap_size(elmt_pixmap.width(), elmt_pixmap.height());
@@ -112,9 +155,6 @@ void ElementsTreeView::startElementDrag(const ElementsLocation &location)
 
 		drag->setPixmap(elmt_pixmap);
 		drag->setHotSpot(elmt_hotspot);
-
-
-		delete temp_elmt;
 	}
 
 	drag->setMimeData(mime_data);
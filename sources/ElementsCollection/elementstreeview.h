@@ -19,14 +19,15 @@
 #define ELEMENTSTREEVIEW_H
 
 #include <QTreeView>
-
-class ElementsLocation;
+#include "elementslocation.h"
 
 /**
  * @brief The ElementsTreeView class
  * This class just reimplement startDrag from QTreeView, for set a custom pixmap.
  * This class must be used when the tree view have an ElementsCollectionModel as model.
  * The pixmap used is the pixmap of the dragged element or a directory pixmap.
+ * The loading of the definition of the hovered element is started in advance,
+ * see ElementDefinitionLoader.
  */
 class ElementsTreeView : public QTreeView
 {
@@ -36,6 +37,9 @@ class ElementsTreeView : public QTreeView
 	protected:
 		void startDrag(Qt::DropActions supportedActions) override;
 		virtual void startElementDrag(const ElementsLocation &location);
+
+	private:
+		ElementsLocation locationFromIndex(const QModelIndex &index) const;
 };
 
 #endif // ELEMENTSTREEVIEW_H
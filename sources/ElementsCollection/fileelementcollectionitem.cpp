@@ -20,6 +20,9 @@
 #include "elementslocation.h"
 #include "qetapp.h"
 #include "qeticons.h"
+#include "elementscollectioncache.h"
+#include "elementpicturefactory.h"
+#include "elementdefinitiondata.h"
 
 #include <QDir>
 
@@ -141,7 +144,10 @@ QString FileElementCollectionItem::localName()
 	}
 	else if (isElement()) {
 		ElementsLocation loc(collectionPath());
-		setText(loc.name());
+		if (ElementsCollectionCache *cache = QETApp::collectionCache())
+			setText(cache->elementMetadata(loc).names.name(loc.fileName()));
+		else
+			setText(loc.name());
 	}
 
 	return text();
@@ -246,10 +252,15 @@ void FileElementCollectionItem::setUpData()
 			//Set the local name and all informations of the element
 			//in the data Qt::UserRole+1, these data will be use for search.
 		ElementsLocation location(collectionPath());
-		DiagramContext context = location.elementInformations();
 		QStringList search_list;
-		for (QString key : context.keys()) {
-			search_list.append(context.value(key).toString());
+		if (ElementsCollectionCache *cache = QETApp::collectionCache()) {
+			search_list = cache->elementMetadata(location).informations.values();
+		}
+		else {
+			DiagramContext context = location.elementInformations();
+			for (QString key : context.keys()) {
+				search_list.append(context.value(key).toString());
+			}
 		}
 		search_list.append(localName());
 		setData(search_list.join(" "));
@@ -284,6 +295,72 @@ void FileElementCollectionItem::setUpIcon()
 	}
 }
 
+/**
+ * @brief FileElementCollectionItem::refresh
+ * Synchronise the childs of this directory item with the file system :
+ * the items of the removed files and directories are removed, the new ones
+ * are added and the items of the modified elements are updated.
+ * The pictures of the modified elements are removed from the ElementPictureFactory.
+ * @param hide_element : if true, the elements are not listed
+ * @param recursive : if false, the sub-directories are not refreshed
+ */
+void FileElementCollectionItem::refresh(bool hide_element, bool recursive)
+{
+	if (!isDir())
+		return;
+
+	QDir dir (fileSystemPath());
+	QStringList entries = dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
+	if (!hide_element) {
+		dir.setNameFilters(QStringList() << "*.elmt");
+		entries.append(dir.entryList(QDir::Files | QDir::NoDotAndDotDot, QDir::Name));
+	}
+
+	QSet<QString> on_disk = entries.toSet();
+	QSet<QString> in_model;
+	for (int i = rowCount()-1 ; i >= 0 ; --i)
+	{
+		FileElementCollectionItem *feci = static_cast<FileElementCollectionItem *>(child(i));
+		if (!on_disk.contains(feci->m_path)) {
+			removeRow(i);
+			continue;
+		}
+
+		in_model.insert(feci->m_path);
+		if (feci->isDir()) {
+			if (recursive)
+				feci->refresh(hide_element);
+		}
+		else
+		{
+				//Only the modified elements are parsed again
+			bool changed = false;
+			ElementsCollectionCache::ElementMetadata previous;
+			if (ElementsCollectionCache *cache = QETApp::collectionCache())
+			{
+				const ElementsLocation location(feci->collectionPath());
+				ElementsCollectionCache::ElementMetadata metadata = cache->elementMetadata(location, &changed, &previous);
+				if (changed)
+				{
+					ElementPictureFactory::instance()->invalidate(previous.uuid);
+					ElementPictureFactory::instance()->invalidate(metadata.uuid);
+						//The definition can be modified without changing its uuid
+					ElementDefinitionData::invalidate(location);
+				}
+			}
+			if (changed) {
+				feci->clearData();
+				feci->setUpData();
+			}
+		}
+	}
+
+	for (const QString &entry : entries) {
+		if (!in_model.contains(entry))
+			addChildAtPath(entry);
+	}
+}
+
 /**
  * @brief FileElementCollectionItem::setPathName
  * Set the name of this item in the file system path.
@@ -49,6 +49,7 @@ class FileElementCollectionItem : public ElementCollectionItem
 
 		void setUpData() override;
 		void setUpIcon() override;
+		void refresh(bool hide_element = false, bool recursive = true);
 
 		void hire();
 
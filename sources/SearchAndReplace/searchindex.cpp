@@ -0,0 +1,269 @@
+/*
+	Copyright 2006-2019 The QElectroTech Team
+	This file is part of QElectroTech.
+
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "searchindex.h"
+
+#include <QRegularExpression>
+#include <algorithm>
+
+namespace {
+	/**
+	 * @brief entireWordRegExp
+	 * @return the regular expression used to search @str as an entire word
+	 */
+	QRegularExpression entireWordRegExp(const QString &str, Qt::CaseSensitivity cs)
+	{
+		QRegularExpression rx("\\b" + str + "\\b");
+		if (cs == Qt::CaseInsensitive) {
+			rx.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+		}
+		return rx;
+	}
+
+	/**
+	 * @brief termsMatch
+	 * @return true if one of @terms contain @str, or match @rx if @rx is not nullptr
+	 */
+	bool termsMatch(const QStringList &terms, const QString &str, Qt::CaseSensitivity cs, const QRegularExpression *rx)
+	{
+		for (const QString &term : terms)
+		{
+			if (rx) {
+				if (rx->match(term).hasMatch()) {
+					return true;
+				}
+			}
+			else if (term.contains(str, cs)) {
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+/**
+ * @brief SearchIndex::insert
+ * Index @object with the terms @terms.
+ * If @object is already indexed, his terms are replaced.
+ * @param object
+ * @param terms
+ */
+void SearchIndex::insert(QObject *object, const QStringList &terms)
+{
+	QSet<quint64> new_trigrams;
+	for (const QString &term : terms) {
+		new_trigrams.unite(trigrams(term));
+	}
+
+	QSet<quint64> old_trigrams = m_object_trigrams.value(object);
+	for (quint64 trigram : old_trigrams)
+	{
+		if (new_trigrams.contains(trigram)) {
+			continue;
+		}
+
+		auto it = m_postings.find(trigram);
+		if (it != m_postings.end())
+		{
+			it->remove(object);
+			if (it->isEmpty()) {
+				m_postings.erase(it);
+			}
+		}
+	}
+	for (quint64 trigram : new_trigrams) {
+		if (!old_trigrams.contains(trigram)) {
+			m_postings[trigram].insert(object);
+		}
+	}
+
+	m_terms.insert(object, terms);
+	m_object_trigrams.insert(object, new_trigrams);
+}
+
+/**
+ * @brief SearchIndex::remove
+ * Remove @object from the index.
+ * @object is only used as key, so this method can be called when @object is being destroyed.
+ * @param object
+ */
+void SearchIndex::remove(QObject *object)
+{
+	for (quint64 trigram : m_object_trigrams.take(object))
+	{
+		auto it = m_postings.find(trigram);
+		if (it != m_postings.end())
+		{
+			it->remove(object);
+			if (it->isEmpty()) {
+				m_postings.erase(it);
+			}
+		}
+	}
+	m_terms.remove(object);
+}
+
+/**
+ * @brief SearchIndex::clear
+ * Remove every objects of the index
+ */
+void SearchIndex::clear()
+{
+	m_terms.clear();
+	m_object_trigrams.clear();
+	m_postings.clear();
+}
+
+/**
+ * @brief SearchIndex::contains
+ * @param object
+ * @return true if @object is indexed
+ */
+bool SearchIndex::contains(QObject *object) const {
+	return m_terms.contains(object);
+}
+
+/**
+ * @brief SearchIndex::count
+ * @return the number of indexed objects
+ */
+int SearchIndex::count() const {
+	return m_terms.size();
+}
+
+/**
+ * @brief SearchIndex::search
+ * @param str : the searched string
+ * @param mode : search a string contained in the terms or an entire word.
+ * @param cs : case sensitivity
+ * @return the objects which have at least one term matching @str
+ */
+QSet<QObject *> SearchIndex::search(const QString &str, SearchIndex::Mode mode, Qt::CaseSensitivity cs) const
+{
+	QSet<QObject *> result;
+	if (str.isEmpty()) {
+		return result;
+	}
+
+		//Build the regular expression once, instead of once per term.
+	QRegularExpression rx;
+	if (mode == EntireWord)
+	{
+		rx = entireWordRegExp(str, cs);
+		if (!rx.isValid()) {
+			return result;
+		}
+	}
+
+	for (QObject *object : candidates(str, mode))
+	{
+		if (termsMatch(m_terms.value(object), str, cs, mode == EntireWord ? &rx : nullptr)) {
+			result.insert(object);
+		}
+	}
+
+	return result;
+}
+
+/**
+ * @brief SearchIndex::match
+ * @param object
+ * @param str
+ * @param mode
+ * @param cs
+ * @return true if @object have at least one term matching @str
+ */
+bool SearchIndex::match(QObject *object, const QString &str, SearchIndex::Mode mode, Qt::CaseSensitivity cs) const
+{
+	if (str.isEmpty() || !m_terms.contains(object)) {
+		return false;
+	}
+
+	if (mode == EntireWord)
+	{
+		QRegularExpression rx = entireWordRegExp(str, cs);
+		return rx.isValid() && termsMatch(m_terms.value(object), str, cs, &rx);
+	}
+	return termsMatch(m_terms.value(object), str, cs, nullptr);
+}
+
+/**
+ * @brief SearchIndex::trigrams
+ * @param str
+ * @return the trigrams of @str, case folded. Each trigram is stored
+ * as the three utf-16 code units packed in an integer.
+ */
+QSet<quint64> SearchIndex::trigrams(const QString &str)
+{
+	QSet<quint64> set;
+	const QString folded = str.toCaseFolded();
+	for (int i = 0 ; i + 2 < folded.size() ; ++i)
+	{
+		set.insert((quint64(folded.at(i).unicode()) << 32) |
+				   (quint64(folded.at(i+1).unicode()) << 16) |
+					quint64(folded.at(i+2).unicode()));
+	}
+	return set;
+}
+
+/**
+ * @brief SearchIndex::candidates
+ * @param str
+ * @param mode
+ * @return the objects which can match @str : every objects indexed with all the trigrams of @str.
+ * If @str is too short or is used as a regular expression, we can't
+ * use the trigrams and every objects are returned.
+ */
+QSet<QObject *> SearchIndex::candidates(const QString &str, SearchIndex::Mode mode) const
+{
+	bool use_trigrams = str.size() >= 3;
+	if (use_trigrams && mode == EntireWord) {
+			//In entire word mode @str is a part of a regular expression,
+			//we can only filter if @str is a plain text
+		static const QString special_characters("\\^$.|?*+()[]{}");
+		for (const QChar &c : str) {
+			if (special_characters.contains(c)) {
+				use_trigrams = false;
+				break;
+			}
+		}
+	}
+
+	if (!use_trigrams) {
+		return QSet<QObject *>::fromList(m_terms.keys());
+	}
+
+	QList<const QSet<QObject *> *> postings;
+	for (quint64 trigram : trigrams(str))
+	{
+		auto it = m_postings.constFind(trigram);
+		if (it == m_postings.constEnd()) {
+			return QSet<QObject *>();
+		}
+		postings << &it.value();
+	}
+
+		//Intersect from the smallest set
+	std::sort(postings.begin(), postings.end(),
+			  [](const QSet<QObject *> *a, const QSet<QObject *> *b) {return a->size() < b->size();});
+
+	QSet<QObject *> result = *postings.first();
+	for (int i = 1 ; i < postings.size() && !result.isEmpty() ; ++i) {
+		result.intersect(*postings.at(i));
+	}
+	return result;
+}
@@ -0,0 +1,63 @@
+/*
+	Copyright 2006-2019 The QElectroTech Team
+	This file is part of QElectroTech.
+
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include <QHash>
+#include <QSet>
+#include <QStringList>
+
+class QObject;
+
+/**
+ * @brief The SearchIndex class
+ * Trigram index of the search terms of the objects of a project
+ * (folios, elements, conductors, independent texts), used by the search and replace widget.
+ * Each object is indexed with its own list of terms, and can be updated
+ * alone when one of its properties change, without rebuilding the whole index.
+ * A search use the trigrams of the searched string to retrieve the candidate objects,
+ * then only the candidates are checked against the string.
+ */
+class SearchIndex
+{
+	public:
+		enum Mode {
+			Contains,
+			EntireWord
+		};
+
+		void insert(QObject *object, const QStringList &terms);
+		void remove(QObject *object);
+		void clear();
+		bool contains(QObject *object) const;
+		int count() const;
+
+		QSet<QObject *> search(const QString &str, Mode mode, Qt::CaseSensitivity cs) const;
+		bool match(QObject *object, const QString &str, Mode mode, Qt::CaseSensitivity cs) const;
+
+	private:
+		static QSet<quint64> trigrams(const QString &str);
+		QSet<QObject *> candidates(const QString &str, Mode mode) const;
+
+	private:
+		QHash<QObject *, QStringList> m_terms;
+		QHash<QObject *, QSet<quint64>> m_object_trigrams;
+		QHash<quint64, QSet<QObject *>> m_postings;
+};
+
+#endif // SEARCHINDEX_H
@@ -33,6 +33,7 @@
 #include "elementtextitemgroup.h"
 
 #include <QSettings>
+#include <QTextDocument>
 
 /**
  * @brief SearchAndReplaceWidget::SearchAndReplaceWidget
@@ -95,6 +96,7 @@ bool SearchAndReplaceWidget::event(QEvent *event)
 void SearchAndReplaceWidget::clear()
 {
 	disconnect(ui->m_tree_widget, &QTreeWidget::itemChanged, this, &SearchAndReplaceWidget::itemChanged);
+	clearIndex();
 	
 	qDeleteAll(m_diagram_hash.keys());
 	m_diagram_hash.clear();
@@ -227,6 +229,7 @@ void SearchAndReplaceWidget::setHideAdvanced(bool hide) const
 void SearchAndReplaceWidget::fillItemsList()
 {
 	disconnect(ui->m_tree_widget, &QTreeWidget::itemChanged, this, &SearchAndReplaceWidget::itemChanged);
+	clearIndex();
 	
 	qDeleteAll(m_element_hash.keys());
 	m_element_hash.clear();
@@ -241,25 +244,22 @@ void SearchAndReplaceWidget::fillItemsList()
 	connect(project_, &QETProject::destroyed, this, &SearchAndReplaceWidget::on_m_reload_pb_clicked);
 
 	
+	QSettings settings;
+	m_final_folio = settings.value("genericpanel/folio", true).toBool();
+	
 	DiagramContent dc;
 	for (Diagram *diagram : project_->diagrams())
 	{
-		QString str;
-		
-		QSettings settings;
-		if (settings.value("genericpanel/folio", true).toBool()) {
-			str = diagram->border_and_titleblock.finalfolio();
-		} else {
-			str = QString::number(diagram->folioIndex());
-		}
-		
-		str.append(" " + diagram->title());
-		
 		QTreeWidgetItem *qtwi = new QTreeWidgetItem(m_folio_qtwi);
-		qtwi->setText(0, str);
-		qtwi->setData(0, Qt::UserRole, searchTerms(diagram));
+		qtwi->setText(0, itemText(diagram, m_final_folio));
 		qtwi->setCheckState(0, Qt::Checked);
 		m_diagram_hash.insert(qtwi, QPointer<Diagram>(diagram));
+		indexItem(qtwi, diagram, searchTerms(diagram));
+		
+		BorderTitleBlock *titleblock = &diagram->border_and_titleblock;
+		m_index_connections << connect(titleblock, &BorderTitleBlock::informationChanged, this, [this, diagram]() {updateIndexedObject(diagram);});
+		m_index_connections << connect(titleblock, &BorderTitleBlock::titleBlockFolioChanged, this, [this, diagram]() {updateIndexedObject(diagram);});
+		diagram->materialize();
 		dc += DiagramContent(diagram, false);
 	}
 	
@@ -279,8 +279,9 @@ void SearchAndReplaceWidget::fillItemsList()
 		QTreeWidgetItem *qtwi = new QTreeWidgetItem(m_indi_text_qtwi);
 		qtwi->setText(0, iti->toPlainText());
 		qtwi->setCheckState(0, Qt::Checked);
-		qtwi->setData(0, Qt::UserRole, iti->toPlainText());
 		m_text_hash.insert(qtwi, QPointer<IndependentTextItem>(iti));
+		indexItem(qtwi, iti, QStringList(iti->toPlainText()));
+		m_index_connections << connect(iti->document(), &QTextDocument::contentsChanged, this, [this, iti]() {updateIndexedObject(iti);});
 	}
 	m_indi_text_qtwi->sortChildren(0, Qt::AscendingOrder);
 
@@ -289,8 +290,9 @@ void SearchAndReplaceWidget::fillItemsList()
 		QTreeWidgetItem *qtwi = new QTreeWidgetItem(m_conductor_qtwi);
 		qtwi->setText(0, c->properties().text);
 		qtwi->setCheckState(0, Qt::Checked);
-		qtwi->setData(0, Qt::UserRole, searchTerms(c));
 		m_conductor_hash.insert(qtwi, QPointer<Conductor>(c));
+		indexItem(qtwi, c, searchTerms(c));
+		m_index_connections << connect(c, &Conductor::propertiesChange, this, [this, c]() {updateIndexedObject(c);});
 	}
 	m_conductor_qtwi->sortChildren(0, Qt::AscendingOrder);
 	
@@ -331,16 +333,10 @@ void SearchAndReplaceWidget::addElement(Element *element)
 	QTreeWidgetItem *qtwi = new QTreeWidgetItem(parent);
 	m_element_hash.insert(qtwi, QPointer<Element>(element));
 	
-	QString str;
-	str += element->elementInformations().value("label").toString();
-	if(!str.isEmpty())
-		str += ("   ");
-	str += element->elementInformations().value("comment").toString();
-	if (str.isEmpty())
-		str = tr("Inconnue");
-	qtwi->setText(0, str);
+	qtwi->setText(0, itemText(element));
 	qtwi->setCheckState(0, Qt::Checked);
-	qtwi->setData(0, Qt::UserRole, searchTerms(element));
+	indexItem(qtwi, element, searchTerms(element));
+	m_index_connections << connect(element, &Element::elementInfoChange, this, [this, element]() {updateIndexedObject(element);});
 }
 
 /**
@@ -366,44 +362,31 @@ void SearchAndReplaceWidget::search()
 	}
 	else
 	{
-		for (QTreeWidgetItemIterator it(m_root_qtwi) ; *it ; ++it) {
-			(*it)->setHidden(true);
-		}
+			//Extended search, the index only check the items
+			//which contain every trigrams of the searched string
+		QSet<QObject *> result = m_index.search(str, searchMode(), searchCaseSensitivity());
+		bool match = !result.isEmpty();
 		
-		bool match = false;
+		QSet<QTreeWidgetItem *> matching_items;
+		for (QObject *object : result) {
+			if (QTreeWidgetItem *qtwi = m_object_hash.value(object)) {
+				matching_items.insert(qtwi);
+			}
+		}
 		
-			//Extended search,
-			//on each string stored in column 0 with role : UserRole
-		QList<QTreeWidgetItem *> qtwi_list;
-		qtwi_list.append(m_diagram_hash.keys());
-		qtwi_list.append(m_element_hash.keys());
-		qtwi_list.append(m_text_hash.keys());
-		qtwi_list.append(m_conductor_hash.keys());
-		for (QTreeWidgetItem *qtwi : qtwi_list)
+			//Hide every items, categories and intermediate items included,
+			//shown by a previous search, then show the matching items and their parents
+		for (QTreeWidgetItemIterator it(m_root_qtwi) ; *it ; ++it)
 		{
-			QStringList list = qtwi->data(0, Qt::UserRole).toStringList();
-			
-			if(ui->m_mode_cb->currentIndex() == 0)
-			{
-					//Contain string
-				list = list.filter(str, ui->m_case_sensitive_cb->isChecked()? Qt::CaseSensitive : Qt::CaseInsensitive);
-			}
-			else
-			{
-					//entire word
-				QRegularExpression rx("\\b" + str + "\\b");
-				if (!ui->m_case_sensitive_cb->isChecked()) {
-					rx.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
-				}
-				list = list.filter(rx);
-			}
-			if (!list.isEmpty())
-			{
-				match = true;
-				qtwi->setHidden(false);
-				setVisibleAllParents(qtwi);
+			QTreeWidgetItem *qtwi = *it;
+			bool hide = !matching_items.contains(qtwi);
+			if (qtwi->isHidden() != hide) {
+				qtwi->setHidden(hide);
 			}
 		}
+		for (QTreeWidgetItem *qtwi : matching_items) {
+			setVisibleAllParents(qtwi);
+		}
 		
 		QPalette background = ui->m_search_le->palette();
 		background.setColor(QPalette::Base, match ? QColor("#E0FFF0") : QColor("#FFE0EF"));
@@ -415,6 +398,126 @@ void SearchAndReplaceWidget::search()
 	}
 }
 
+/**
+ * @brief SearchAndReplaceWidget::clearIndex
+ * Clear the search index and disconnect the signals used to keep it up to date
+ */
+void SearchAndReplaceWidget::clearIndex()
+{
+	for (const QMetaObject::Connection &connection : m_index_connections) {
+		disconnect(connection);
+	}
+	m_index_connections.clear();
+	
+	for (QObject *object : m_object_hash.keys()) {
+		disconnect(object, &QObject::destroyed, this, &SearchAndReplaceWidget::removeIndexedObject);
+	}
+	m_object_hash.clear();
+	m_index.clear();
+}
+
+/**
+ * @brief SearchAndReplaceWidget::indexItem
+ * Add @object to the search index
+ * @param qtwi : the tree item of @object
+ * @param object : object to index
+ * @param terms : the terms of @object
+ */
+void SearchAndReplaceWidget::indexItem(QTreeWidgetItem *qtwi, QObject *object, const QStringList &terms)
+{
+	m_object_hash.insert(object, qtwi);
+	m_index.insert(object, terms);
+	connect(object, &QObject::destroyed, this, &SearchAndReplaceWidget::removeIndexedObject);
+}
+
+/**
+ * @brief SearchAndReplaceWidget::updateIndexedObject
+ * Update the tree item and the search terms of @object,
+ * and show or hide the item according to the current search.
+ * Called each time a property of @object, used by the search, changes.
+ * @param object
+ */
+void SearchAndReplaceWidget::updateIndexedObject(QObject *object)
+{
+	QTreeWidgetItem *qtwi = m_object_hash.value(object);
+	if (!qtwi) {
+		return;
+	}
+	
+	if (m_diagram_hash.contains(qtwi))
+	{
+		Diagram *diagram = static_cast<Diagram *>(object);
+		qtwi->setText(0, itemText(diagram, m_final_folio));
+		m_index.insert(object, searchTerms(diagram));
+	}
+	else if (m_element_hash.contains(qtwi))
+	{
+		Element *element = static_cast<Element *>(object);
+		qtwi->setText(0, itemText(element));
+		m_index.insert(object, searchTerms(element));
+	}
+	else if (m_conductor_hash.contains(qtwi))
+	{
+		Conductor *conductor = static_cast<Conductor *>(object);
+		qtwi->setText(0, conductor->properties().text);
+		m_index.insert(object, searchTerms(conductor));
+	}
+	else if (m_text_hash.contains(qtwi))
+	{
+		IndependentTextItem *text = static_cast<IndependentTextItem *>(object);
+		qtwi->setText(0, text->toPlainText());
+		m_index.insert(object, QStringList(text->toPlainText()));
+	}
+	
+	QString str = ui->m_search_le->text();
+	if (!str.isEmpty())
+	{
+		bool match = m_index.match(object, str, searchMode(), searchCaseSensitivity());
+		qtwi->setHidden(!match);
+		if (match) {
+			setVisibleAllParents(qtwi);
+		}
+	}
+}
+
+/**
+ * @brief SearchAndReplaceWidget::removeIndexedObject
+ * Remove @object from the search index and remove its tree item.
+ * Called when @object is destroyed, so @object is only used as key.
+ * @param object
+ */
+void SearchAndReplaceWidget::removeIndexedObject(QObject *object)
+{
+	m_index.remove(object);
+	QTreeWidgetItem *qtwi = m_object_hash.take(object);
+	if (!qtwi) {
+		return;
+	}
+	
+	m_diagram_hash.remove(qtwi);
+	m_element_hash.remove(qtwi);
+	m_text_hash.remove(qtwi);
+	m_conductor_hash.remove(qtwi);
+	delete qtwi;
+	updateNextPreviousButtons();
+}
+
+/**
+ * @brief SearchAndReplaceWidget::searchMode
+ * @return the search mode selected by user
+ */
+SearchIndex::Mode SearchAndReplaceWidget::searchMode() const {
+	return ui->m_mode_cb->currentIndex() == 0 ? SearchIndex::Contains : SearchIndex::EntireWord;
+}
+
+/**
+ * @brief SearchAndReplaceWidget::searchCaseSensitivity
+ * @return the case sensitivity selected by user
+ */
+Qt::CaseSensitivity SearchAndReplaceWidget::searchCaseSensitivity() const {
+	return ui->m_case_sensitive_cb->isChecked() ? Qt::CaseSensitive : Qt::CaseInsensitive;
+}
+
 /**
  * @brief SearchAndReplaceWidget::setVisibleAllParents
  * Set visible all parents of @item until the invisible root item
@@ -722,6 +825,42 @@ QList<IndependentTextItem *> SearchAndReplaceWidget::selectedText() const
 	return text_list;
 }
 
+/**
+ * @brief SearchAndReplaceWidget::itemText
+ * @param diagram
+ * @param final_folio : if true use the final folio of the title block, else the folio index
+ * @return the text of the tree item of @diagram
+ */
+QString SearchAndReplaceWidget::itemText(Diagram *diagram, bool final_folio)
+{
+	QString str;
+	if (final_folio) {
+		str = diagram->border_and_titleblock.finalfolio();
+	} else {
+		str = QString::number(diagram->folioIndex());
+	}
+	
+	str.append(" " + diagram->title());
+	return str;
+}
+
+/**
+ * @brief SearchAndReplaceWidget::itemText
+ * @param element
+ * @return the text of the tree item of @element
+ */
+QString SearchAndReplaceWidget::itemText(Element *element)
+{
+	QString str;
+	str += element->elementInformations().value("label").toString();
+	if(!str.isEmpty())
+		str += ("   ");
+	str += element->elementInformations().value("comment").toString();
+	if (str.isEmpty())
+		str = tr("Inconnue");
+	return str;
+}
+
 /**
  * @brief SearchAndReplaceWidget::searchTerms
  * @param diagram
@@ -1098,12 +1237,9 @@ void SearchAndReplaceWidget::on_m_replace_all_pb_clicked()
 		m_worker.replaceAdvanced(selectedDiagram(), selectedElement(), selectedText(), selectedConductor());
 	}	
 	
-		//Change was made, we reload the panel
-		//and search again to keep up to date the tree widget
-		//and the match item of search
-	QString txt = ui->m_search_le->text();
-	on_m_reload_pb_clicked();
-	ui->m_search_le->setText(txt);
+		//Change was made, the tree items and the search index are updated
+		//through the change signals of each item, we only search again
+		//to keep up to date the match item of search
 	search();
 }
 
@@ -24,6 +24,7 @@
 #include "element.h"
 #include "independenttextitem.h"
 #include "searchandreplaceworker.h"
+#include "searchindex.h"
 
 class QTreeWidgetItem;
 
@@ -51,6 +52,12 @@ class SearchAndReplaceWidget : public QWidget
 		void fillItemsList();
 		void addElement(Element *element);
 		void search();
+		void clearIndex();
+		void indexItem(QTreeWidgetItem *qtwi, QObject *object, const QStringList &terms);
+		void updateIndexedObject(QObject *object);
+		void removeIndexedObject(QObject *object);
+		SearchIndex::Mode searchMode() const;
+		Qt::CaseSensitivity searchCaseSensitivity() const;
 		
 		void setVisibleAllParents(QTreeWidgetItem *item, bool expend_parent = true);
 		QTreeWidgetItem *nextItem(QTreeWidgetItem *item=nullptr, QTreeWidgetItemIterator::IteratorFlag flags = QTreeWidgetItemIterator::All) const;
@@ -69,6 +76,8 @@ class SearchAndReplaceWidget : public QWidget
 		static QStringList searchTerms(Element *element);
 		static QStringList searchTerms(Conductor *conductor);
 		static QStringList searchTerms(QString str);
+		static QString itemText(Diagram *diagram, bool final_folio);
+		static QString itemText(Element *element);
 		
 	private slots:
 		void on_m_quit_button_clicked();
@@ -109,6 +118,11 @@ class SearchAndReplaceWidget : public QWidget
 		QPointer<QGraphicsObject> m_last_selected;
 		QHash<QTreeWidgetItem *, QPointer <Diagram>> m_diagram_hash;
 		SearchAndReplaceWorker m_worker;
+		SearchIndex m_index;
+		QHash<QObject *, QTreeWidgetItem *> m_object_hash;
+		QList<QMetaObject::Connection> m_index_connections;
+			///Value of the setting "genericpanel/folio", read when the tree is filled
+		bool m_final_folio = true;
 };
 
 #endif // SEARCHANDREPLACEWIDGET_H
@@ -25,6 +25,7 @@
 #include <QVariant>
 #include <QStringList>
 #include <utility>
+#include "qettrace.h"
 
 namespace autonum
 {
@@ -151,6 +152,62 @@ namespace autonum
 		hundred_folio.clear();
 	}
 
+	/**
+	 * @brief FormulaContext::FormulaContext
+	 * Build a null context, formulas evaluated with a null context are returned as is.
+	 */
+	FormulaContext::FormulaContext()
+	{}
+
+	/**
+	 * @brief FormulaContext::FormulaContext
+	 * Build a context from the current values of @diagram and @elmt
+	 * @param diagram
+	 * @param elmt
+	 */
+	FormulaContext::FormulaContext(Diagram *diagram, const Element *elmt)
+	{
+		if (!diagram) {
+			return;
+		}
+
+		m_null = false;
+		folio              = diagram->border_and_titleblock.folio();
+		folio_index        = diagram->folioIndex();
+		folio_total        = diagram->border_and_titleblock.folioTotal();
+		plant              = diagram->border_and_titleblock.plant();
+		locmach            = diagram->border_and_titleblock.locmach();
+		title_block_fields = diagram->border_and_titleblock.additionalFields();
+		project_properties = diagram->project()->projectProperties();
+
+		if (elmt)
+		{
+			QSettings settings;
+			setElement(diagram, elmt, settings.value("border-columns_0", true).toBool());
+		}
+	}
+
+	/**
+	 * @brief FormulaContext::setElement
+	 * Set the values of @elmt, used to build the context of several
+	 * elements of the same diagram without copying the values of the diagram again.
+	 * @param diagram : the diagram of @elmt
+	 * @param elmt
+	 * @param first_column_is_0 : value of the setting "border-columns_0"
+	 */
+	void FormulaContext::setElement(Diagram *diagram, const Element *elmt, bool first_column_is_0)
+	{
+		has_element = elmt && diagram;
+		if (!has_element) {
+			return;
+		}
+
+		DiagramPosition position = diagram->convertPosition(elmt->scenePos());
+		column     = first_column_is_0 ? position.number() - 1 : position.number();
+		row_letter = position.letter();
+		prefix     = elmt->getPrefix();
+	}
+
 	/**
 	 * @brief AssignVariables::formulaToLabel
 	 * Return the @formula with variable assigned (ready to be displayed)
@@ -162,11 +219,28 @@ namespace autonum
 	 */
 	QString AssignVariables::formulaToLabel(QString formula, sequentialNumbers &seqStruct, Diagram *diagram, const Element *elmt)
 	{
-		AssignVariables av(std::move(formula), seqStruct, diagram, elmt);
+		QET_TRACE("AssignVariables::formulaToLabel");
+		FormulaContext context(diagram, elmt);
+		AssignVariables av(std::move(formula), seqStruct, context);
 		seqStruct = av.m_seq_struct;
 		return av.m_assigned_label;
 	}
-	
+
+	/**
+	 * @brief AssignVariables::formulaToLabel
+	 * Return the @formula with variable assigned from @context.
+	 * This method don't access to any diagram or element and can be called from any thread.
+	 * @param formula - the formula to work
+	 * @param seqStruct - sequential values of the element
+	 * @param context - the values of the diagram and element where occure the formula
+	 * @return the string with variable assigned.
+	 */
+	QString AssignVariables::formulaToLabel(QString formula, const sequentialNumbers &seqStruct, const FormulaContext &context)
+	{
+		AssignVariables av(std::move(formula), seqStruct, context);
+		return av.m_assigned_label;
+	}
+
 	/**
 	 * @brief AssignVariables::replaceVariable
 	 * Replace the variables in @formula in form %{my-var} to the corresponding value stored in @dc
@@ -177,54 +251,48 @@ namespace autonum
 	QString AssignVariables::replaceVariable(const QString &formula, const DiagramContext &dc)
 	{
 		QString str = formula;
-		str.replace("%{label}", dc.value("label").toString());
-		str.replace("%{plant}", dc.value("plant").toString());
-		str.replace("%{comment}", dc.value("comment").toString());
-		str.replace("%{description}", dc.value("description").toString());
-		str.replace("%{designation}", dc.value("designation").toString());
-		str.replace("%{manufacturer}", dc.value("manufacturer").toString());
-		str.replace("%{manufacturer-reference}", dc.value("manufacturer-reference").toString());
-		str.replace("%{supplier}", dc.value("supplier").toString());
-		str.replace("%{quantity}", dc.value("quantity").toString());
-		str.replace("%{unity}", dc.value("unity").toString());
-		str.replace("%{auxiliary1}", dc.value("auxiliary1").toString());
-		str.replace("%{auxiliary2}", dc.value("auxiliary2").toString());
-		str.replace("%{machine-manufacturer-reference}", dc.value("machine-manufacturer-reference").toString());
-		str.replace("%{location}", dc.value("location").toString());
-		str.replace("%{function}", dc.value("function").toString());
+		str.replace("%{label}", dc.value(DiagramContext::Label).toString());
+		str.replace("%{plant}", dc.value(DiagramContext::Plant).toString());
+		str.replace("%{comment}", dc.value(DiagramContext::Comment).toString());
+		str.replace("%{description}", dc.value(DiagramContext::Description).toString());
+		str.replace("%{designation}", dc.value(DiagramContext::Designation).toString());
+		str.replace("%{manufacturer}", dc.value(DiagramContext::Manufacturer).toString());
+		str.replace("%{manufacturer-reference}", dc.value(DiagramContext::ManufacturerReference).toString());
+		str.replace("%{supplier}", dc.value(DiagramContext::Supplier).toString());
+		str.replace("%{quantity}", dc.value(DiagramContext::Quantity).toString());
+		str.replace("%{unity}", dc.value(DiagramContext::Unity).toString());
+		str.replace("%{auxiliary1}", dc.value(DiagramContext::Auxiliary1).toString());
+		str.replace("%{auxiliary2}", dc.value(DiagramContext::Auxiliary2).toString());
+		str.replace("%{machine-manufacturer-reference}", dc.value(DiagramContext::MachineManufacturerReference).toString());
+		str.replace("%{location}", dc.value(DiagramContext::Location).toString());
+		str.replace("%{function}", dc.value(DiagramContext::Function).toString());
 		str.replace("%{void}", QString());
 
 		return str;
 	}
 	
 	
-	AssignVariables::AssignVariables(const QString& formula, const sequentialNumbers& seqStruct , Diagram *diagram, const Element *elmt):
-	m_diagram(diagram),
+	AssignVariables::AssignVariables(const QString& formula, const sequentialNumbers& seqStruct , const FormulaContext &context):
+	m_context(context),
 	m_arg_formula(formula),
 	m_assigned_label(formula),
-	m_seq_struct(seqStruct),
-	m_element(elmt)
-	
+	m_seq_struct(seqStruct)
+
 	{
-		if (m_diagram)
+		if (!m_context.isNull())
 		{
-			m_assigned_label.replace("%F",  m_diagram -> border_and_titleblock.folio());
-			m_assigned_label.replace("%f",     QString::number(m_diagram->folioIndex()+1));
-			m_assigned_label.replace("%id",    QString::number(m_diagram->folioIndex()+1));
-			m_assigned_label.replace("%total", QString::number(m_diagram->border_and_titleblock.folioTotal()));
-			m_assigned_label.replace("%M",  m_diagram -> border_and_titleblock.plant());
-			m_assigned_label.replace("%LM", m_diagram -> border_and_titleblock.locmach());
-
-	QSettings settings;
-			if (m_element)
+			m_assigned_label.replace("%F",  m_context.folio);
+			m_assigned_label.replace("%f",     QString::number(m_context.folio_index+1));
+			m_assigned_label.replace("%id",    QString::number(m_context.folio_index+1));
+			m_assigned_label.replace("%total", QString::number(m_context.folio_total));
+			m_assigned_label.replace("%M",  m_context.plant);
+			m_assigned_label.replace("%LM", m_context.locmach);
+
+			if (m_context.has_element)
 			{
-			if (settings.value("border-columns_0", true).toBool()){
-				m_assigned_label.replace("%c", QString::number(m_diagram->convertPosition(m_element->scenePos()).number() - 1));
-				}else{
-				m_assigned_label.replace("%c", QString::number(m_diagram->convertPosition(m_element->scenePos()).number()));
-				}
-				m_assigned_label.replace("%l", m_diagram->convertPosition(m_element->scenePos()).letter());
-				m_assigned_label.replace("%prefix", m_element->getPrefix());
+				m_assigned_label.replace("%c", QString::number(m_context.column));
+				m_assigned_label.replace("%l", m_context.row_letter);
+				m_assigned_label.replace("%prefix", m_context.prefix);
 			}
 
 			assignTitleBlockVar();
@@ -235,28 +303,26 @@ namespace autonum
 
 	void AssignVariables::assignTitleBlockVar()
 	{
-		for (int i = 0; i < m_diagram->border_and_titleblock.additionalFields().count(); i++)
+		const DiagramContext &fields = m_context.title_block_fields;
+		for (const QString &folio_variable : fields.keys())
 		{
-			QString folio_variable = m_diagram->border_and_titleblock.additionalFields().keys().at(i);
-			QVariant folio_value = m_diagram->border_and_titleblock.additionalFields().operator [](folio_variable);
-
 			if (m_assigned_label.contains(folio_variable)) {
-				m_assigned_label.replace("%{" + folio_variable + "}", folio_value.toString());
-				m_assigned_label.replace("%"  + folio_variable      , folio_value.toString());
+				QString folio_value = fields.value(folio_variable).toString();
+				m_assigned_label.replace("%{" + folio_variable + "}", folio_value);
+				m_assigned_label.replace("%"  + folio_variable      , folio_value);
 			}
 		}
 	}
 
 	void AssignVariables::assignProjectVar()
 	{
-		for (int i = 0; i < m_diagram->project()->projectProperties().count(); i++)
+		const DiagramContext &properties = m_context.project_properties;
+		for (const QString &folio_variable : properties.keys())
 		{
-			QString folio_variable = m_diagram->project()->projectProperties().keys().at(i);
-			QVariant folio_value = m_diagram->project()->projectProperties().operator [](folio_variable);
-
 			if (m_assigned_label.contains(folio_variable)) {
-				m_assigned_label.replace("%{" + folio_variable + "}", folio_value.toString());
-				m_assigned_label.replace("%"  + folio_variable      , folio_value.toString());
+				QString folio_value = properties.value(folio_variable).toString();
+				m_assigned_label.replace("%{" + folio_variable + "}", folio_value);
+				m_assigned_label.replace("%"  + folio_variable      , folio_value);
 			}
 		}
 	}
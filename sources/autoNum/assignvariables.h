@@ -54,6 +54,39 @@ namespace autonum
 			QStringList hundred_folio;
 	};
 
+	/**
+	 * @brief The FormulaContext class
+	 * Copy of the values of a diagram (and optionally of an element of this diagram)
+	 * used to assign the variables of a formula.
+	 * Once built (in the thread of the diagram), a FormulaContext don't depend
+	 * anymore of the diagram, so formulas can be evaluated in another thread.
+	 */
+	class FormulaContext
+	{
+		public:
+			FormulaContext();
+			FormulaContext(Diagram *diagram, const Element *elmt = nullptr);
+
+			void setElement(Diagram *diagram, const Element *elmt, bool first_column_is_0);
+			bool isNull() const {return m_null;}
+
+			QString folio;
+			int folio_index = 0;
+			int folio_total = 0;
+			QString plant;
+			QString locmach;
+			DiagramContext title_block_fields;
+			DiagramContext project_properties;
+
+			bool has_element = false;
+			int column = 0;
+			QString row_letter;
+			QString prefix;
+
+		private:
+			bool m_null = true;
+	};
+
 	/**
 	 * @brief The AssignVariables class
 	 * This class assign variable of a formula string.
@@ -63,19 +96,19 @@ namespace autonum
 	{
 		public:
 			static QString formulaToLabel (QString formula, sequentialNumbers &seqStruct, Diagram *diagram, const Element *elmt = nullptr);
+			static QString formulaToLabel (QString formula, const sequentialNumbers &seqStruct, const FormulaContext &context);
 			static QString replaceVariable (const QString &formula, const DiagramContext &dc);
 
 		private:
-			AssignVariables(const QString& formula, const sequentialNumbers& seqStruct , Diagram *diagram, const Element *elmt = nullptr);
+			AssignVariables(const QString& formula, const sequentialNumbers& seqStruct , const FormulaContext &context);
 			void assignTitleBlockVar();
 			void assignProjectVar();
 			void assignSequence();
 
-			Diagram *m_diagram  = nullptr;
+			const FormulaContext &m_context;
 			QString m_arg_formula;
 			QString m_assigned_label;
 			sequentialNumbers m_seq_struct;
-			const Element *m_element = nullptr;
 	};
 
 	void setSequentialToList(QStringList &list, NumerotationContext &nc, const QString& type);
@@ -280,6 +280,7 @@ void BorderTitleBlock::importTitleBlock(const TitleBlockProperties &ip) {
 	emit(needFolioData()); // Note: we expect additional data to be provided
 	// through setFolioData(), which in turn calls updateDiagramContextForTitleBlock().
 	emit(needTitleBlockTemplate(ip.template_name));
+	emit(informationChanged());
 }
 
 /**
@@ -512,26 +513,25 @@ void BorderTitleBlock::draw(QPainter *painter)
 	painter -> restore();
 }
 
-void BorderTitleBlock::drawDxf(int width, int height, bool keep_aspect_ratio, QString &file_path, int color) {
+void BorderTitleBlock::drawDxf(int width, int height, bool keep_aspect_ratio, Createdxf &dxf, int color) {
 	Q_UNUSED (width); Q_UNUSED (height); Q_UNUSED (keep_aspect_ratio);
 
 	// Transform to DXF scale.
-	columns_header_height_ *= Createdxf::yScale;
-	rows_height_           *= Createdxf::yScale;
-	rows_header_width_     *= Createdxf::xScale;
-	columns_width_         *= Createdxf::xScale;
+	qreal columns_header_height = columns_header_height_ * dxf.yScale();
+	qreal rows_height           = rows_height_           * dxf.yScale();
+	qreal rows_header_width     = rows_header_width_     * dxf.xScale();
+	qreal columns_width         = columns_width_         * dxf.xScale();
 
 	// dessine la case vide qui apparait des qu'il y a un entete
 	if (display_border_ &&
 		(display_columns_ ||
 		 display_rows_)
 		) {
-		Createdxf::drawRectangle(
-			file_path,
-			double(diagram_rect_.topLeft().x()) * Createdxf::xScale,
-			Createdxf::sheetHeight - double(diagram_rect_.topLeft().y()) * Createdxf::yScale - columns_header_height_,
-			rows_header_width_,
-			columns_header_height_,
+		dxf.drawRectangle(
+			double(diagram_rect_.topLeft().x()) * dxf.xScale(),
+			Createdxf::sheetHeight - double(diagram_rect_.topLeft().y()) * dxf.yScale() - columns_header_height,
+			rows_header_width,
+			columns_header_height,
 			color
 		);
 	}
@@ -543,18 +543,18 @@ void BorderTitleBlock::drawDxf(int width, int height, bool keep_aspect_ratio, QS
 		display_columns_) {
 		for (int i = 1 ; i <= columns_count_ ; ++ i) {
 			double xCoord = diagram_rect_.topLeft().x() +
-					(rows_header_width_ + ((i - 1) *
-					 columns_width_));
-			double yCoord = Createdxf::sheetHeight - diagram_rect_.topLeft().y() - columns_header_height_;
-			double recWidth = columns_width_;
-			double recHeight = columns_header_height_;
-			Createdxf::drawRectangle(file_path, xCoord, yCoord, recWidth, recHeight, color);
+					(rows_header_width + ((i - 1) *
+					 columns_width));
+			double yCoord = Createdxf::sheetHeight - diagram_rect_.topLeft().y() - columns_header_height;
+			double recWidth = columns_width;
+			double recHeight = columns_header_height;
+			dxf.drawRectangle(xCoord, yCoord, recWidth, recHeight, color);
 			if (settings.value("border-columns_0", true).toBool()){
-			Createdxf::drawTextAligned(file_path, QString::number(i - 1), xCoord,
-									   yCoord + recHeight*0.5, recHeight*0.7, 0, 0, 1, 2, xCoord+recWidth/2, color, 0);
+			dxf.drawTextAligned(QString::number(i - 1), xCoord,
+								yCoord + recHeight*0.5, recHeight*0.7, 0, 0, 1, 2, xCoord+recWidth/2, color, 0);
 			}else{
-			Createdxf::drawTextAligned(file_path, QString::number(i), xCoord,
-									   yCoord + recHeight*0.5, recHeight*0.7, 0, 0, 1, 2, xCoord+recWidth/2, color, 0);
+			dxf.drawTextAligned(QString::number(i), xCoord,
+								yCoord + recHeight*0.5, recHeight*0.7, 0, 0, 1, 2, xCoord+recWidth/2, color, 0);
 			}
 		}
 	}
@@ -564,15 +564,15 @@ void BorderTitleBlock::drawDxf(int width, int height, bool keep_aspect_ratio, QS
 	if (display_border_ && display_rows_) {
 		QString row_string("A");
 		for (int i = 1 ; i <= rows_count_ ; ++ i) {
-			double xCoord = diagram_rect_.topLeft().x() * Createdxf::xScale;
-			double yCoord = Createdxf::sheetHeight - diagram_rect_.topLeft().y()*Createdxf::yScale
-							- (columns_header_height_ + ((i - 1) * rows_height_))
-							- rows_height_;
-			double recWidth = rows_header_width_;
-			double recHeight = rows_height_;
-			Createdxf::drawRectangle(file_path, xCoord, yCoord, recWidth, recHeight, color);
-			Createdxf::drawTextAligned(file_path, row_string, xCoord,
-									   yCoord + recHeight*0.5, recWidth*0.7, 0, 0, 1, 2, xCoord+recWidth/2, color, 0);
+			double xCoord = diagram_rect_.topLeft().x() * dxf.xScale();
+			double yCoord = Createdxf::sheetHeight - diagram_rect_.topLeft().y()*dxf.yScale()
+							- (columns_header_height + ((i - 1) * rows_height))
+							- rows_height;
+			double recWidth = rows_header_width;
+			double recHeight = rows_height;
+			dxf.drawRectangle(xCoord, yCoord, recWidth, recHeight, color);
+			dxf.drawTextAligned(row_string, xCoord,
+								yCoord + recHeight*0.5, recWidth*0.7, 0, 0, 1, 2, xCoord+recWidth/2, color, 0);
 			row_string = incrementLetters(row_string);
 		}
 	}
@@ -581,16 +581,9 @@ void BorderTitleBlock::drawDxf(int width, int height, bool keep_aspect_ratio, QS
 	if (display_titleblock_) {
 		//qp -> translate(titleblock_rect_.topLeft());
 		QRectF rect = titleBlockRect();
-		titleblock_template_renderer_ -> renderDxf(rect, rect.width(), file_path, color);
+		titleblock_template_renderer_ -> renderDxf(rect, rect.width(), dxf, color);
 		//qp -> translate(-titleblock_rect_.topLeft());
 	}
-
-	// Transform back to QET scale
-	columns_header_height_ /= Createdxf::yScale;
-	rows_height_		   /= Createdxf::yScale;
-	rows_header_width_     /= Createdxf::xScale;
-	columns_width_         /= Createdxf::xScale;
-
 }
 
 /**
@@ -740,32 +733,36 @@ void BorderTitleBlock::setFolio(const QString &folio)
 	DiagramContext object.
 	@param initial_context Base diagram context that will be overridden by
 	diagram-wide values
+	@return true if the context changed. When the context is the same, the
+	renderer is left untouched and keep its rendered titleblock.
 */
-void BorderTitleBlock::updateDiagramContextForTitleBlock(const DiagramContext &initial_context) {
+bool BorderTitleBlock::updateDiagramContextForTitleBlock(const DiagramContext &initial_context) {
 	// Our final DiagramContext is the initial one (which is supposed to bring
 	// project-wide properties), overridden by the "additional fields" one...
 	DiagramContext context = initial_context;
-	foreach (QString key, additional_fields_.keys()) {
-		context.addValue(key, additional_fields_[key]);
-	}
+	context.add(additional_fields_);
 	
 	// ... overridden by the historical and/or dynamically generated fields
-	context.addValue("author",      btb_author_);
-	context.addValue("date",        btb_date_.toString(Qt::SystemLocaleShortDate));
-	context.addValue("title",       btb_title_);
-	context.addValue("filename",    btb_filename_);
-	context.addValue("plant",     btb_plant_);
-	context.addValue("locmach",     btb_locmach_);
-	context.addValue("indexrev",    btb_indexrev_);
-	context.addValue("version",     btb_version_);
-	context.addValue("folio",       btb_final_folio_);
-	context.addValue("folio-id",    folio_index_);
-	context.addValue("folio-total", folio_total_);
+	context.addValue(DiagramContext::Author,           btb_author_);
+	context.addValue(DiagramContext::Date,             btb_date_.toString(Qt::SystemLocaleShortDate));
+	context.addValue(DiagramContext::Title,            btb_title_);
+	context.addValue(DiagramContext::Filename,         btb_filename_);
+	context.addValue(DiagramContext::Plant,            btb_plant_);
+	context.addValue(DiagramContext::Locmach,          btb_locmach_);
+	context.addValue(DiagramContext::Indexrev,         btb_indexrev_);
+	context.addValue(DiagramContext::Version,          btb_version_);
+	context.addValue(DiagramContext::Folio,            btb_final_folio_);
+	context.addValue(DiagramContext::FolioId,          folio_index_);
+	context.addValue(DiagramContext::FolioTotal,       folio_total_);
 	context.addValue("auto_page_num", btb_auto_page_num_);
-	context.addValue("previous-folio-num", m_previous_folio_num);
-	context.addValue("next-folio-num", m_next_folio_num);
+	context.addValue(DiagramContext::PreviousFolioNum, m_previous_folio_num);
+	context.addValue(DiagramContext::NextFolioNum,     m_next_folio_num);
 	
+	if (context == titleblock_template_renderer_ -> context()) {
+		return(false);
+	}
 	titleblock_template_renderer_ -> setContext(context);
+	return(true);
 }
 
 QString BorderTitleBlock::incrementLetters(const QString &string) {
@@ -789,9 +786,10 @@ QString BorderTitleBlock::incrementLetters(const QString &string) {
 	@param index numero du schema (de 1 a total)
 	@param total nombre total de schemas dans le projet
 	@param project_properties Project-wide properties, to be merged with diagram-wide ones.
+	@return true if the informations given to the titleblock template changed
 */
-void BorderTitleBlock::setFolioData(int index, int total, const QString& autonum, const DiagramContext &project_properties) {
-	if (index < 1 || total < 1 || index > total) return;
+bool BorderTitleBlock::setFolioData(int index, int total, const QString& autonum, const DiagramContext &project_properties) {
+	if (index < 1 || total < 1 || index > total) return(false);
 	
 	// memorise les informations
 	folio_index_ = index;
@@ -808,7 +806,7 @@ void BorderTitleBlock::setFolioData(int index, int total, const QString& autonum
 	btb_final_folio_.replace("%total", QString::number(folio_total_));
 
 
-	updateDiagramContextForTitleBlock(project_properties);
+	return(updateDiagramContextForTitleBlock(project_properties));
 }
 
 /**
@@ -862,23 +860,33 @@ void BorderTitleBlock::setAutoPageNum(const QString &auto_page_num) {
 /**
  * @brief BorderTitleBlock::setPreviousFolioNum
  * @param previous the new value of the "previous-folio-num" field
+ * @return true if the value changed
  */
-void BorderTitleBlock::setPreviousFolioNum(const QString &previous)
+bool BorderTitleBlock::setPreviousFolioNum(const QString &previous)
 {
+	if (previous == m_previous_folio_num) {
+		return false;
+	}
 	m_previous_folio_num = previous;
 	DiagramContext context = titleblock_template_renderer_->context();
-	context.addValue("previous-folio-num", m_previous_folio_num);
+	context.addValue(DiagramContext::PreviousFolioNum, m_previous_folio_num);
 	titleblock_template_renderer_->setContext(context);
+	return true;
 }
 
 /**
  * @brief BorderTitleBlock::setNextFolioNum
  * @param next the new value of the "next-folio-num" field
+ * @return true if the value changed
  */
-void BorderTitleBlock::setNextFolioNum(const QString &next)
+bool BorderTitleBlock::setNextFolioNum(const QString &next)
 {
+	if (next == m_next_folio_num) {
+		return false;
+	}
 	m_next_folio_num = next;
 	DiagramContext context = titleblock_template_renderer_->context();
-	context.addValue("next-folio-num", m_next_folio_num);
+	context.addValue(DiagramContext::NextFolioNum, m_next_folio_num);
 	titleblock_template_renderer_->setContext(context);
+	return true;
 }
@@ -28,6 +28,7 @@ class QPainter;
 class DiagramPosition;
 class TitleBlockTemplate;
 class TitleBlockTemplateRenderer;
+class Createdxf;
 /**
 	This class represents the border and the titleblock which frame a
 	particular electric diagram.
@@ -46,7 +47,7 @@ class BorderTitleBlock : public QObject
 		//METHODS
 	public:	
 		void draw(QPainter *painter);
-		void drawDxf(int, int, bool, QString &, int);
+		void drawDxf(int, int, bool, Createdxf &, int);
 	
 		//METHODS TO GET DIMENSION
 		//COLUMNS
@@ -140,15 +141,15 @@ class BorderTitleBlock : public QObject
 		void setDate(const QDate &date);
 		void setTitle(const QString &title);
 		void setFolio(const QString &folio);
-		void setFolioData(int, int, const QString& = nullptr, const DiagramContext & = DiagramContext());
+		bool setFolioData(int, int, const QString& = nullptr, const DiagramContext & = DiagramContext());
 		void setPlant(const QString &plant);
 		void setLocMach(const QString &locmach);
 		void setIndicerev(const QString &indexrev);
 		void setFileName(const QString &filename);
 		void setVersion(const QString &version);
 		void setAutoPageNum(const QString &auto_page_num);
-		void setPreviousFolioNum(const QString &previous);
-		void setNextFolioNum(const QString &next);
+		bool setPreviousFolioNum(const QString &previous);
+		bool setNextFolioNum(const QString &next);
 		
 		void titleBlockToXml(QDomElement &);
 		void titleBlockFromXml(const QDomElement &);
@@ -177,7 +178,7 @@ class BorderTitleBlock : public QObject
 	
 	private:
 		void updateRectangles();
-		void updateDiagramContextForTitleBlock(const DiagramContext & = DiagramContext());
+		bool updateDiagramContextForTitleBlock(const DiagramContext & = DiagramContext());
 		QString incrementLetters(const QString &);
 	
 		signals:
@@ -200,6 +201,11 @@ class BorderTitleBlock : public QObject
 				Signal emitted after Folio has changed
 			*/
 		void titleBlockFolioChanged(const QString &);
+			/**
+				Signal emitted after the title block informations
+				were imported with importTitleBlock()
+			*/
+		void informationChanged();
 			/**
 				Signal emitted when the title block requires its data to be updated in order
 				to generate the folio field.
@@ -18,7 +18,6 @@
 #include "createdxf.h"
 #include <QFile>
 #include <QTextStream>
-#include <QMessageBox>
 #include <QString>
 #include "exportdialog.h"
 
@@ -26,10 +25,422 @@
 const double Createdxf::sheetWidth = 4000;
 const double Createdxf::sheetHeight = 2700;
 
-double Createdxf::xScale = 1;
-double Createdxf::yScale = 1;
+namespace {
+	/* Header section of every DXF file.*/
+	void writeHeader(QTextStream &To_Dxf)
+	{
+		To_Dxf << 999           << "\r\n";
+		To_Dxf << "QET"         << "\r\n";
+		To_Dxf << 0             << "\r\n";
+		To_Dxf << "SECTION"     << "\r\n";
+		To_Dxf << 2             << "\r\n";
+		To_Dxf << "HEADER"      << "\r\n";
+		To_Dxf << 9             << "\r\n";
+		To_Dxf << "$ACADVER"    << "\r\n";
+		To_Dxf << 1             << "\r\n";
+		To_Dxf << "AC1006"      << "\r\n";
+		To_Dxf << 9             << "\r\n";
+		To_Dxf << "$INSBASE"    << "\r\n";
+		To_Dxf << 10            << "\r\n";
+		To_Dxf << "0.0"         << "\r\n";
+		To_Dxf << 20            << "\r\n";
+		To_Dxf << "0.0"         << "\r\n";
+		To_Dxf << 30            << "\r\n";
+		To_Dxf << "0.0"         << "\r\n";
+		To_Dxf << 9             << "\r\n";
+
+		To_Dxf << "$EXTMIN"     << "\r\n";
+		To_Dxf << 10            << "\r\n";
+		To_Dxf << "0.0"         << "\r\n";
+		To_Dxf << 20            << "\r\n";
+		To_Dxf << "0.0"         << "\r\n";
+		To_Dxf << 9             << "\r\n";
+		To_Dxf << "$EXTMAX"     << "\r\n";
+		To_Dxf << 10            << "\r\n";
+		To_Dxf << "4000.0"      << "\r\n";
+		To_Dxf << 20            << "\r\n";
+		To_Dxf << "4000.0"      << "\r\n";
+
+		To_Dxf << 9             << "\r\n";
+		To_Dxf << "$LIMMIN"     << "\r\n";
+		To_Dxf << 10            << "\r\n";
+		To_Dxf << "0.0"         << "\r\n";
+		To_Dxf << 20            << "\r\n";
+		To_Dxf << "0.0"         << "\r\n";
+		To_Dxf << 9             << "\r\n";
+		To_Dxf << "$LIMMAX"     << "\r\n";
+		To_Dxf << 10            << "\r\n";
+		To_Dxf << "4000.0"      << "\r\n";
+		To_Dxf << 20            << "\r\n";
+		To_Dxf << "4000.0"      << "\r\n";
+		To_Dxf << 0             << "\r\n";
+		To_Dxf << "ENDSEC"      << "\r\n";
+		To_Dxf << 0             << "\r\n";
+		To_Dxf << "SECTION"     << "\r\n";
+		To_Dxf << 2             << "\r\n";
+		To_Dxf << "TABLES"      << "\r\n";
+		To_Dxf << 0             << "\r\n";
+		To_Dxf << "TABLE"       << "\r\n";
+		To_Dxf << 2             << "\r\n";
+
+		To_Dxf << "VPORT"       << "\r\n";
+		To_Dxf << 70            << "\r\n";
+		To_Dxf << 1             << "\r\n";
+		To_Dxf << 0             << "\r\n";
+		To_Dxf << "VPORT"       << "\r\n";
+		To_Dxf << 2             << "\r\n";
+		To_Dxf << "*ACTIVE"     << "\r\n";
+		To_Dxf << 70            << "\r\n";
+		To_Dxf << 0             << "\r\n";
+		To_Dxf << 10            << "\r\n";
+		To_Dxf << 0.0           << "\r\n";
+		To_Dxf << 20            << "\r\n";
+		To_Dxf << 0.0           << "\r\n";
+		To_Dxf << 11            << "\r\n";
+		To_Dxf << 1.0           << "\r\n";
+		To_Dxf << 21            << "\r\n";
+		To_Dxf << 1.0           << "\r\n";
+		To_Dxf << 12            << "\r\n";
+		To_Dxf << 2000          << "\r\n";
+		To_Dxf << 22            << "\r\n";
+		To_Dxf << 1350          << "\r\n";
+		To_Dxf << 13            << "\r\n";
+		To_Dxf << 0.0           << "\r\n";
+		To_Dxf << 23            << "\r\n";
+		To_Dxf << 0.0           << "\r\n";
+		To_Dxf << 14            << "\r\n";
+		To_Dxf << 1.0           << "\r\n";
+		To_Dxf << 24            << "\r\n";
+		To_Dxf << 1.0           << "\r\n";
+		To_Dxf << 15            << "\r\n";
+		To_Dxf << 0.0           << "\r\n";
+		To_Dxf << 25            << "\r\n";
+		To_Dxf << 0.0           << "\r\n";
+		To_Dxf << 16            << "\r\n";
+		To_Dxf << 0.0           << "\r\n";
+		To_Dxf << 26            << "\r\n";
+		To_Dxf << 0.0           << "\r\n";
+		To_Dxf << 36            << "\r\n";
+		To_Dxf << 1.0           << "\r\n";
+		To_Dxf << 17            << "\r\n";
+		To_Dxf << 0.0           << "\r\n";
+		To_Dxf << 27            << "\r\n";
+		To_Dxf << 0.0           << "\r\n";
+		To_Dxf << 37            << "\r\n";
+		To_Dxf << 0.0           << "\r\n";
+		To_Dxf << 40            << "\r\n";
+		To_Dxf << 2732.5        << "\r\n";
+		To_Dxf << 41            << "\r\n";
+		To_Dxf << 2.558         << "\r\n";
+		To_Dxf << 42            << "\r\n";
+		To_Dxf << 50.0          << "\r\n";
+		To_Dxf << 43            << "\r\n";
+		To_Dxf << 0.0           << "\r\n";
+		To_Dxf << 44            << "\r\n";
+		To_Dxf << 0.0           << "\r\n";
+		To_Dxf << 50            << "\r\n";
+		To_Dxf << 0.0           << "\r\n";
+		To_Dxf << 51            << "\r\n";
+		To_Dxf << 0.0           << "\r\n";
+		To_Dxf << 71            << "\r\n";
+		To_Dxf << 0             << "\r\n";
+		To_Dxf << 72            << "\r\n";
+		To_Dxf << 100           << "\r\n";
+		To_Dxf << 73            << "\r\n";
+		To_Dxf << 1             << "\r\n";
+		To_Dxf << 74            << "\r\n";
+		To_Dxf << 1             << "\r\n";
+		To_Dxf << 75            << "\r\n";
+		To_Dxf << 0             << "\r\n";
+		To_Dxf << 76            << "\r\n";
+		To_Dxf << 0             << "\r\n";
+		To_Dxf << 77            << "\r\n";
+		To_Dxf << 0             << "\r\n";
+		To_Dxf << 78            << "\r\n";
+		To_Dxf << 0             << "\r\n";
+		To_Dxf << 0             << "\r\n";
+		To_Dxf << "ENDTAB"      << "\r\n";
+		To_Dxf << 0             << "\r\n";
+		To_Dxf << "TABLE"       << "\r\n";
+		To_Dxf << 2             << "\r\n";
+
+		To_Dxf << "LTYPE"       << "\r\n";
+		To_Dxf << 70            << "\r\n";
+		To_Dxf << 1             << "\r\n";
+		To_Dxf << 0             << "\r\n";
+		To_Dxf << "LTYPE"       << "\r\n";
+		To_Dxf << 2             << "\r\n";
+		To_Dxf << "CONTINUOUS"  << "\r\n";
+		To_Dxf << 70            << "\r\n";
+		To_Dxf << 64            << "\r\n";
+		To_Dxf << 3             << "\r\n";
+		To_Dxf << "Solid Line"  << "\r\n";
+		To_Dxf << 72            << "\r\n";
+		To_Dxf << 65            << "\r\n";
+		To_Dxf << 73            << "\r\n";
+		To_Dxf << 0             << "\r\n";
+		To_Dxf << 40            << "\r\n";
+		To_Dxf << 0.00          << "\r\n";
+		To_Dxf << 0             << "\r\n";
+
+		To_Dxf << "ENDTAB"      << "\r\n";
+		To_Dxf << 0             << "\r\n";
+		To_Dxf << "ENDSEC"      << "\r\n";
+		To_Dxf << 0             << "\r\n";
+		To_Dxf << "SECTION"     << "\r\n";
+		To_Dxf << 2             << "\r\n";
+		To_Dxf << "BLOCKS"      << "\r\n";
+		To_Dxf << 0             << "\r\n";
+		To_Dxf << "ENDSEC"      << "\r\n";
+		To_Dxf << 0             << "\r\n";
+		To_Dxf << "SECTION"     << "\r\n";
+		To_Dxf << 2             << "\r\n";
+		To_Dxf << "ENTITIES"    << "\r\n";
+	}
+
+	/* End Section of every DXF File*/
+	void writeFooter(QTextStream &To_Dxf)
+	{
+		To_Dxf << 0             << "\r\n";
+		To_Dxf << "ENDSEC"      << "\r\n";
+		To_Dxf << 0             << "\r\n";
+		To_Dxf << "EOF";
+	}
+
+	/* circle in dxf format*/
+	void writeCircle(QTextStream &To_Dxf, double radius, double x, double y, int colour)
+	{
+		// Draw the circle
+		To_Dxf << 0         << "\r\n";
+		To_Dxf << "CIRCLE"  << "\r\n";
+		To_Dxf << 8         << "\r\n";
+		To_Dxf << 0         << "\r\n";    // Layer number (default layer in autocad)
+		To_Dxf << 62        << "\r\n";
+		To_Dxf << colour    << "\r\n";    // Colour Code
+		To_Dxf << 10        << "\r\n";    // XYZ is the Center point of circle
+		To_Dxf << x         << "\r\n";    // X in UCS (User Coordinate System)coordinates
+		To_Dxf << 20        << "\r\n";
+		To_Dxf << y         << "\r\n";    // Y in UCS (User Coordinate System)coordinates
+		To_Dxf << 30        << "\r\n";
+		To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
+		To_Dxf << 40        << "\r\n";
+		To_Dxf << radius    << "\r\n";    // radius of circle
+	}
 
-Createdxf::Createdxf()
+	/* line in DXF Format*/
+	void writeLine(QTextStream &To_Dxf, double x1, double y1, double x2, double y2, int colour)
+	{
+		// Draw the Line
+		To_Dxf << 0         << "\r\n";
+		To_Dxf << "LINE"    << "\r\n";
+		To_Dxf << 8         << "\r\n";
+		To_Dxf << 0         << "\r\n";    // Layer number (default layer in autocad)
+		To_Dxf << 62        << "\r\n";
+		To_Dxf << colour    << "\r\n";    // Colour Code
+		To_Dxf << 10        << "\r\n";
+		To_Dxf << x1        << "\r\n";    // X in UCS (User Coordinate System)coordinates
+		To_Dxf << 20        << "\r\n";
+		To_Dxf << y1        << "\r\n";    // Y in UCS (User Coordinate System)coordinates
+		To_Dxf << 30        << "\r\n";
+		To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
+		To_Dxf << 11        << "\r\n";
+		To_Dxf << x2        << "\r\n";    // X in UCS (User Coordinate System)coordinates
+		To_Dxf << 21        << "\r\n";
+		To_Dxf << y2        << "\r\n";    // Y in UCS (User Coordinate System)coordinates
+		To_Dxf << 31        << "\r\n";
+		To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
+	}
+
+	/* rectangle in dxf format */
+	void writeRectangle(QTextStream &To_Dxf, double x1, double y1, double width, double height, int colour)
+	{
+		// Draw the Rectangle
+		To_Dxf << 0         << "\r\n";
+		To_Dxf << "LINE"    << "\r\n";
+		To_Dxf << 8         << "\r\n";
+		To_Dxf << 0         << "\r\n";    // Layer number (default layer in autocad)
+		To_Dxf << 62        << "\r\n";
+		To_Dxf << colour    << "\r\n";    // Colour Code
+		To_Dxf << 10        << "\r\n";
+		To_Dxf << x1        << "\r\n";    // X in UCS (User Coordinate System)coordinates
+		To_Dxf << 20        << "\r\n";
+		To_Dxf << y1        << "\r\n";    // Y in UCS (User Coordinate System)coordinates
+		To_Dxf << 30        << "\r\n";
+		To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
+		To_Dxf << 11        << "\r\n";
+		To_Dxf << x1+width  << "\r\n";    // X in UCS (User Coordinate System)coordinates
+		To_Dxf << 21        << "\r\n";
+		To_Dxf << y1        << "\r\n";    // Y in UCS (User Coordinate System)coordinates
+		To_Dxf << 31        << "\r\n";
+		To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
+		To_Dxf << 0         << "\r\n";
+		To_Dxf << "LINE"    << "\r\n";
+		To_Dxf << 8         << "\r\n";
+		To_Dxf << 0         << "\r\n";    // Layer number (default layer in autocad)
+		To_Dxf << 62        << "\r\n";
+		To_Dxf << colour    << "\r\n";    // Colour Code
+		To_Dxf << 10        << "\r\n";
+		To_Dxf << x1        << "\r\n";    // X in UCS (User Coordinate System)coordinates
+		To_Dxf << 20        << "\r\n";
+		To_Dxf << y1        << "\r\n";    // Y in UCS (User Coordinate System)coordinates
+		To_Dxf << 30        << "\r\n";
+		To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
+		To_Dxf << 11        << "\r\n";
+		To_Dxf << x1        << "\r\n";    // X in UCS (User Coordinate System)coordinates
+		To_Dxf << 21        << "\r\n";
+		To_Dxf << y1+height << "\r\n";    // Y in UCS (User Coordinate System)coordinates
+		To_Dxf << 31        << "\r\n";
+		To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
+		To_Dxf << 0         << "\r\n";
+		To_Dxf << "LINE"    << "\r\n";
+		To_Dxf << 8         << "\r\n";
+		To_Dxf << 0         << "\r\n";    // Layer number (default layer in autocad)
+		To_Dxf << 62        << "\r\n";
+		To_Dxf << colour    << "\r\n";    // Colour Code
+		To_Dxf << 10        << "\r\n";
+		To_Dxf << x1+width  << "\r\n";    // X in UCS (User Coordinate System)coordinates
+		To_Dxf << 20        << "\r\n";
+		To_Dxf << y1        << "\r\n";    // Y in UCS (User Coordinate System)coordinates
+		To_Dxf << 30        << "\r\n";
+		To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
+		To_Dxf << 11        << "\r\n";
+		To_Dxf << x1+width  << "\r\n";    // X in UCS (User Coordinate System)coordinates
+		To_Dxf << 21        << "\r\n";
+		To_Dxf << y1+height << "\r\n";    // Y in UCS (User Coordinate System)coordinates
+		To_Dxf << 31        << "\r\n";
+		To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
+		To_Dxf << 0         << "\r\n";
+		To_Dxf << "LINE"    << "\r\n";
+		To_Dxf << 8         << "\r\n";
+		To_Dxf << 0         << "\r\n";    // Layer number (default layer in autocad)
+		To_Dxf << 62        << "\r\n";
+		To_Dxf << colour    << "\r\n";    // Colour Code
+		To_Dxf << 10        << "\r\n";
+		To_Dxf << x1        << "\r\n";    // X in UCS (User Coordinate System)coordinates
+		To_Dxf << 20        << "\r\n";
+		To_Dxf << y1+height << "\r\n";    // Y in UCS (User Coordinate System)coordinates
+		To_Dxf << 30        << "\r\n";
+		To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
+		To_Dxf << 11        << "\r\n";
+		To_Dxf << x1+width  << "\r\n";    // X in UCS (User Coordinate System)coordinates
+		To_Dxf << 21        << "\r\n";
+		To_Dxf << y1+height << "\r\n";    // Y in UCS (User Coordinate System)coordinates
+		To_Dxf << 31        << "\r\n";
+		To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
+	}
+
+	/* arc in dx format */
+	void writeArc(QTextStream &To_Dxf, double x, double y, double rad, double startAngle, double endAngle, int color)
+	{
+		// Draw the arc
+		To_Dxf << 0         << "\r\n";
+		To_Dxf << "ARC"     << "\r\n";
+		To_Dxf << 8         << "\r\n";
+		To_Dxf << 0         << "\r\n";    // Layer number (default layer in autocad)
+		To_Dxf << 62        << "\r\n";
+		To_Dxf << color     << "\r\n";    // Colour Code
+		To_Dxf << 10        << "\r\n";    // XYZ is the Center point of circle
+		To_Dxf << x         << "\r\n";    // X in UCS (User Coordinate System)coordinates
+		To_Dxf << 20        << "\r\n";
+		To_Dxf << y         << "\r\n";    // Y in UCS (User Coordinate System)coordinates
+		To_Dxf << 30        << "\r\n";
+		To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
+		To_Dxf << 40        << "\r\n";
+		To_Dxf << rad       << "\r\n";    // radius of arc
+		To_Dxf << 50        << "\r\n";
+		To_Dxf << startAngle<< "\r\n";    // start angle
+		To_Dxf << 51        << "\r\n";
+		To_Dxf << endAngle  << "\r\n";    // end angle
+	}
+
+	/* simple text in dxf format without any alignment specified */
+	void writeText(QTextStream &To_Dxf, const QString &text, double x, double y, double height, double rotation, int colour)
+	{
+		// Draw the circle
+		To_Dxf << 0         << "\r\n";
+		To_Dxf << "TEXT"    << "\r\n";
+		To_Dxf << 8         << "\r\n";
+		To_Dxf << 0         << "\r\n";    // Layer number (default layer in autocad)
+		To_Dxf << 62        << "\r\n";
+		To_Dxf << colour    << "\r\n";    // Colour Code
+		To_Dxf << 10        << "\r\n";    // XYZ
+		To_Dxf << x         << "\r\n";    // X in UCS (User Coordinate System)coordinates
+		To_Dxf << 20        << "\r\n";
+		To_Dxf << y         << "\r\n";    // Y in UCS (User Coordinate System)coordinates
+		To_Dxf << 30        << "\r\n";
+		To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
+		To_Dxf << 40        << "\r\n";
+		To_Dxf << height    << "\r\n";    // Text Height
+		To_Dxf << 1         << "\r\n";
+		To_Dxf << text      << "\r\n";    // Text Value
+		To_Dxf << 50        << "\r\n";
+		To_Dxf << rotation  << "\r\n";    // Text Rotation
+	}
+
+	/* aligned text in DXF Format */
+	// leftAlign flag added. If the alignment requested is 'fit to width' and the text length is very small,
+	// then the text is either centered or left-aligned, depnding on the value of leftAlign.
+	void writeTextAligned(QTextStream &To_Dxf, const QString &text, double x, double y, double height, double rotation, double oblique,
+						  int hAlign, int vAlign, double xAlign, int colour, bool leftAlign)
+	{
+		// Draw the circle
+		To_Dxf << 0         << "\r\n";
+		To_Dxf << "TEXT"    << "\r\n";
+		To_Dxf << 8         << "\r\n";
+		To_Dxf << 0         << "\r\n";    // Layer number (default layer in autocad)
+		To_Dxf << 62        << "\r\n";
+		To_Dxf << colour    << "\r\n";    // Colour Code
+		To_Dxf << 10        << "\r\n";    // XYZ
+		To_Dxf << x         << "\r\n";    // X in UCS (User Coordinate System)coordinates
+		To_Dxf << 20        << "\r\n";
+		To_Dxf << y         << "\r\n";    // Y in UCS (User Coordinate System)coordinates
+		To_Dxf << 30        << "\r\n";
+		To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
+		To_Dxf << 40        << "\r\n";
+		To_Dxf << height    << "\r\n";    // Text Height
+		To_Dxf << 1         << "\r\n";
+		To_Dxf << text      << "\r\n";    // Text Value
+		To_Dxf << 50        << "\r\n";
+		To_Dxf << rotation  << "\r\n";    // Text Rotation
+		// If "Fit to width", then check if width of text < width specified then change it "center align or left align"
+		if (hAlign == 5) {
+			int xDiff = xAlign - x;
+			if (text.length() < xDiff/height && !leftAlign) {
+				hAlign = 1;
+				xAlign = (x+xAlign) / 2;
+			} else if (text.length() < xDiff/height && leftAlign) {
+				return;
+			}
+		}
+
+		To_Dxf << 51        << "\r\n";
+		To_Dxf << oblique   << "\r\n";    // Text Obliqueness
+		To_Dxf << 72        << "\r\n";
+		To_Dxf << hAlign    << "\r\n";    // Text Horizontal Alignment
+		To_Dxf << 73        << "\r\n";
+		To_Dxf << vAlign    << "\r\n";    // Text Vertical Alignment
+
+		if ((hAlign) || (vAlign)) { // Enter Second Point
+			To_Dxf << 11       << "\r\n"; // XYZ
+			To_Dxf << xAlign   << "\r\n"; // X in UCS (User Coordinate System)coordinates
+			To_Dxf << 21       << "\r\n";
+			To_Dxf << y        << "\r\n"; // Y in UCS (User Coordinate System)coordinates
+			To_Dxf << 31       << "\r\n";
+			To_Dxf << 0.0      << "\r\n"; // Z in UCS (User Coordinate System)coordinates
+		}
+	}
+}
+
+/**
+ * @brief Createdxf::Createdxf
+ * Build an empty dxf drawing. The drawing is only a list of primitives,
+ * the dxf code is formatted and written to a file by write().
+ * @param x_scale : scale applied to the x coordinates by the conveniance functions
+ * @param y_scale : scale applied to the y coordinates by the conveniance functions
+ */
+Createdxf::Createdxf(double x_scale, double y_scale) :
+	m_x_scale(x_scale),
+	m_y_scale(y_scale)
 {
 }
 
@@ -38,289 +449,102 @@ Createdxf::~Createdxf()
 {
 }
 
-/* Header section of every DXF file.*/
-void  Createdxf::dxfBegin (const QString& fileName)
+/**
+ * @brief Createdxf::write
+ * Format the drawing in dxf and write it in the file @file_path.
+ * Only the data of this drawing is used, so several drawings can be written
+ * at the same time from the threads of the thread pool.
+ * @param file_path
+ * @param error_message : if not nullptr, filled with the reason of the failure
+ * @return true if the file was written
+ */
+bool Createdxf::write(const QString &file_path, QString *error_message) const
 {
+	QFile file(file_path);
+	if (!file.open(QFile::WriteOnly)) {
+		if (error_message) {
+			*error_message = file_path + " : " + file.errorString();
+		}
+		return false;
+	}
+
+	QTextStream To_Dxf(&file);
+	writeHeader(To_Dxf);
+	for (const Primitive &p : m_primitives)
+	{
+		switch (p.type)
+		{
+			case Primitive::Circle:
+				writeCircle(To_Dxf, p.values[2], p.values[0], p.values[1], p.colour);
+				break;
+			case Primitive::Line:
+				writeLine(To_Dxf, p.values[0], p.values[1], p.values[2], p.values[3], p.colour);
+				break;
+			case Primitive::Rectangle:
+				writeRectangle(To_Dxf, p.values[0], p.values[1], p.values[2], p.values[3], p.colour);
+				break;
+			case Primitive::Arc:
+				writeArc(To_Dxf, p.values[0], p.values[1], p.values[2], p.values[3], p.values[4], p.colour);
+				break;
+			case Primitive::Text:
+				writeText(To_Dxf, p.text, p.values[0], p.values[1], p.values[2], p.values[3], p.colour);
+				break;
+			case Primitive::TextAligned:
+				writeTextAligned(To_Dxf, p.text, p.values[0], p.values[1], p.values[2], p.values[3], p.values[4],
+								 p.h_align, p.v_align, p.values[5], p.colour, p.left_align);
+				break;
+		}
+	}
+	writeFooter(To_Dxf);
+	To_Dxf.flush();
+	file.close();
 
-    // Creation of an output stream object in text mode.
-    // Header section of every dxf file.
-    if (!fileName.isEmpty()) {
-        QFile file(fileName);
-        if (!file.open(QFile::WriteOnly)) {
-            // error message
-            QMessageBox errorFileOpen;
-             errorFileOpen.setIcon(QMessageBox::Warning);
-             errorFileOpen.setText("Error: "+fileName+" Could Not be Opened.");
-             errorFileOpen.setInformativeText("Close all Files and Try Again.");
-             errorFileOpen.exec();
-             exit(0);
-        } else {
-            QTextStream To_Dxf(&file);
-            To_Dxf << 999           << "\r\n";
-            To_Dxf << "QET"         << "\r\n";
-            To_Dxf << 0             << "\r\n";
-            To_Dxf << "SECTION"     << "\r\n";
-            To_Dxf << 2             << "\r\n";
-            To_Dxf << "HEADER"      << "\r\n";
-            To_Dxf << 9             << "\r\n";
-            To_Dxf << "$ACADVER"    << "\r\n";
-            To_Dxf << 1             << "\r\n";
-            To_Dxf << "AC1006"      << "\r\n";
-            To_Dxf << 9             << "\r\n";
-            To_Dxf << "$INSBASE"    << "\r\n";
-            To_Dxf << 10            << "\r\n";
-            To_Dxf << "0.0"         << "\r\n";
-            To_Dxf << 20            << "\r\n";
-            To_Dxf << "0.0"         << "\r\n";
-            To_Dxf << 30            << "\r\n";
-            To_Dxf << "0.0"         << "\r\n";
-            To_Dxf << 9             << "\r\n";
-
-            To_Dxf << "$EXTMIN"     << "\r\n";
-            To_Dxf << 10            << "\r\n";
-            To_Dxf << "0.0"         << "\r\n";
-            To_Dxf << 20            << "\r\n";
-            To_Dxf << "0.0"         << "\r\n";
-            To_Dxf << 9             << "\r\n";
-            To_Dxf << "$EXTMAX"     << "\r\n";
-            To_Dxf << 10            << "\r\n";
-            To_Dxf << "4000.0"      << "\r\n";
-            To_Dxf << 20            << "\r\n";
-            To_Dxf << "4000.0"      << "\r\n";
-
-            To_Dxf << 9             << "\r\n";
-            To_Dxf << "$LIMMIN"     << "\r\n";
-            To_Dxf << 10            << "\r\n";
-            To_Dxf << "0.0"         << "\r\n";
-            To_Dxf << 20            << "\r\n";
-            To_Dxf << "0.0"         << "\r\n";
-            To_Dxf << 9             << "\r\n";
-            To_Dxf << "$LIMMAX"     << "\r\n";
-            To_Dxf << 10            << "\r\n";
-            To_Dxf << "4000.0"      << "\r\n";
-            To_Dxf << 20            << "\r\n";
-            To_Dxf << "4000.0"      << "\r\n";
-            To_Dxf << 0             << "\r\n";
-            To_Dxf << "ENDSEC"      << "\r\n";
-            To_Dxf << 0             << "\r\n";
-            To_Dxf << "SECTION"     << "\r\n";
-            To_Dxf << 2             << "\r\n";
-            To_Dxf << "TABLES"      << "\r\n";
-            To_Dxf << 0             << "\r\n";
-            To_Dxf << "TABLE"       << "\r\n";
-            To_Dxf << 2             << "\r\n";
-
-            To_Dxf << "VPORT"       << "\r\n";
-            To_Dxf << 70            << "\r\n";
-            To_Dxf << 1             << "\r\n";
-            To_Dxf << 0             << "\r\n";
-            To_Dxf << "VPORT"       << "\r\n";
-            To_Dxf << 2             << "\r\n";
-            To_Dxf << "*ACTIVE"     << "\r\n";
-            To_Dxf << 70            << "\r\n";
-            To_Dxf << 0             << "\r\n";
-            To_Dxf << 10            << "\r\n";
-            To_Dxf << 0.0           << "\r\n";
-            To_Dxf << 20            << "\r\n";
-            To_Dxf << 0.0           << "\r\n";
-            To_Dxf << 11            << "\r\n";
-            To_Dxf << 1.0           << "\r\n";
-            To_Dxf << 21            << "\r\n";
-            To_Dxf << 1.0           << "\r\n";
-            To_Dxf << 12            << "\r\n";
-            To_Dxf << 2000          << "\r\n";
-            To_Dxf << 22            << "\r\n";
-            To_Dxf << 1350          << "\r\n";
-            To_Dxf << 13            << "\r\n";
-            To_Dxf << 0.0           << "\r\n";
-            To_Dxf << 23            << "\r\n";
-            To_Dxf << 0.0           << "\r\n";
-            To_Dxf << 14            << "\r\n";
-            To_Dxf << 1.0           << "\r\n";
-            To_Dxf << 24            << "\r\n";
-            To_Dxf << 1.0           << "\r\n";
-            To_Dxf << 15            << "\r\n";
-            To_Dxf << 0.0           << "\r\n";
-            To_Dxf << 25            << "\r\n";
-            To_Dxf << 0.0           << "\r\n";
-            To_Dxf << 16            << "\r\n";
-            To_Dxf << 0.0           << "\r\n";
-            To_Dxf << 26            << "\r\n";
-            To_Dxf << 0.0           << "\r\n";
-            To_Dxf << 36            << "\r\n";
-            To_Dxf << 1.0           << "\r\n";
-            To_Dxf << 17            << "\r\n";
-            To_Dxf << 0.0           << "\r\n";
-            To_Dxf << 27            << "\r\n";
-            To_Dxf << 0.0           << "\r\n";
-            To_Dxf << 37            << "\r\n";
-            To_Dxf << 0.0           << "\r\n";
-            To_Dxf << 40            << "\r\n";
-            To_Dxf << 2732.5        << "\r\n";
-            To_Dxf << 41            << "\r\n";
-            To_Dxf << 2.558         << "\r\n";
-            To_Dxf << 42            << "\r\n";
-            To_Dxf << 50.0          << "\r\n";
-            To_Dxf << 43            << "\r\n";
-            To_Dxf << 0.0           << "\r\n";
-            To_Dxf << 44            << "\r\n";
-            To_Dxf << 0.0           << "\r\n";
-            To_Dxf << 50            << "\r\n";
-            To_Dxf << 0.0           << "\r\n";
-            To_Dxf << 51            << "\r\n";
-            To_Dxf << 0.0           << "\r\n";
-            To_Dxf << 71            << "\r\n";
-            To_Dxf << 0             << "\r\n";
-            To_Dxf << 72            << "\r\n";
-            To_Dxf << 100           << "\r\n";
-            To_Dxf << 73            << "\r\n";
-            To_Dxf << 1             << "\r\n";
-            To_Dxf << 74            << "\r\n";
-            To_Dxf << 1             << "\r\n";
-            To_Dxf << 75            << "\r\n";
-            To_Dxf << 0             << "\r\n";
-            To_Dxf << 76            << "\r\n";
-            To_Dxf << 0             << "\r\n";
-            To_Dxf << 77            << "\r\n";
-            To_Dxf << 0             << "\r\n";
-            To_Dxf << 78            << "\r\n";
-            To_Dxf << 0             << "\r\n";
-            To_Dxf << 0             << "\r\n";
-            To_Dxf << "ENDTAB"      << "\r\n";
-            To_Dxf << 0             << "\r\n";
-            To_Dxf << "TABLE"       << "\r\n";
-            To_Dxf << 2             << "\r\n";
-
-            To_Dxf << "LTYPE"       << "\r\n";
-            To_Dxf << 70            << "\r\n";
-            To_Dxf << 1             << "\r\n";
-            To_Dxf << 0             << "\r\n";
-            To_Dxf << "LTYPE"       << "\r\n";
-            To_Dxf << 2             << "\r\n";
-            To_Dxf << "CONTINUOUS"  << "\r\n";
-            To_Dxf << 70            << "\r\n";
-            To_Dxf << 64            << "\r\n";
-            To_Dxf << 3             << "\r\n";
-            To_Dxf << "Solid Line"  << "\r\n";
-            To_Dxf << 72            << "\r\n";
-            To_Dxf << 65            << "\r\n";
-            To_Dxf << 73            << "\r\n";
-            To_Dxf << 0             << "\r\n";
-            To_Dxf << 40            << "\r\n";
-            To_Dxf << 0.00          << "\r\n";
-            To_Dxf << 0             << "\r\n";
-
-            To_Dxf << "ENDTAB"      << "\r\n";
-            To_Dxf << 0             << "\r\n";
-            To_Dxf << "ENDSEC"      << "\r\n";
-            To_Dxf << 0             << "\r\n";
-            To_Dxf << "SECTION"     << "\r\n";
-            To_Dxf << 2             << "\r\n";
-            To_Dxf << "BLOCKS"      << "\r\n";
-            To_Dxf << 0             << "\r\n";
-            To_Dxf << "ENDSEC"      << "\r\n";
-            To_Dxf << 0             << "\r\n";
-            To_Dxf << "SECTION"     << "\r\n";
-            To_Dxf << 2             << "\r\n";
-            To_Dxf << "ENTITIES"    << "\r\n";
-            file.close();
-        }
-    }
+	if (file.error() != QFileDevice::NoError) {
+		if (error_message) {
+			*error_message = file_path + " : " + file.errorString();
+		}
+		return false;
+	}
+	return true;
 }
 
-/* End Section of every DXF File*/
-void  Createdxf::dxfEnd (const QString& fileName)
+/**
+ * @brief Createdxf::memorySize
+ * @return an estimation of the memory used by the primitives of this drawing
+ */
+qint64 Createdxf::memorySize() const
 {
-    // Creation of an output stream object in text mode.
-    if (!fileName.isEmpty()) {
-        QFile file(fileName);
-        if (!file.open(QFile::Append)) {
-            // error message
-            QMessageBox errorFileOpen;
-             errorFileOpen.setText("Error: File "+fileName+" was not written correctly.");
-             errorFileOpen.setInformativeText("Close all Files and Re-Run");
-             errorFileOpen.exec();
-        } else {
-            QTextStream To_Dxf(&file);
-            To_Dxf << 0             << "\r\n";
-            To_Dxf << "ENDSEC"      << "\r\n";
-            To_Dxf << 0             << "\r\n";
-            To_Dxf << "EOF";
-            file.close();
-        }
-    }
+	qint64 size = sizeof(Createdxf) + qint64(m_primitives.capacity()) * qint64(sizeof(Primitive));
+	for (const Primitive &p : m_primitives) {
+		size += qint64(p.text.capacity()) * qint64(sizeof(QChar));
+	}
+	return size;
 }
 
-
 /* draw circle in dxf format*/
-void Createdxf::drawCircle (const QString& fileName, double radius, double x, double y, int colour)
+void Createdxf::drawCircle (double radius, double x, double y, int colour)
 {
-    if (!fileName.isEmpty()) {
-        QFile file(fileName);
-        if (!file.open(QFile::Append)) {
-            // error message
-            QMessageBox errorFileOpen;
-            errorFileOpen.setText("Error: File "+fileName+" was not written correctly.");
-            errorFileOpen.setInformativeText("Close all Files and Re-Run");
-            errorFileOpen.exec();
-        } else {
-            QTextStream To_Dxf(&file);
-            // Draw the circle
-            To_Dxf << 0         << "\r\n";
-            To_Dxf << "CIRCLE"  << "\r\n";
-            To_Dxf << 8         << "\r\n";
-            To_Dxf << 0         << "\r\n";    // Layer number (default layer in autocad)
-            To_Dxf << 62        << "\r\n";
-            To_Dxf << colour    << "\r\n";    // Colour Code
-            To_Dxf << 10        << "\r\n";    // XYZ is the Center point of circle
-            To_Dxf << x         << "\r\n";    // X in UCS (User Coordinate System)coordinates
-            To_Dxf << 20        << "\r\n";
-            To_Dxf << y         << "\r\n";    // Y in UCS (User Coordinate System)coordinates
-            To_Dxf << 30        << "\r\n";
-            To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
-            To_Dxf << 40        << "\r\n";
-            To_Dxf << radius    << "\r\n";    // radius of circle
-            file.close();
-        }
-    }
+	Primitive p;
+	p.type = Primitive::Circle;
+	p.colour = colour;
+	p.values[0] = x;
+	p.values[1] = y;
+	p.values[2] = radius;
+	m_primitives.append(p);
 }
 
 
 /* draw line in DXF Format*/
-void Createdxf::drawLine (const QString &fileName, double x1, double y1, double x2, double y2,const int &colour)
+void Createdxf::drawLine (double x1, double y1, double x2, double y2,const int &colour)
 {
-    if (!fileName.isEmpty()) {
-        QFile file(fileName);
-        if (!file.open(QFile::Append)) {
-            // error message
-            QMessageBox errorFileOpen;
-            errorFileOpen.setText("Error: File "+fileName+" was not written correctly.");
-            errorFileOpen.setInformativeText("Close all Files and Re-Run");
-            errorFileOpen.exec();
-        } else {
-            QTextStream To_Dxf(&file);
-            // Draw the Line
-            To_Dxf << 0         << "\r\n";
-            To_Dxf << "LINE"    << "\r\n";
-            To_Dxf << 8         << "\r\n";
-            To_Dxf << 0         << "\r\n";    // Layer number (default layer in autocad)
-            To_Dxf << 62        << "\r\n";
-            To_Dxf << colour    << "\r\n";    // Colour Code
-            To_Dxf << 10        << "\r\n";
-            To_Dxf << x1        << "\r\n";    // X in UCS (User Coordinate System)coordinates
-            To_Dxf << 20        << "\r\n";
-            To_Dxf << y1        << "\r\n";    // Y in UCS (User Coordinate System)coordinates
-            To_Dxf << 30        << "\r\n";
-            To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
-            To_Dxf << 11        << "\r\n";
-            To_Dxf << x2        << "\r\n";    // X in UCS (User Coordinate System)coordinates
-            To_Dxf << 21        << "\r\n";
-            To_Dxf << y2        << "\r\n";    // Y in UCS (User Coordinate System)coordinates
-            To_Dxf << 31        << "\r\n";
-            To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
-            file.close();
-        }
-    }
+	Primitive p;
+	p.type = Primitive::Line;
+	p.colour = colour;
+	p.values[0] = x1;
+	p.values[1] = y1;
+	p.values[2] = x2;
+	p.values[3] = y2;
+	m_primitives.append(p);
 }
 
 long Createdxf::RGBcodeTable[255]{
@@ -411,19 +635,18 @@ int Createdxf::getcolorCode (const long red, const long green, const long blue)
 /**
  * @brief Createdxf::drawLine
  * Conveniance function to draw line
- * @param filepath
  * @param line
  * @param colorcode
  */
-void Createdxf::drawLine(const QString &filepath, const QLineF &line, const int &colorcode) {
-	drawLine(filepath, line.p1().x() * xScale,
-					   sheetHeight - (line.p1().y() * yScale),
-					   line.p2().x() * xScale,
-					   sheetHeight - (line.p2().y() * yScale),
-					   colorcode);
+void Createdxf::drawLine(const QLineF &line, const int &colorcode) {
+	drawLine(line.p1().x() * m_x_scale,
+			 sheetHeight - (line.p1().y() * m_y_scale),
+			 line.p2().x() * m_x_scale,
+			 sheetHeight - (line.p2().y() * m_y_scale),
+			 colorcode);
 }
 
-void Createdxf::drawArcEllipse(const QString &file_path, qreal x, qreal y, qreal w, qreal h, qreal startAngle, qreal spanAngle, qreal hotspot_x, qreal hotspot_y, qreal rotation_angle, const int &colorcode) {
+void Createdxf::drawArcEllipse(qreal x, qreal y, qreal w, qreal h, qreal startAngle, qreal spanAngle, qreal hotspot_x, qreal hotspot_y, qreal rotation_angle, const int &colorcode) {
 	// vector of parts of arc (stored as a pair of startAngle and spanAngle) for each quadrant.
 	QVector< QPair<qreal,qreal> > arc_parts_vector;
 
@@ -542,270 +765,99 @@ void Createdxf::drawArcEllipse(const QString &file_path, qreal x, qreal y, qreal
 		arc_endAngle -= rotation_angle;
 		arc_startAngle -= rotation_angle;
 
-		drawArc(file_path, center_x, center_y, radius, arc_startAngle, arc_endAngle, colorcode);
+		drawArc(center_x, center_y, radius, arc_startAngle, arc_endAngle, colorcode);
 	}
 }
 
 /**
  * @brief Createdxf::drawEllipse
  * Conveniance function for draw ellipse
- * @param filepath
  * @param rect
  * @param colorcode
  */
-void Createdxf::drawEllipse(const QString &filepath, const QRectF &rect, const int &colorcode) {
-	drawArcEllipse(filepath, rect.topLeft().x() * xScale,
-						  sheetHeight - (rect.topLeft().y() * yScale),
-						  rect.width() * xScale,
-						  rect.height() * yScale,
-						  0, 360, 0, 0, 0, colorcode);
+void Createdxf::drawEllipse(const QRectF &rect, const int &colorcode) {
+	drawArcEllipse(rect.topLeft().x() * m_x_scale,
+				   sheetHeight - (rect.topLeft().y() * m_y_scale),
+				   rect.width() * m_x_scale,
+				   rect.height() * m_y_scale,
+				   0, 360, 0, 0, 0, colorcode);
 }
 
 /* draw rectangle in dxf format */
-void Createdxf::drawRectangle (const QString &fileName, double x1, double y1, double width, double height, const int &colour)
+void Createdxf::drawRectangle (double x1, double y1, double width, double height, const int &colour)
 {
-    if (!fileName.isEmpty()) {
-        QFile file(fileName);
-        if (!file.open(QFile::Append)) {
-            // error message
-            QMessageBox errorFileOpen;
-            errorFileOpen.setText("Error: File "+fileName+" was not written correctly.");
-            errorFileOpen.setInformativeText("Close all Files and Re-Run");
-            errorFileOpen.exec();
-        } else {
-            QTextStream To_Dxf(&file);
-            // Draw the Rectangle
-            To_Dxf << 0         << "\r\n";
-            To_Dxf << "LINE"    << "\r\n";
-            To_Dxf << 8         << "\r\n";
-            To_Dxf << 0         << "\r\n";    // Layer number (default layer in autocad)
-            To_Dxf << 62        << "\r\n";
-            To_Dxf << colour    << "\r\n";    // Colour Code
-            To_Dxf << 10        << "\r\n";
-            To_Dxf << x1        << "\r\n";    // X in UCS (User Coordinate System)coordinates
-            To_Dxf << 20        << "\r\n";
-            To_Dxf << y1        << "\r\n";    // Y in UCS (User Coordinate System)coordinates
-            To_Dxf << 30        << "\r\n";
-            To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
-            To_Dxf << 11        << "\r\n";
-            To_Dxf << x1+width  << "\r\n";    // X in UCS (User Coordinate System)coordinates
-            To_Dxf << 21        << "\r\n";
-            To_Dxf << y1        << "\r\n";    // Y in UCS (User Coordinate System)coordinates
-            To_Dxf << 31        << "\r\n";
-            To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
-            To_Dxf << 0         << "\r\n";
-            To_Dxf << "LINE"    << "\r\n";
-            To_Dxf << 8         << "\r\n";
-            To_Dxf << 0         << "\r\n";    // Layer number (default layer in autocad)
-            To_Dxf << 62        << "\r\n";
-            To_Dxf << colour    << "\r\n";    // Colour Code
-            To_Dxf << 10        << "\r\n";
-            To_Dxf << x1        << "\r\n";    // X in UCS (User Coordinate System)coordinates
-            To_Dxf << 20        << "\r\n";
-            To_Dxf << y1        << "\r\n";    // Y in UCS (User Coordinate System)coordinates
-            To_Dxf << 30        << "\r\n";
-            To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
-            To_Dxf << 11        << "\r\n";
-            To_Dxf << x1        << "\r\n";    // X in UCS (User Coordinate System)coordinates
-            To_Dxf << 21        << "\r\n";
-            To_Dxf << y1+height << "\r\n";    // Y in UCS (User Coordinate System)coordinates
-            To_Dxf << 31        << "\r\n";
-            To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
-            To_Dxf << 0         << "\r\n";
-            To_Dxf << "LINE"    << "\r\n";
-            To_Dxf << 8         << "\r\n";
-            To_Dxf << 0         << "\r\n";    // Layer number (default layer in autocad)
-            To_Dxf << 62        << "\r\n";
-            To_Dxf << colour    << "\r\n";    // Colour Code
-            To_Dxf << 10        << "\r\n";
-            To_Dxf << x1+width  << "\r\n";    // X in UCS (User Coordinate System)coordinates
-            To_Dxf << 20        << "\r\n";
-            To_Dxf << y1        << "\r\n";    // Y in UCS (User Coordinate System)coordinates
-            To_Dxf << 30        << "\r\n";
-            To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
-            To_Dxf << 11        << "\r\n";
-            To_Dxf << x1+width  << "\r\n";    // X in UCS (User Coordinate System)coordinates
-            To_Dxf << 21        << "\r\n";
-            To_Dxf << y1+height << "\r\n";    // Y in UCS (User Coordinate System)coordinates
-            To_Dxf << 31        << "\r\n";
-            To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
-            To_Dxf << 0         << "\r\n";
-            To_Dxf << "LINE"    << "\r\n";
-            To_Dxf << 8         << "\r\n";
-            To_Dxf << 0         << "\r\n";    // Layer number (default layer in autocad)
-            To_Dxf << 62        << "\r\n";
-            To_Dxf << colour    << "\r\n";    // Colour Code
-            To_Dxf << 10        << "\r\n";
-            To_Dxf << x1        << "\r\n";    // X in UCS (User Coordinate System)coordinates
-            To_Dxf << 20        << "\r\n";
-            To_Dxf << y1+height << "\r\n";    // Y in UCS (User Coordinate System)coordinates
-            To_Dxf << 30        << "\r\n";
-            To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
-            To_Dxf << 11        << "\r\n";
-            To_Dxf << x1+width  << "\r\n";    // X in UCS (User Coordinate System)coordinates
-            To_Dxf << 21        << "\r\n";
-            To_Dxf << y1+height << "\r\n";    // Y in UCS (User Coordinate System)coordinates
-            To_Dxf << 31        << "\r\n";
-            To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
-            file.close();
-        }
-    }
+	Primitive p;
+	p.type = Primitive::Rectangle;
+	p.colour = colour;
+	p.values[0] = x1;
+	p.values[1] = y1;
+	p.values[2] = width;
+	p.values[3] = height;
+	m_primitives.append(p);
 }
 
 /**
  * @brief Createdxf::drawRectangle
  * Conveniance function for draw rectangle
- * @param filepath
  * @param rect
  * @param color
  */
-void Createdxf::drawRectangle(const QString &filepath, const QRectF &rect, const int &colorcode) {
-	drawRectangle(filepath, rect.bottomLeft().x() * xScale,
-							sheetHeight - (rect.bottomLeft().y() * yScale),
-							rect.width() * xScale,
-							rect.height() * yScale,
-							colorcode);
+void Createdxf::drawRectangle(const QRectF &rect, const int &colorcode) {
+	drawRectangle(rect.bottomLeft().x() * m_x_scale,
+				  sheetHeight - (rect.bottomLeft().y() * m_y_scale),
+				  rect.width() * m_x_scale,
+				  rect.height() * m_y_scale,
+				  colorcode);
 }
 
 /* draw arc in dx format */
-void Createdxf::drawArc(const QString& fileName,double x,double y,double rad,double startAngle,double endAngle,int color)
+void Createdxf::drawArc(double x,double y,double rad,double startAngle,double endAngle,int color)
 {
-    if (!fileName.isEmpty()) {
-        QFile file(fileName);
-        if (!file.open(QFile::Append)) {
-            // error message
-            QMessageBox errorFileOpen;
-            errorFileOpen.setText("Error: File "+fileName+" was not written correctly.");
-            errorFileOpen.setInformativeText("Close all Files and Re-Run");
-            errorFileOpen.exec();
-        } else {
-            QTextStream To_Dxf(&file);
-            // Draw the arc
-            To_Dxf << 0         << "\r\n";
-            To_Dxf << "ARC"     << "\r\n";
-            To_Dxf << 8         << "\r\n";
-            To_Dxf << 0         << "\r\n";    // Layer number (default layer in autocad)
-            To_Dxf << 62        << "\r\n";
-            To_Dxf << color     << "\r\n";    // Colour Code
-            To_Dxf << 10        << "\r\n";    // XYZ is the Center point of circle
-            To_Dxf << x         << "\r\n";    // X in UCS (User Coordinate System)coordinates
-            To_Dxf << 20        << "\r\n";
-            To_Dxf << y         << "\r\n";    // Y in UCS (User Coordinate System)coordinates
-            To_Dxf << 30        << "\r\n";
-            To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
-            To_Dxf << 40        << "\r\n";
-            To_Dxf << rad       << "\r\n";    // radius of arc
-            To_Dxf << 50        << "\r\n";
-            To_Dxf << startAngle<< "\r\n";    // start angle
-            To_Dxf << 51        << "\r\n";
-            To_Dxf << endAngle  << "\r\n";    // end angle
-            file.close();
-        }
-    }
+	Primitive p;
+	p.type = Primitive::Arc;
+	p.colour = color;
+	p.values[0] = x;
+	p.values[1] = y;
+	p.values[2] = rad;
+	p.values[3] = startAngle;
+	p.values[4] = endAngle;
+	m_primitives.append(p);
 }
 
 /* draw simple text in dxf format without any alignment specified */
-void Createdxf::drawText(const QString& fileName, const QString& text,double x, double y, double height, double rotation, int colour)
+void Createdxf::drawText(const QString& text,double x, double y, double height, double rotation, int colour)
 {
-    if (!fileName.isEmpty()) {
-        QFile file(fileName);
-        if (!file.open(QFile::Append)) {
-            // error message
-            QMessageBox errorFileOpen;
-            errorFileOpen.setText("Error: File "+fileName+" was not written correctly.");
-            errorFileOpen.setInformativeText("Close all Files and Re-Run");
-            errorFileOpen.exec();
-        } else {
-            QTextStream To_Dxf(&file);
-            // Draw the circle
-            To_Dxf << 0         << "\r\n";
-            To_Dxf << "TEXT"    << "\r\n";
-            To_Dxf << 8         << "\r\n";
-            To_Dxf << 0         << "\r\n";    // Layer number (default layer in autocad)
-            To_Dxf << 62        << "\r\n";
-            To_Dxf << colour    << "\r\n";    // Colour Code
-            To_Dxf << 10        << "\r\n";    // XYZ
-            To_Dxf << x         << "\r\n";    // X in UCS (User Coordinate System)coordinates
-            To_Dxf << 20        << "\r\n";
-            To_Dxf << y         << "\r\n";    // Y in UCS (User Coordinate System)coordinates
-            To_Dxf << 30        << "\r\n";
-            To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
-            To_Dxf << 40        << "\r\n";
-            To_Dxf << height    << "\r\n";    // Text Height
-            To_Dxf << 1         << "\r\n";
-            To_Dxf << text      << "\r\n";    // Text Value
-            To_Dxf << 50        << "\r\n";
-            To_Dxf << rotation  << "\r\n";    // Text Rotation
-            file.close();
-        }
-    }
+	Primitive p;
+	p.type = Primitive::Text;
+	p.colour = colour;
+	p.text = text;
+	p.values[0] = x;
+	p.values[1] = y;
+	p.values[2] = height;
+	p.values[3] = rotation;
+	m_primitives.append(p);
 }
 
 /* draw aligned text in DXF Format */
 // leftAlign flag added. If the alignment requested is 'fit to width' and the text length is very small,
 // then the text is either centered or left-aligned, depnding on the value of leftAlign.
-void Createdxf::drawTextAligned(const QString& fileName, const QString& text,double x, double y, double height, double rotation, double oblique,int hAlign, int vAlign, double xAlign,int colour,
+void Createdxf::drawTextAligned(const QString& text,double x, double y, double height, double rotation, double oblique,int hAlign, int vAlign, double xAlign,int colour,
 							bool leftAlign, float scale)
 {
 	Q_UNUSED(scale);
 
-    if (!fileName.isEmpty()) {
-        QFile file(fileName);
-        if (!file.open(QFile::Append)) {
-            // error message
-            QMessageBox errorFileOpen;
-            errorFileOpen.setText("Error: File "+fileName+" was not written correctly.");
-            errorFileOpen.setInformativeText("Close all Files and Re-Run");
-            errorFileOpen.exec();
-        } else {
-            QTextStream To_Dxf(&file);
-            // Draw the circle
-            To_Dxf << 0         << "\r\n";
-            To_Dxf << "TEXT"    << "\r\n";
-            To_Dxf << 8         << "\r\n";
-            To_Dxf << 0         << "\r\n";    // Layer number (default layer in autocad)
-            To_Dxf << 62        << "\r\n";
-            To_Dxf << colour    << "\r\n";    // Colour Code
-            To_Dxf << 10        << "\r\n";    // XYZ
-            To_Dxf << x         << "\r\n";    // X in UCS (User Coordinate System)coordinates
-            To_Dxf << 20        << "\r\n";
-            To_Dxf << y         << "\r\n";    // Y in UCS (User Coordinate System)coordinates
-            To_Dxf << 30        << "\r\n";
-            To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
-            To_Dxf << 40        << "\r\n";
-            To_Dxf << height    << "\r\n";    // Text Height
-            To_Dxf << 1         << "\r\n";
-            To_Dxf << text      << "\r\n";    // Text Value
-            To_Dxf << 50        << "\r\n";
-            To_Dxf << rotation  << "\r\n";    // Text Rotation
-			// If "Fit to width", then check if width of text < width specified then change it "center align or left align"
-			if (hAlign == 5) {
-				int xDiff = xAlign - x;
-				if (text.length() < xDiff/height && !leftAlign) {
-					hAlign = 1;
-					xAlign = (x+xAlign) / 2;
-				} else if (text.length() < xDiff/height && leftAlign) {
-					file.close();
-					return;
-				}
-			}
-
-            To_Dxf << 51        << "\r\n";
-            To_Dxf << oblique   << "\r\n";    // Text Obliqueness
-            To_Dxf << 72        << "\r\n";            
-            To_Dxf << hAlign    << "\r\n";    // Text Horizontal Alignment
-            To_Dxf << 73        << "\r\n";
-            To_Dxf << vAlign    << "\r\n";    // Text Vertical Alignment
-
-            if ((hAlign) || (vAlign)) { // Enter Second Point
-                To_Dxf << 11       << "\r\n"; // XYZ
-                To_Dxf << xAlign   << "\r\n"; // X in UCS (User Coordinate System)coordinates
-                To_Dxf << 21       << "\r\n";
-                To_Dxf << y        << "\r\n"; // Y in UCS (User Coordinate System)coordinates
-                To_Dxf << 31       << "\r\n";
-                To_Dxf << 0.0      << "\r\n"; // Z in UCS (User Coordinate System)coordinates
-            }
-            file.close();
-        }
-    }
+	Primitive p;
+	p.type = Primitive::TextAligned;
+	p.colour = colour;
+	p.text = text;
+	p.values[0] = x;
+	p.values[1] = y;
+	p.values[2] = height;
+	p.values[3] = rotation;
+	p.values[4] = oblique;
+	p.values[5] = xAlign;
+	p.h_align = hAlign;
+	p.v_align = vAlign;
+	p.left_align = leftAlign;
+	m_primitives.append(p);
 }
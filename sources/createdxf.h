@@ -22,40 +22,68 @@
 #include <QtWidgets>
 
 
-/* This class exports the project to DXF Format */
+/**
+	This class exports the project to DXF Format.
+	A Createdxf is a writer context : it holds the scale of the export and
+	the list of the primitives drawn, without any global state.
+	The primitives are extracted from the diagram in the GUI thread, then
+	write() formats the dxf code and writes the file, which can be done
+	from any thread, for several drawings at the same time.
+*/
 class Createdxf
-{    
-    public:
-    Createdxf();
-    ~Createdxf();
-	static void dxfBegin (const QString&);
-	static void dxfEnd(const QString&);
-    // you can add more functions to create more drawings.
-	static void drawCircle(const QString&,double,double,double,int);
-	static void drawArc(const QString&,double x,double y,double rad,double startAngle,double endAngle,int color);
-	static void drawDonut(QString,double,double,double,int);
+{
+	public:
+	Createdxf(double x_scale = 1, double y_scale = 1);
+	~Createdxf();
+
+	bool write(const QString &file_path, QString *error_message = nullptr) const;
+	qint64 memorySize() const;
+	int primitivesCount() const {return m_primitives.size();}
+
+	double xScale() const {return m_x_scale;}
+	double yScale() const {return m_y_scale;}
 
-	static void drawArcEllipse (const QString &file_path, qreal x, qreal y, qreal w, qreal h, qreal startAngle, qreal spanAngle, qreal hotspot_x, qreal hotspot_y, qreal rotation_angle, const int &colorcode);
+	// you can add more functions to create more drawings.
+	void drawCircle(double radius, double x, double y, int colour);
+	void drawArc(double x,double y,double rad,double startAngle,double endAngle,int color);
 
-	static void drawEllipse (const QString &filepath, const QRectF &rect, const int &colorcode);
+	void drawArcEllipse (qreal x, qreal y, qreal w, qreal h, qreal startAngle, qreal spanAngle, qreal hotspot_x, qreal hotspot_y, qreal rotation_angle, const int &colorcode);
 
-	static void drawRectangle(const QString &filepath,double,double,double,double,const int &colorcode);
-	static void drawRectangle(const QString &filepath, const QRectF &rect, const int &colorcode);
+	void drawEllipse (const QRectF &rect, const int &colorcode);
 
-	static void drawLine(const QString &filapath,double,double,double,double, const int &clorcode);
-	static void drawLine(const QString &filepath, const QLineF &line,const int &colorcode);
+	void drawRectangle(double,double,double,double,const int &colorcode);
+	void drawRectangle(const QRectF &rect, const int &colorcode);
 
-	static void drawText(const QString&,const QString&,double,double,double,double,int);
-	static void drawTextAligned(const QString& fileName, const QString& text,double x, double y, double height, double rotation, double oblique,int hAlign, int vAlign, double xAlign, int colour, bool leftAlign = false, float scale = 0);
+	void drawLine(double,double,double,double, const int &clorcode);
+	void drawLine(const QLineF &line,const int &colorcode);
 
+	void drawText(const QString&,double,double,double,double,int);
+	void drawTextAligned(const QString& text,double x, double y, double height, double rotation, double oblique,int hAlign, int vAlign, double xAlign, int colour, bool leftAlign = false, float scale = 0);
 
-    static int getcolorCode (const long red, const long green, const long blue);
-    static long RGBcodeTable[];
 
-    static const double sheetWidth;
+	static int getcolorCode (const long red, const long green, const long blue);
+	static long RGBcodeTable[];
+
+	static const double sheetWidth;
 	static const double sheetHeight;
-	static double		xScale;
-	static double		yScale;
+
+	private:
+	///A primitive already scaled in the dxf coordinates, the meaning of values depend of type
+	struct Primitive
+	{
+		enum Type {Circle, Arc, Line, Rectangle, Text, TextAligned};
+		Type type;
+		int colour;
+		double values[6];
+		QString text;
+		int h_align = 0;
+		int v_align = 0;
+		bool left_align = false;
+	};
+
+	double m_x_scale;
+	double m_y_scale;
+	QVector<Primitive> m_primitives;
 };
 
 #endif // CREATEDXF_H
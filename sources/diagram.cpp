@@ -37,6 +37,31 @@
 #include "elementtextitemgroup.h"
 #include "undocommand/addelementtextcommand.h"
 #include "QPropertyUndoCommand/qpropertyundocommand.h"
+#include "qettrace.h"
+#include "diagrammimedata.h"
+
+namespace {
+	/**
+	 * @brief sceneBounds
+	 * @param item
+	 * @return the bounding rect of @item and his children, in scene coordinates
+	 */
+	QRectF sceneBounds(const QGraphicsItem *item) {
+		return item->sceneBoundingRect() | item->mapRectToScene(item->childrenBoundingRect());
+	}
+
+	/**
+	 * @brief onBoundary
+	 * @return true if @rect touch or go beyond the edges of @bounds
+	 */
+	bool onBoundary(const QRectF &rect, const QRectF &bounds)
+	{
+		return rect.left()  <= bounds.left()  ||
+			   rect.top()   <= bounds.top()   ||
+			   rect.right() >= bounds.right() ||
+			   rect.bottom()>= bounds.bottom();
+	}
+}
 
 int Diagram::xGrid  = 10;
 int Diagram::yGrid  = 10;
@@ -49,6 +74,28 @@ const qreal Diagram::margin = 5.0;
 // static variable to keep track of present background color of the diagram.
 QColor		Diagram::background_color = Qt::white;
 
+namespace {
+		///Tag name of the children of a diagram xml which describe its items
+	const QStringList diagram_items_tags {"elements", "conductors", "inputs", "images", "shapes"};
+
+	/**
+	 * @brief canBeDehydrated
+	 * @param diagram_xml : the xml description of a folio
+	 * @return true if the folio described by @diagram_xml can stay dehydrated at loading.
+	 * A folio with linked elements (cross references, folio reports) is always materialized,
+	 * because the elements of the others folios need it to be linked.
+	 */
+	bool canBeDehydrated(const QDomElement &diagram_xml)
+	{
+		for (const QDomElement &element_xml : QET::findInDomElement(diagram_xml, "elements", "element")) {
+			if (!QET::findInDomElement(element_xml, "links_uuids", "link_uuid").isEmpty()) {
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
 /**
  * @brief Diagram::Diagram
  * Constructor
@@ -89,6 +136,9 @@ Diagram::Diagram(QETProject *project) :
 	connect(&border_and_titleblock, SIGNAL(borderChanged(QRectF,QRectF)), this, SLOT(adjustSceneRect()));
 	connect(&border_and_titleblock, SIGNAL(titleBlockFolioChanged(const QString &)), this, SLOT(updateLabels()));
 	connect(this, SIGNAL (diagramActivated()), this, SLOT(loadElmtFolioSeq()));
+		//Must be the first connection to selectionChanged, for keep
+		//up to date the selected items before the others slots use it.
+	connect(this, &QGraphicsScene::selectionChanged, this, &Diagram::selectionWasChanged);
 	connect(this, SIGNAL (diagramActivated()), this, SLOT(loadCndFolioSeq()));
 	adjustSceneRect();
 }
@@ -502,6 +552,7 @@ void Diagram::setConductorsAutonumName(const QString &name) {
 	@return Une QImage representant le schema
 */
 bool Diagram::toPaintDevice(QPaintDevice &pix, int width, int height, Qt::AspectRatioMode aspectRatioMode) {
+	QET_TRACE("Diagram::toPaintDevice");
 	// determine la zone source =  contenu du schema + marges
 	QRectF source_area;
 	if (!use_border_) {
@@ -572,7 +623,7 @@ QSize Diagram::imageSize() const {
 	Un schema vide ne contient ni element, ni conducteur, ni champ de texte
 */
 bool Diagram::isEmpty() const {
-	return(!items().count());
+	return(!isDehydrated() && !items().count());
 }
 
 /**
@@ -602,6 +653,7 @@ QList < QSet <Conductor *> > Diagram::potentials() {
 	@return Un Document XML (QDomDocument)
 */
 QDomDocument Diagram::toXml(bool whole_content) {
+	QET_TRACE("Diagram::toXml");
 	// document
 	QDomDocument document;
 	
@@ -682,6 +734,16 @@ QDomDocument Diagram::toXml(bool whole_content) {
 	}
 	document.appendChild(racine);
 	
+		//A dehydrated folio write directly the xml of its items, without materialize them
+	if (whole_content && isDehydrated()) {
+		QDomDocument content;
+		content.setContent(qUncompress(m_dehydrated_content));
+		for (QDomElement child = content.documentElement().firstChildElement() ; !child.isNull() ; child = child.nextSiblingElement()) {
+			racine.appendChild(document.importNode(child, true));
+		}
+		return(document);
+	}
+	
 	// si le schema ne contient pas d'element (et donc pas de conducteurs), on retourne de suite le document XML
 	if (items().isEmpty()) return(document);
 	
@@ -842,6 +904,7 @@ bool Diagram::initFromXml(QDomElement &document, QPointF position, bool consider
 	@return true si l'import a reussi, false sinon
 */
 bool Diagram::fromXml(QDomElement &document, QPointF position, bool consider_informations, DiagramContent *content_ptr) {
+	QET_TRACE("Diagram::fromXml");
 	const QDomElement& root = document;
 	// The first element must be a diagram
 	if (root.tagName() != "diagram") return(false);
@@ -1099,6 +1162,125 @@ void Diagram::refreshContents()
 		conductor->refreshText();
 }
 
+/**
+ * @brief Diagram::initDehydratedFromXml
+ * Load the folio described by @document, like initFromXml, but keep it dehydrated :
+ * only the properties of the folio (title block, border, conductors properties, autonum...)
+ * are loaded, the items (elements, conductors, texts, images and shapes) are kept in a
+ * compressed xml and are only created by materialize(), when the folio is really needed
+ * (viewed, edited, printed, exported or searched).
+ * A folio with linked elements, or from a version prior to 0.3, is loaded entirely.
+ * @param document : xml description of the folio
+ * @return true if the loading succeeded
+ */
+bool Diagram::initDehydratedFromXml(QDomElement &document)
+{
+	if (document.tagName() != "diagram") return(false);
+	if (!canBeDehydrated(document)) {
+		return initFromXml(document);
+	}
+
+		//Split the properties of the folio and its items
+	QDomElement properties = document.cloneNode(false).toElement();
+	QDomDocument content;
+	QDomElement content_root = content.createElement("diagram");
+	content.appendChild(content_root);
+	for (QDomElement child = document.firstChildElement() ; !child.isNull() ; child = child.nextSiblingElement())
+	{
+		if (diagram_items_tags.contains(child.tagName())) {
+			content_root.appendChild(content.importNode(child, true));
+		} else {
+			properties.appendChild(child.cloneNode(true));
+		}
+	}
+
+	if (!fromXml(properties)) {
+		return(false);
+	}
+
+		//Nothing to keep dehydrated
+	if (content_root.firstChild().isNull()) {
+		return(true);
+	}
+
+		//Before 0.3 the texts of elements must be rotated at the loading of the project
+	qreal version = declaredQElectroTechVersion(true);
+	if (version != -1 && version < 0.3) {
+		return(fromXml(content_root, QPointF(), false));
+	}
+
+	for (const QDomElement &element_xml : QET::findInDomElement(content_root, "elements", "element"))
+	{
+		m_dehydrated_element_types.insert(element_xml.attribute("type"));
+		if (element_xml.hasAttribute("uuid")) {
+			m_dehydrated_uuids.insert(QUuid(element_xml.attribute("uuid")));
+		}
+	}
+	m_dehydrated_content = qCompress(content.toByteArray(-1));
+	return(true);
+}
+
+/**
+ * @brief Diagram::isDehydrated
+ * @return true if the items of this folio are not yet created
+ */
+bool Diagram::isDehydrated() const {
+	return !m_dehydrated_content.isEmpty();
+}
+
+/**
+ * @brief Diagram::dehydratedSize
+ * @return the size in bytes of the compressed content of this folio, 0 if the folio is materialized
+ */
+int Diagram::dehydratedSize() const {
+	return m_dehydrated_content.size();
+}
+
+/**
+ * @brief Diagram::hasDehydratedElement
+ * @param uuids
+ * @return true if this folio is dehydrated and one of its elements have an uuid of @uuids
+ */
+bool Diagram::hasDehydratedElement(const QList<QUuid> &uuids) const
+{
+	if (!isDehydrated()) {
+		return false;
+	}
+	for (const QUuid &uuid : uuids) {
+		if (m_dehydrated_uuids.contains(uuid)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Diagram::materialize
+ * Create the items of a dehydrated folio.
+ * Do nothing if the folio is already materialized.
+ */
+void Diagram::materialize()
+{
+	QET_TRACE("Diagram::materialize");
+	if (!isDehydrated()) {
+		return;
+	}
+
+	QDomDocument content;
+	content.setContent(qUncompress(m_dehydrated_content));
+	m_dehydrated_content.clear();
+	m_dehydrated_element_types.clear();
+	m_dehydrated_uuids.clear();
+
+		//The items must be created even if the project is read only
+	m_materializing = true;
+	QDomElement root = content.documentElement();
+	fromXml(root, QPointF(), false);
+	m_materializing = false;
+
+	refreshContents();
+}
+
 /**
  * @brief Diagram::addItem
  * Réimplemented from QGraphicsScene::addItem(QGraphicsItem *item)
@@ -1107,8 +1289,9 @@ void Diagram::refreshContents()
  */
 void Diagram::addItem(QGraphicsItem *item)
 {
-	if (!item || isReadOnly() || item->scene() == this) return;
+	if (!item || (isReadOnly() && !m_materializing) || item->scene() == this) return;
 	QGraphicsScene::addItem(item);
+	itemGeometryChanged(item);
 
 	switch (item->type())
 	{
@@ -1132,7 +1315,7 @@ void Diagram::addItem(QGraphicsItem *item)
  */
 void Diagram::removeItem(QGraphicsItem *item)
 {
-	if (!item || isReadOnly()) return;
+	if (!item || (isReadOnly() && !m_materializing)) return;
 
 	switch (item->type())
 	{
@@ -1152,6 +1335,7 @@ void Diagram::removeItem(QGraphicsItem *item)
 		default: {break;}
 	}
 
+	itemGeometryAboutToChange(item);
 	QGraphicsScene::removeItem(item);
 }
 
@@ -1213,6 +1397,7 @@ void Diagram::selectAll() {
 	blockSignals(true);
 	foreach(QGraphicsItem *qgi, items()) qgi -> setSelected(true);
 	blockSignals(false);
+	m_selected_items_dirty = true;
 	emit(selectionChanged());
 }
 
@@ -1234,6 +1419,7 @@ void Diagram::invertSelection() {
 	blockSignals(true);
 	foreach (QGraphicsItem *item, items()) item -> setSelected(!item -> isSelected());
 	blockSignals(false);
+	m_selected_items_dirty = true;
 	emit(selectionChanged());
 }
 
@@ -1496,6 +1682,101 @@ QList <Conductor *> Diagram::conductors() const {
 	return (cnd_list);
 }
 
+/**
+ * @brief Diagram::terminalsOnAxis
+ * Used to find the terminals aligned with a terminal without querying the items
+ * of the scene along the help line (the scene isn't indexed).
+ * The index is built at the first call, then kept up to date by the elements
+ * when they move, rotate, or are added to / removed from the diagram.
+ * @param axis : Qt::Vertical for the north and south terminals,
+ * Qt::Horizontal for the east and west terminals.
+ * @param coordinate : x of the dock point (vertical axis) or y (horizontal axis)
+ * @return the terminals with this orientation whose dock point is on the axis.
+ * The caller must still check the exact position of the dock point.
+ */
+QList<Terminal *> Diagram::terminalsOnAxis(Qt::Orientation axis, qreal coordinate) const
+{
+	if (!m_terminal_index_built)
+	{
+		for (QGraphicsItem *qgi : items()) {
+			if (Element *elmt = qgraphicsitem_cast<Element *>(qgi)) {
+				for (Terminal *terminal : elmt->terminals()) {
+					indexTerminal(terminal);
+				}
+			}
+		}
+		m_terminal_index_built = true;
+	}
+
+	return (axis == Qt::Vertical ? m_vertical_terminals : m_horizontal_terminals).values(qRound(coordinate));
+}
+
+/**
+ * @brief Diagram::updateTerminalIndex
+ * Update the terminals of @element in the index used by terminalsOnAxis().
+ * Called by @element when his position or his rotation changed.
+ * @param element
+ */
+void Diagram::updateTerminalIndex(Element *element)
+{
+	if (!m_terminal_index_built) {
+		return;
+	}
+
+	for (Terminal *terminal : element->terminals())
+	{
+		unindexTerminal(terminal);
+		indexTerminal(terminal);
+	}
+}
+
+/**
+ * @brief Diagram::removeFromTerminalIndex
+ * Remove the terminals of @element from the index used by terminalsOnAxis().
+ * Called by @element when he is removed from this diagram or deleted.
+ * @param element
+ */
+void Diagram::removeFromTerminalIndex(Element *element)
+{
+	if (!m_terminal_index_built) {
+		return;
+	}
+
+	for (Terminal *terminal : element->terminals()) {
+		unindexTerminal(terminal);
+	}
+}
+
+/**
+ * @brief Diagram::indexTerminal
+ * @param terminal : terminal to add to the index of terminals
+ */
+void Diagram::indexTerminal(Terminal *terminal) const
+{
+	TerminalIndexKey key;
+	key.vertical = !Qet::isHorizontal(terminal->orientation());
+	QPointF dock = terminal->dockConductor();
+	key.coordinate = qRound(key.vertical ? dock.x() : dock.y());
+
+	(key.vertical ? m_vertical_terminals : m_horizontal_terminals).insert(key.coordinate, terminal);
+	m_indexed_terminals.insert(terminal, key);
+}
+
+/**
+ * @brief Diagram::unindexTerminal
+ * @param terminal : terminal to remove from the index of terminals
+ */
+void Diagram::unindexTerminal(Terminal *terminal) const
+{
+	auto it = m_indexed_terminals.find(terminal);
+	if (it == m_indexed_terminals.end()) {
+		return;
+	}
+
+	(it->vertical ? m_vertical_terminals : m_horizontal_terminals).remove(it->coordinate, terminal);
+	m_indexed_terminals.erase(it);
+}
+
 ElementsMover &Diagram::elementsMover() {
 	return m_elements_mover;
 }
@@ -1511,6 +1792,19 @@ ElementTextsMover &Diagram::elementTextsMover() {
 */
 bool Diagram::usesElement(const ElementsLocation &location)
 {
+	if (isDehydrated())
+	{
+		for (const QString &type_id : m_dehydrated_element_types)
+		{
+			ElementsLocation element_location = type_id.startsWith("embed://") ? ElementsLocation(type_id, m_project) :
+																				  ElementsLocation(type_id);
+			if (element_location == location) {
+				return(true);
+			}
+		}
+		return(false);
+	}
+
 	for(Element *element : elements()) {
 		if (element -> location() == location) {
 			return(true);
@@ -1533,6 +1827,7 @@ bool Diagram::usesTitleBlockTemplate(const QString &name) {
  * Freeze every existent element label.
  */
 void Diagram::freezeElements(bool freeze) {
+	materialize();
 	foreach (Element *elmt, elements()) {
 		elmt->freezeLabel(freeze);
 	}
@@ -1543,6 +1838,7 @@ void Diagram::freezeElements(bool freeze) {
  * Unfreeze every existent element label.
  */
 void Diagram::unfreezeElements() {
+	materialize();
 	foreach (Element *elmt, elements()) {
 		elmt->freezeLabel(false);
 	}
@@ -1569,6 +1865,7 @@ bool Diagram::freezeNewElements() {
  * Freeze every existent conductor label.
  */
 void Diagram::freezeConductors(bool freeze) {
+	materialize();
 	foreach (Conductor *cnd, conductors()) {
 		cnd->setFreezeLabel(freeze);
 	}
@@ -1597,8 +1894,57 @@ bool Diagram::freezeNewConductors() {
 void Diagram::adjustSceneRect()
 {
 	QRectF old_rect = sceneRect();
-	setSceneRect(border_and_titleblock.borderAndTitleBlockRect().united(itemsBoundingRect()));
-	update(old_rect.united(sceneRect()));
+	QRectF new_rect = border_and_titleblock.borderAndTitleBlockRect().united(itemsRect());
+	if (new_rect == old_rect) {
+		return;
+	}
+	setSceneRect(new_rect);
+	update(old_rect.united(new_rect));
+}
+
+/**
+ * @brief Diagram::itemsRect
+ * Same as QGraphicsScene::itemsBoundingRect, but the rect is kept between two calls :
+ * it grows when an item is added or moved, and is only computed again from every items
+ * when an item on the edge of the rect is moved or removed
+ * (see itemGeometryAboutToChange and itemGeometryChanged).
+ * @return the bounding rect of the items of this diagram
+ */
+QRectF Diagram::itemsRect()
+{
+	if (m_items_rect_dirty)
+	{
+		m_items_rect = itemsBoundingRect();
+		m_items_rect_dirty = false;
+	}
+	return m_items_rect;
+}
+
+/**
+ * @brief Diagram::itemGeometryAboutToChange
+ * Must be called before the move or the removal of @item.
+ * If @item is on the edge of the bounding rect of the items, the rect
+ * can shrink and will be computed again at the next call of adjustSceneRect.
+ * @param item
+ */
+void Diagram::itemGeometryAboutToChange(const QGraphicsItem *item)
+{
+	if (!m_items_rect_dirty && onBoundary(sceneBounds(item), m_items_rect)) {
+		m_items_rect_dirty = true;
+	}
+}
+
+/**
+ * @brief Diagram::itemGeometryChanged
+ * Must be called after the addition or the move of @item,
+ * the bounding rect of the items grows to contain @item.
+ * @param item
+ */
+void Diagram::itemGeometryChanged(const QGraphicsItem *item)
+{
+	if (!m_items_rect_dirty) {
+		m_items_rect |= sceneBounds(item);
+	}
 }
 
 /**
@@ -1689,6 +2035,52 @@ void Diagram::setDrawColoredConductors(bool dcc) {
 	draw_colored_conductors_ = dcc;
 }
 
+/**
+ * @brief Diagram::selectedItems
+ * Hide QGraphicsScene::selectedItems, the list of the selected items is only
+ * built at the first call after a change of the selection, so the several
+ * users of the selection (properties editor, actions, context menu...) share it.
+ * The list is invalidated by the signal selectionChanged : a code which change the
+ * selection while the signals of the diagram are blocked must emit selectionChanged
+ * after, or invalidate the list itself (see selectAll and invertSelection).
+ * @return the selected items
+ */
+QList<QGraphicsItem *> Diagram::selectedItems() const
+{
+	if (m_selected_items_dirty)
+	{
+		m_selected_items = QGraphicsScene::selectedItems();
+		m_selected_items_dirty = false;
+	}
+	return(m_selected_items);
+}
+
+/**
+ * @brief Diagram::selectionWasChanged
+ * Called for each change of the selection. During a rubber band selection
+ * or a selection of many items, this slot is called several times,
+ * the signal compressedSelectionChanged is emitted only once at the next turn of the event loop.
+ */
+void Diagram::selectionWasChanged()
+{
+	m_selected_items_dirty = true;
+	if (m_selection_change_scheduled) {
+		return;
+	}
+	m_selection_change_scheduled = true;
+	QMetaObject::invokeMethod(this, "emitCompressedSelectionChanged", Qt::QueuedConnection);
+}
+
+/**
+ * @brief Diagram::emitCompressedSelectionChanged
+ * Emit the signal compressedSelectionChanged, see selectionWasChanged()
+ */
+void Diagram::emitCompressedSelectionChanged()
+{
+	m_selection_change_scheduled = false;
+	emit(compressedSelectionChanged());
+}
+
 /**
 	@return la liste des conducteurs selectionnes sur le schema
 */
@@ -1704,6 +2096,10 @@ QSet<Conductor *> Diagram::selectedConductors() const {
 
 /// @return true si le presse-papier semble contenir un schema
 bool Diagram::clipboardMayContainDiagram() {
+	const QMimeData *mime_data = QApplication::clipboard() -> mimeData();
+	if (mime_data && mime_data -> hasFormat(DiagramMimeData::snapshotFormat())) {
+		return(true);
+	}
 	QString clipboard_text = QApplication::clipboard() -> text().trimmed();
 	bool may_be_diagram = clipboard_text.startsWith("<diagram") && clipboard_text.endsWith("</diagram>");
 	return(may_be_diagram);
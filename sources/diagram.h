@@ -119,6 +119,35 @@ class Diagram : public QGraphicsScene
 
 		bool m_freeze_new_elements;
 		bool m_freeze_new_conductors_;
+
+			///Compressed xml of the items of a dehydrated folio, empty when the folio is materialized
+		QByteArray m_dehydrated_content;
+			///Summary of a dehydrated folio : type and uuid of its elements
+		QSet<QString> m_dehydrated_element_types;
+		QSet<QUuid> m_dehydrated_uuids;
+		bool m_materializing = false;
+
+			///Selected items, updated at the first call of selectedItems() after a change of the selection.
+			///Every code which blocks the signals while changing the selection must reset m_selected_items_dirty
+			///or emit selectionChanged afterwards.
+		mutable QList<QGraphicsItem *> m_selected_items;
+		mutable bool m_selected_items_dirty = true;
+		bool m_selection_change_scheduled = false;
+
+			///Index of the terminals by alignment axis, see terminalsOnAxis()
+		struct TerminalIndexKey
+		{
+			bool vertical;
+			int coordinate;
+		};
+		mutable QMultiHash<int, Terminal *> m_vertical_terminals,
+											m_horizontal_terminals;
+		mutable QHash<Terminal *, TerminalIndexKey> m_indexed_terminals;
+		mutable bool m_terminal_index_built = false;
+
+			///Bounding rect of the items, see itemsRect()
+		QRectF m_items_rect;
+		bool m_items_rect_dirty = true;
 	
 	// METHODS
 	protected:
@@ -166,6 +195,13 @@ class Diagram : public QGraphicsScene
 	
 		void refreshContents();
 	
+			// methods related to dehydrated folio
+		bool initDehydratedFromXml(QDomElement &);
+		bool isDehydrated() const;
+		int dehydratedSize() const;
+		bool hasDehydratedElement(const QList<QUuid> &) const;
+		void materialize();
+	
 			// methods related to graphics items addition/removal on the diagram
 		virtual void addItem    (QGraphicsItem *item);
 		virtual void removeItem (QGraphicsItem *item);
@@ -194,6 +230,12 @@ class Diagram : public QGraphicsScene
 	
 		QList<Element *> elements() const;
 		QList<Conductor *> conductors() const;
+		QList<Terminal *> terminalsOnAxis(Qt::Orientation axis, qreal coordinate) const;
+		void updateTerminalIndex(Element *element);
+		void removeFromTerminalIndex(Element *element);
+		void itemGeometryAboutToChange(const QGraphicsItem *item);
+		void itemGeometryChanged(const QGraphicsItem *item);
+		QList<QGraphicsItem *> selectedItems() const;
 		QSet<Conductor *> selectedConductors() const;
 		DiagramContent content() const;
 		bool canRotateSelection() const;
@@ -243,6 +285,17 @@ class Diagram : public QGraphicsScene
 		void findElementRequired(const ElementsLocation &);		/// Signal emitted when users wish to locate an element from the diagram within elements collection
 		void editElementRequired(const ElementsLocation &);		/// Signal emitted when users wish to edit an element from the diagram
 		void diagramActivated();
+			/// Emitted once per turn of the event loop when the selection changed, with the final selection
+		void compressedSelectionChanged();
+
+	private:
+		QRectF itemsRect();
+		void indexTerminal(Terminal *terminal) const;
+		void unindexTerminal(Terminal *terminal) const;
+
+	private slots:
+		void selectionWasChanged();
+		void emitCompressedSelectionChanged();
 };
 Q_DECLARE_METATYPE(Diagram *)
 
@@ -16,10 +16,84 @@
 	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "diagramcontext.h"
-#include <QRegExp>
 #include "qet.h"
+#include <QHash>
+#include <QReadWriteLock>
+#include <QRegularExpression>
 #include <algorithm>
 
+namespace {
+		///Name of the known keys, in the order of DiagramContext::Key
+	const char *known_keys[] = {
+		"label",
+		"formula",
+		"designation",
+		"description",
+		"plant",
+		"comment",
+		"manufacturer",
+		"manufacturer-reference",
+		"quantity",
+		"unity",
+		"auxiliary1",
+		"auxiliary2",
+		"machine-manufacturer-reference",
+		"supplier",
+		"function",
+		"location",
+		"tension-protocol",
+		"author",
+		"date",
+		"title",
+		"filename",
+		"folio",
+		"folio-id",
+		"folio-total",
+		"locmach",
+		"indexrev",
+		"version",
+		"previous-folio-num",
+		"next-folio-num",
+		"projecttitle",
+		"projectpath",
+		"projectfilename",
+		"saveddate",
+		"savedtime",
+		"savedfilename",
+		"savedfilepath"
+	};
+	static_assert(sizeof(known_keys) / sizeof(known_keys[0]) == DiagramContext::KnownKeysCount,
+				  "known_keys must match DiagramContext::Key");
+
+	/**
+	 * @brief The AtomTable struct
+	 * Global table of the keys used by the diagram contexts.
+	 * Each key is stored once and identified by its index (the atom).
+	 * The table can be used from several threads (labels are evaluated in worker threads).
+	 */
+	struct AtomTable
+	{
+		AtomTable()
+		{
+			for (const char *key : known_keys)
+			{
+				atoms.insert(QString::fromLatin1(key), names.size());
+				names << QString::fromLatin1(key);
+			}
+		}
+
+		QReadWriteLock lock;
+		QHash<QString, int> atoms;
+		QVector<QString> names;
+	};
+
+	AtomTable &atomTable()
+	{
+		static AtomTable table;
+		return table;
+	}
+}
+
 /**
  * @brief DiagramContext::add
  * Add all value of @other to this.
@@ -28,10 +102,20 @@
  * All other keys of this context, which are not present in @other, stay unchanged.
  * @param other
  */
-void DiagramContext::add(DiagramContext other)
+void DiagramContext::add(const DiagramContext &other)
 {
-	for (QString key : other.keys()) {
-		addValue(key, other.value(key));
+		//Share the storage of @other when possible
+	if (m_entries.isEmpty()) {
+		m_entries = other.m_entries;
+		for (int i = 0 ; i < m_entries.size() ; ++i) {
+			if (!m_entries.at(i).show) {
+				m_entries[i].show = true;
+			}
+		}
+		return;
+	}
+	for (const Entry &e : other.m_entries) {
+		insert(e.atom, e.value, true);
 	}
 }
 
@@ -40,19 +124,22 @@ void DiagramContext::add(DiagramContext other)
 */
 QList<QString> DiagramContext::keys(DiagramContext::KeyOrder order) const
 {
-	if (order == None) {
-		return m_content.keys();
-	}
-	else
+	QList<QString> keys_list;
+	keys_list.reserve(m_entries.size());
 	{
-		QList<QString> keys_list = m_content.keys();
-		if (order == Alphabetical) {
-			std::sort(keys_list.begin(), keys_list.end());
-		} else {
-			std::sort(keys_list.begin(), keys_list.end(), DiagramContext::stringLongerThan);
+		AtomTable &table = atomTable();
+		QReadLocker locker(&table.lock);
+		for (const Entry &e : m_entries) {
+			keys_list << table.names.at(e.atom);
 		}
-		return(keys_list);
 	}
+	
+	if (order == Alphabetical) {
+		std::sort(keys_list.begin(), keys_list.end());
+	} else if (order == DecreasingLength) {
+		std::sort(keys_list.begin(), keys_list.end(), DiagramContext::stringLongerThan);
+	}
+	return(keys_list);
 }
 
 /**
@@ -60,52 +147,74 @@ QList<QString> DiagramContext::keys(DiagramContext::KeyOrder order) const
 	@return true if that key is known to the diagram context, false otherwise
 */
 bool DiagramContext::contains(const QString &key) const {
-	return(m_content.contains(key));
+	return(entry(atom(key, false)));
+}
+
+/**
+	@param key interned key
+	@return true if that key is known to the diagram context, false otherwise
+*/
+bool DiagramContext::contains(DiagramContext::Key key) const {
+	return(entry(key));
 }
 
 /**
 	@param key
 */
 const QVariant DiagramContext::operator[](const QString &key) const {
-	return(m_content[key]);
+	return(value(key));
 }
 
 /**
 	@param key key to insert in the context - the key may only contain lowercase
 	letters and dashes.
 	If embedded key is set, key must be find it else value is not added.
-	@see DiagramContext::keyIsAcceptable()
+	@see DiagramContext::validKeyRegExp()
 	@param value value to insert in the context
 	@param show if value is used to be show on the diagram or somewhere else,
 	we can specify if he is show(true) or not(false)
 	@return true if the insertion succeeds, false otherwise
 */
 bool DiagramContext::addValue(const QString &key, const QVariant &value, bool show) {
-	if (keyIsAcceptable(key)) {
-		m_content.insert(key, value);
-		m_content_show.insert(key, show);
-		return(true);
-		}
-	return(false);
+	int a = atom(key, true);
+	if (a < 0) {
+		return(false);
+	}
+	insert(a, value, show);
+	return(true);
+}
+
+/**
+	Same as addValue(const QString &, const QVariant &, bool) with an interned key,
+	without any string hashing.
+*/
+bool DiagramContext::addValue(DiagramContext::Key key, const QVariant &value, bool show) {
+	insert(key, value, show);
+	return(true);
 }
 
 QVariant DiagramContext::value(const QString &key) const {
-	return m_content.value(key);
+	const Entry *e = entry(atom(key, false));
+	return e ? e->value : QVariant();
+}
+
+QVariant DiagramContext::value(DiagramContext::Key key) const {
+	const Entry *e = entry(key);
+	return e ? e->value : QVariant();
 }
 
 /**
 	Clear the content of this diagram context.
 */
 void DiagramContext::clear() {
-	m_content.clear();
-	m_content_show.clear();
+	m_entries.clear();
 }
 
 /**
 	@return the number of key/value pairs stored in this object.
 */
 int DiagramContext::count() {
-	return(m_content.count());
+	return(m_entries.count());
 }
 
 /**
@@ -113,14 +222,12 @@ int DiagramContext::count() {
  * @return the value pairs with key, if key no found, return false
  */
 bool DiagramContext::keyMustShow(const QString &key) const {
-	if (m_content_show.contains(key))
-		return m_content_show[key];
-	return false;
+	const Entry *e = entry(atom(key, false));
+	return e ? e->show : false;
 }
 
 bool DiagramContext::operator==(const DiagramContext &dc) const {
-	return(m_content     == dc.m_content &&
-		   m_content_show == dc.m_content_show);
+	return(m_entries == dc.m_entries);
 }
 
 bool DiagramContext::operator!=(const DiagramContext &dc) const {
@@ -132,11 +239,12 @@ bool DiagramContext::operator!=(const DiagramContext &dc) const {
 	named \a tag_name (defaults to "property").
 */
 void DiagramContext::toXml(QDomElement &e, const QString &tag_name) const {
-	foreach (QString key, keys()) {
+	const QList<QString> keys_list = keys();
+	for (int i = 0 ; i < m_entries.size() ; ++i) {
 		QDomElement property = e.ownerDocument().createElement(tag_name);
-		property.setAttribute("name", key);
-		property.setAttribute("show",m_content_show[key]);
-		QDomText value = e.ownerDocument().createTextNode(m_content[key].toString());
+		property.setAttribute("name", keys_list.at(i));
+		property.setAttribute("show", m_entries.at(i).show);
+		QDomText value = e.ownerDocument().createTextNode(m_entries.at(i).value.toString());
 		property.appendChild(value);
 		e.appendChild(property);
 	}
@@ -149,8 +257,7 @@ void DiagramContext::toXml(QDomElement &e, const QString &tag_name) const {
 void DiagramContext::fromXml(const QDomElement &e, const QString &tag_name) {
 	foreach (QDomElement property, QET::findInDomElement(e, tag_name)) {
 		if (!property.hasAttribute("name")) continue;
-		addValue(property.attribute("name"), QVariant(property.text()));
-		m_content_show.insert(property.attribute("name"), property.attribute("show", "1").toInt());
+		addValue(property.attribute("name"), QVariant(property.text()), property.attribute("show", "1").toInt());
 	}
 }
 
@@ -160,12 +267,11 @@ void DiagramContext::fromXml(const QDomElement &e, const QString &tag_name) {
 */
 void DiagramContext::toSettings(QSettings &settings, const QString &array_name) const {
 	settings.beginWriteArray(array_name);
-	int i = 0;
-	foreach (QString key, m_content.keys()) {
+	const QList<QString> keys_list = keys();
+	for (int i = 0 ; i < m_entries.size() ; ++i) {
 		settings.setArrayIndex(i);
-		settings.setValue("name", key);
-		settings.setValue("value", m_content[key].toString());
-		++ i;
+		settings.setValue("name", keys_list.at(i));
+		settings.setValue("value", m_entries.at(i).value.toString());
 	}
 	settings.endArray();
 }
@@ -187,12 +293,19 @@ void DiagramContext::fromSettings(QSettings &settings, const QString &array_name
 
 /**
 	@return the regular expression used to check whether a given key is acceptable.
-	@see keyIsAcceptable()
+	@see atom()
 */
 QString DiagramContext::validKeyRegExp() {
 	return("^[a-z0-9-]+$");
 }
 
+/**
+	@return the string of the interned key \a key
+*/
+QString DiagramContext::keyName(DiagramContext::Key key) {
+	return(QString::fromLatin1(known_keys[key]));
+}
+
 /**
 	@return True if \a a is longer than \a b, false otherwise.
 */
@@ -202,9 +315,88 @@ bool DiagramContext::stringLongerThan(const QString &a, const QString &b) {
 
 /**
 	@param key a key string
-	@return true if that key is acceptable, false otherwise
+	@param create if true and if \a key is not yet interned, \a key is added to the atom table
+	@return the atom of \a key, or -1 if \a key is not interned (or not acceptable when \a create is true)
 */
-bool DiagramContext::keyIsAcceptable(const QString &key) const {
-	QRegExp re(DiagramContext::validKeyRegExp());
-	return(re.exactMatch(key));
+int DiagramContext::atom(const QString &key, bool create)
+{
+	AtomTable &table = atomTable();
+	{
+		QReadLocker locker(&table.lock);
+		auto it = table.atoms.constFind(key);
+		if (it != table.atoms.constEnd()) {
+			return it.value();
+		}
+	}
+	
+	if (!create) {
+		return -1;
+	}
+	
+	static const QRegularExpression re(DiagramContext::validKeyRegExp());
+	if (!re.match(key).hasMatch()) {
+		return -1;
+	}
+	
+	QWriteLocker locker(&table.lock);
+		//The key can be interned by another thread in the meantime
+	auto it = table.atoms.constFind(key);
+	if (it != table.atoms.constEnd()) {
+		return it.value();
+	}
+	int a = table.names.size();
+	table.names << key;
+	table.atoms.insert(key, a);
+	return a;
+}
+
+/**
+	@return the index in m_entries of the first entry whose atom is not less than \a atom
+*/
+int DiagramContext::indexOf(int atom) const
+{
+	auto it = std::lower_bound(m_entries.constBegin(), m_entries.constEnd(), atom,
+							   [](const Entry &e, int a) {return e.atom < a;});
+	return int(it - m_entries.constBegin());
+}
+
+/**
+	@return the entry of \a atom or nullptr if there is no such entry
+*/
+const DiagramContext::Entry *DiagramContext::entry(int atom) const
+{
+	if (atom < 0) {
+		return nullptr;
+	}
+	int i = indexOf(atom);
+	if (i < m_entries.size() && m_entries.at(i).atom == atom) {
+		return &m_entries.at(i);
+	}
+	return nullptr;
+}
+
+/**
+	Insert or replace the value of \a atom.
+	Nothing is done (and the storage is not detached) if the value is the same.
+*/
+void DiagramContext::insert(int atom, const QVariant &value, bool show)
+{
+	int i = indexOf(atom);
+	if (i < m_entries.size() && m_entries.at(i).atom == atom)
+	{
+		const Entry &e = m_entries.at(i);
+		if (e.show == show && e.value == value) {
+			return;
+		}
+		Entry &entry = m_entries[i];
+		entry.value = value;
+		entry.show = show;
+		return;
+	}
+	
+	Entry entry;
+	entry.atom = atom;
+	entry.value = value;
+	entry.show = show;
+	m_entries.insert(i, entry);
 }
@@ -23,6 +23,7 @@
 #include <QString>
 #include <QVariant>
 #include <QStringList>
+#include <QVector>
 /**
 	This class represents a diagram context, i.e. the data (a list of key/value
 	pairs) of a diagram at a given time. It is notably used by titleblock templates
@@ -58,13 +59,59 @@ class DiagramContext
 			Alphabetical,
 			DecreasingLength
 		};
+		
+			///Interned keys known by QElectroTech, the others keys are interned at their first use.
+		enum Key {
+				//Element
+			Label,
+			Formula,
+			Designation,
+			Description,
+			Plant,
+			Comment,
+			Manufacturer,
+			ManufacturerReference,
+			Quantity,
+			Unity,
+			Auxiliary1,
+			Auxiliary2,
+			MachineManufacturerReference,
+			Supplier,
+			Function,
+			Location,
+			TensionProtocol,
+				//Title block and project
+			Author,
+			Date,
+			Title,
+			Filename,
+			Folio,
+			FolioId,
+			FolioTotal,
+			Locmach,
+			Indexrev,
+			Version,
+			PreviousFolioNum,
+			NextFolioNum,
+			ProjectTitle,
+			ProjectPath,
+			ProjectFilename,
+			SavedDate,
+			SavedTime,
+			SavedFilename,
+			SavedFilepath,
+			KnownKeysCount
+		};
 	
-		void add(DiagramContext other);
+		void add(const DiagramContext &other);
 		QList<QString> keys(KeyOrder = None) const;
 		bool contains(const QString &) const;
+		bool contains(Key) const;
 		const QVariant operator[](const QString &) const;
 		bool addValue(const QString &, const QVariant &, bool show = true);
+		bool addValue(Key, const QVariant &, bool show = true);
 		QVariant value(const QString &key) const;
+		QVariant value(Key key) const;
 		void clear();
 		int count();
 		bool keyMustShow (const QString &) const;
@@ -78,12 +125,28 @@ class DiagramContext
 		void fromSettings(QSettings &, const QString &);
 		
 		static QString validKeyRegExp();
+		static QString keyName(Key key);
 	
 	private:
+			///A key/value pair, the key is an atom of the global atom table.
+		struct Entry
+		{
+			int atom;
+			QVariant value;
+			bool show;
+			bool operator==(const Entry &other) const {
+				return atom == other.atom && show == other.show && value == other.value;
+			}
+		};
+		
 		static bool stringLongerThan(const QString &, const QString &);
-		bool keyIsAcceptable(const QString &) const;
-			/// Diagram context data (key/value pairs)
-		QHash<QString, QVariant> m_content;
-		QHash<QString, bool> m_content_show;
+		static int atom(const QString &key, bool create);
+		int indexOf(int atom) const;
+		const Entry *entry(int atom) const;
+		void insert(int atom, const QVariant &value, bool show);
+		
+			/// Diagram context data (key/value pairs), sorted by atom.
+			/// The vector is implicitly shared : the copies of a context share the same storage until one is modified.
+		QVector<Entry> m_entries;
 };
 #endif
@@ -21,6 +21,12 @@
 #include "element.h"
 #include "diagramcommands.h"
 #include "conductorautonumerotation.h"
+#include "elementdefinitionloader.h"
+#include "elementscollectioncache.h"
+#include "qetapp.h"
+
+#include <QGraphicsPixmapItem>
+#include <QPainter>
 
 
 /**
@@ -38,15 +44,23 @@ DiagramEventAddElement::DiagramEventAddElement(ElementsLocation &location, Diagr
 		//Check if there is an element at this location
 	if (location.isElement() && location.exist())
 	{
+		ElementDefinitionLoader *loader = ElementDefinitionLoader::instance();
+		if (location.isFileSystem() && !loader->isLoaded(location))
+		{
+				//The definition isn't yet parsed, the element is built
+				//when the loader has finished, until then a preview is displayed
+			init();
+			showPreview(pos);
+			connect(loader, &ElementDefinitionLoader::loaded, this, &DiagramEventAddElement::definitionLoaded);
+			loader->prefetch(location);
+			m_running = true;
+		}
 			//location is an element, we build it, if build fail,
 			//m_running stay to false (by default), so this interface will be deleted at next event
-		if (buildElement())
+		else if (buildElement())
 		{
 			init();
-			m_element -> setPos(pos);
-			m_element -> displayHelpLine(true);
-			m_element -> setFlag(QGraphicsItem::ItemIsSelectable, false);
-			m_diagram -> addItem(m_element);
+			showElement(pos, 0);
 			m_running = true;
 		}
 	}
@@ -60,6 +74,7 @@ DiagramEventAddElement::DiagramEventAddElement(ElementsLocation &location, Diagr
 DiagramEventAddElement::~DiagramEventAddElement()
 {
 	if (m_element) delete m_element;
+	if (m_preview) delete m_preview;
 	foreach(QGraphicsView *view, m_diagram->views())
 		view -> setContextMenuPolicy(Qt::DefaultContextMenu);
 }
@@ -72,8 +87,8 @@ DiagramEventAddElement::~DiagramEventAddElement()
  */
 void DiagramEventAddElement::mouseMoveEvent(QGraphicsSceneMouseEvent *event)
 {
-	if (m_element) {
-		m_element->setPos(Diagram::snapToGrid(event->scenePos()));
+	if (QGraphicsItem *item = currentItem()) {
+		item->setPos(Diagram::snapToGrid(event->scenePos()));
 	}
 	event->setAccepted(true);
 }
@@ -97,16 +112,22 @@ void DiagramEventAddElement::mousePressEvent(QGraphicsSceneMouseEvent *event) {
  */
 void DiagramEventAddElement::mouseReleaseEvent(QGraphicsSceneMouseEvent *event)
 {
-	if (m_element)
+		//The definition is still being loaded, the element is built now
+	if (m_preview && event->button() == Qt::LeftButton) {
+		replacePreview();
+	}
+
+	if (currentItem())
 	{
 		if (event->button() == Qt::RightButton)
 		{
-			delete m_element;
+			delete currentItem();
 			m_element = nullptr;
+			m_preview = nullptr;
 			m_running = false;
 			emit finish();
 		}
-		else if (event->button() == Qt::LeftButton)
+		else if (m_element && event->button() == Qt::LeftButton)
 		{
 			addElement();
 		}
@@ -123,10 +144,11 @@ void DiagramEventAddElement::mouseReleaseEvent(QGraphicsSceneMouseEvent *event)
  */
 void DiagramEventAddElement::mouseDoubleClickEvent(QGraphicsSceneMouseEvent *event)
 {
-	if (m_element && (event -> button() == Qt::LeftButton))
+	if (currentItem() && (event -> button() == Qt::LeftButton))
 	{
-		delete m_element;
+		delete currentItem();
 		m_element = nullptr;
+		m_preview = nullptr;
 		m_running = false;
 		emit finish();
 	}
@@ -142,9 +164,10 @@ void DiagramEventAddElement::mouseDoubleClickEvent(QGraphicsSceneMouseEvent *eve
  */
 void DiagramEventAddElement::keyPressEvent(QKeyEvent *event)
 {
-	if (m_element && event->key() == Qt::Key_Space)
+	QGraphicsItem *item = currentItem();
+	if (item && event->key() == Qt::Key_Space)
 	{
-		m_element->setRotation(m_element->rotation() + 90);
+		item->setRotation(item->rotation() + 90);
 		event->setAccepted(true);
 	}
 	else {
@@ -183,12 +206,110 @@ bool DiagramEventAddElement::buildElement()
 		//The creation of element failed, we delete it
 	if (state) {
 		delete m_element;
+		m_element = nullptr;
 		return(false);
 	}
 		//Everything is good
 	return true;
 }
 
+/**
+ * @brief DiagramEventAddElement::showElement
+ * Add the built element to the diagram, at @pos and with @rotation
+ * @param pos
+ * @param rotation
+ */
+void DiagramEventAddElement::showElement(const QPointF &pos, qreal rotation)
+{
+	m_element -> setPos(pos);
+	m_element -> setRotation(rotation);
+	m_element -> displayHelpLine(true);
+	m_element -> setFlag(QGraphicsItem::ItemIsSelectable, false);
+	m_diagram -> addItem(m_element);
+}
+
+/**
+ * @brief DiagramEventAddElement::showPreview
+ * Display at @pos the pixmap of the element used by the elements panel,
+ * or an outline if the pixmap isn't available.
+ * Nothing is parsed to display the preview.
+ * @param pos
+ */
+void DiagramEventAddElement::showPreview(const QPointF &pos)
+{
+	QPixmap pixmap;
+	ElementsCollectionCache *cache = QETApp::collectionCache();
+	ElementsLocation location(m_location);
+	if (cache && cache->fetchElement(location)) {
+		pixmap = cache->pixmap();
+	}
+
+	if (pixmap.isNull())
+	{
+		pixmap = QPixmap(30, 30);
+		pixmap.fill(Qt::transparent);
+		QPainter painter(&pixmap);
+		painter.setPen(QPen(Qt::darkGray, 1, Qt::DashLine));
+		painter.drawRect(pixmap.rect().adjusted(0, 0, -1, -1));
+	}
+
+	m_preview = new QGraphicsPixmapItem(pixmap);
+	m_preview -> setOffset(-pixmap.width()/2, -pixmap.height()/2);
+	m_preview -> setOpacity(0.6);
+	m_preview -> setPos(pos);
+	m_diagram -> addItem(m_preview);
+}
+
+/**
+ * @brief DiagramEventAddElement::replacePreview
+ * Build the element and replace the preview by the element.
+ * If the element can't be built, this event is finished at the next event
+ */
+void DiagramEventAddElement::replacePreview()
+{
+	if (!m_preview) {
+		return;
+	}
+
+	disconnect(ElementDefinitionLoader::instance(), &ElementDefinitionLoader::loaded, this, &DiagramEventAddElement::definitionLoaded);
+
+	QPointF pos = m_preview -> pos();
+	qreal rotation = m_preview -> rotation();
+	delete m_preview;
+	m_preview = nullptr;
+
+	if (buildElement()) {
+		showElement(pos, rotation);
+	} else {
+		m_running = false;
+	}
+}
+
+/**
+ * @brief DiagramEventAddElement::currentItem
+ * @return the element, or the preview if the element isn't yet built
+ */
+QGraphicsItem *DiagramEventAddElement::currentItem() const
+{
+	if (m_element) {
+		return m_element;
+	}
+	return m_preview;
+}
+
+/**
+ * @brief DiagramEventAddElement::definitionLoaded
+ * The loader has finished to parse a definition,
+ * if it's the definition of the element of this event, the preview is replaced by the element.
+ * @param file_path
+ */
+void DiagramEventAddElement::definitionLoaded(const QString &file_path)
+{
+	if (file_path == m_location.fileSystemPath()) {
+		replacePreview();
+	}
+}
+
 /**
  * @brief DiagramEventAddElement::addElement
  * Add an element at the current pos en current rotation,
@@ -22,11 +22,15 @@
 #include "elementslocation.h"
 
 class Element;
+class QGraphicsPixmapItem;
 
 /**
  * @brief The DiagramEventAddElement class
  * This diagram event add a new element, for each left click button at the position of click.
  * Space key rotate current element by 90°, right click button finish this event.
+ * If the definition of the element isn't yet loaded, a preview is displayed
+ * while the definition is parsed in a worker thread (see ElementDefinitionLoader),
+ * then the preview is replaced by the element.
  */
 class DiagramEventAddElement : public DiagramEventInterface
 {
@@ -45,11 +49,19 @@ class DiagramEventAddElement : public DiagramEventInterface
 
 	private:
 		bool buildElement();
+		void showElement(const QPointF &pos, qreal rotation);
+		void showPreview(const QPointF &pos);
+		void replacePreview();
+		QGraphicsItem *currentItem() const;
 		void addElement();
 
+	private slots:
+		void definitionLoaded(const QString &file_path);
+
 	private:
 		ElementsLocation m_location;
 		Element *m_element;
+		QGraphicsPixmapItem *m_preview = nullptr;
 		QString m_integrate_path;
 };
 
@@ -0,0 +1,113 @@
+/*
+	Copyright 2006-2019 The QElectroTech Team
+	This file is part of QElectroTech.
+	
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+	
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "diagrammimedata.h"
+
+#include <QCoreApplication>
+#include <QPointer>
+
+namespace {
+		///The last mime data created, only this one can be pasted without parsing the xml text
+	QPointer<DiagramMimeData> last_mime_data;
+	quint64 last_id = 0;
+}
+
+/**
+ * @brief DiagramMimeData::DiagramMimeData
+ * @param document : xml document of the copied items
+ */
+DiagramMimeData::DiagramMimeData(const QDomDocument &document) :
+	m_document(document),
+	m_id(QString("%1:%2").arg(QCoreApplication::applicationPid()).arg(++last_id).toLatin1())
+{
+	last_mime_data = this;
+}
+
+/**
+ * @brief DiagramMimeData::snapshotFormat
+ * @return the mime type which identify the copy in the clipboard
+ */
+QString DiagramMimeData::snapshotFormat() {
+	return QStringLiteral("application/x-qet-diagram-snapshot");
+}
+
+/**
+ * @brief DiagramMimeData::snapshot
+ * Set @document to the xml document of the copy in @mime_data,
+ * if this copy was made by this instance of QElectroTech and is still in memory.
+ * @param mime_data
+ * @param document
+ * @return true if @document is set, else the xml text of @mime_data must be used.
+ */
+bool DiagramMimeData::snapshot(const QMimeData *mime_data, QDomDocument &document)
+{
+	if (!mime_data || !last_mime_data) {
+		return false;
+	}
+
+		//According to the platform, the clipboard give back our own mime data or a copy
+	if (const DiagramMimeData *dmd = qobject_cast<const DiagramMimeData *>(mime_data))
+	{
+		document = dmd->m_document;
+		return true;
+	}
+	if (mime_data->data(snapshotFormat()) == last_mime_data->m_id)
+	{
+		document = last_mime_data->m_document;
+		return true;
+	}
+	return false;
+}
+
+/**
+ * @brief DiagramMimeData::formats
+ * @return
+ */
+QStringList DiagramMimeData::formats() const {
+	return QStringList{snapshotFormat(), QStringLiteral("text/plain")};
+}
+
+/**
+ * @brief DiagramMimeData::hasFormat
+ * @param mimetype
+ * @return
+ */
+bool DiagramMimeData::hasFormat(const QString &mimetype) const {
+	return formats().contains(mimetype);
+}
+
+/**
+ * @brief DiagramMimeData::retrieveData
+ * The xml text is written at the first request
+ * @param mimetype
+ * @param type
+ * @return
+ */
+QVariant DiagramMimeData::retrieveData(const QString &mimetype, QVariant::Type type) const
+{
+	if (mimetype == snapshotFormat()) {
+		return m_id;
+	}
+	if (mimetype == QLatin1String("text/plain"))
+	{
+		if (m_text.isNull()) {
+			m_text = m_document.toString(4);
+		}
+		return m_text;
+	}
+	return QMimeData::retrieveData(mimetype, type);
+}
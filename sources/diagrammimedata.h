@@ -0,0 +1,54 @@
+/*
+	Copyright 2006-2019 The QElectroTech Team
+	This file is part of QElectroTech.
+	
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+	
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef DIAGRAMMIMEDATA_H
+#define DIAGRAMMIMEDATA_H
+
+#include <QMimeData>
+#include <QDomDocument>
+
+/**
+ * @brief The DiagramMimeData class
+ * Mime data of a copy of diagram items.
+ * The xml document of the copied items is kept as is in memory : a paste in the same
+ * instance of QElectroTech use it directly, without writing and parsing the xml text.
+ * The xml text is only written when another application (or another instance of QElectroTech)
+ * ask for it.
+ */
+class DiagramMimeData : public QMimeData
+{
+	Q_OBJECT
+
+	public:
+		DiagramMimeData(const QDomDocument &document);
+
+		static QString snapshotFormat();
+		static bool snapshot(const QMimeData *mime_data, QDomDocument &document);
+
+		QStringList formats() const override;
+		bool hasFormat(const QString &mimetype) const override;
+
+	protected:
+		QVariant retrieveData(const QString &mimetype, QVariant::Type type) const override;
+
+	private:
+		QDomDocument m_document;
+		QByteArray m_id;
+		mutable QString m_text;
+};
+
+#endif // DIAGRAMMIMEDATA_H
@@ -0,0 +1,141 @@
+/*
+	Copyright 2006-2019 The QElectroTech Team
+	This file is part of QElectroTech.
+
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "diagrampicturecache.h"
+#include "qetproject.h"
+#include "diagram.h"
+
+#include <QUndoStack>
+
+/**
+ * @brief DiagramPictureCache::cache
+ * @param project
+ * @return the cache of @project, the cache is created if needed
+ * and destroyed with @project.
+ */
+DiagramPictureCache *DiagramPictureCache::cache(QETProject *project)
+{
+	DiagramPictureCache *cache = project->findChild<DiagramPictureCache *>(QString(), Qt::FindDirectChildrenOnly);
+	if (!cache) {
+		cache = new DiagramPictureCache(project);
+	}
+	return cache;
+}
+
+/**
+ * @brief DiagramPictureCache::DiagramPictureCache
+ * @param project
+ */
+DiagramPictureCache::DiagramPictureCache(QETProject *project) :
+	QObject(project)
+{
+	connect(project->undoStack(), &QUndoStack::indexChanged, this, &DiagramPictureCache::clear);
+	connect(project, &QETProject::projectInformationsChanged,         this, &DiagramPictureCache::clear);
+	connect(project, &QETProject::projectTitleChanged,                this, &DiagramPictureCache::clear);
+	connect(project, &QETProject::diagramAdded,                       this, &DiagramPictureCache::clear);
+	connect(project, &QETProject::projectDiagramsOrderChanged,        this, &DiagramPictureCache::clear);
+	connect(project, &QETProject::XRefPropertiesChanged,              this, &DiagramPictureCache::clear);
+	connect(project, &QETProject::reportPropertiesChanged,            this, &DiagramPictureCache::clear);
+	connect(project, &QETProject::defaultTitleBlockPropertiesChanged, this, &DiagramPictureCache::clear);
+	connect(project, &QETProject::diagramRemoved, [this](QETProject *, Diagram *diagram) {
+		clear();
+		m_connected_diagrams.remove(diagram);
+	});
+}
+
+/**
+ * @brief DiagramPictureCache::picture
+ * @param diagram : the recorded folio
+ * @param options : the options used to render the folio
+ * @param rect : the rendered area of the folio
+ * @param picture : set to the recording of @diagram
+ * @return true if a recording of @diagram with @options and @rect is available.
+ */
+bool DiagramPictureCache::picture(Diagram *diagram, const ExportProperties &options, const QRect &rect, QPicture &picture) const
+{
+	auto it = m_entries.constFind(diagram);
+	if (it == m_entries.constEnd() ||
+		it->rect != rect ||
+		it->background != Diagram::background_color ||
+		!sameOptions(it->options, options)) {
+		return false;
+	}
+
+	picture = it->picture;
+	return true;
+}
+
+/**
+ * @brief DiagramPictureCache::insert
+ * Keep @picture as recording of @diagram rendered with @options
+ * @param diagram
+ * @param options
+ * @param rect
+ * @param picture
+ */
+void DiagramPictureCache::insert(Diagram *diagram, const ExportProperties &options, const QRect &rect, const QPicture &picture)
+{
+	Entry entry;
+	entry.options    = options;
+	entry.rect       = rect;
+	entry.background = Diagram::background_color;
+	entry.picture    = picture;
+	m_entries.insert(diagram, entry);
+
+	if (!m_connected_diagrams.contains(diagram))
+	{
+		m_connected_diagrams.insert(diagram);
+		auto remove_diagram = [this, diagram]() {remove(diagram);};
+		connect(diagram, &Diagram::diagramTitleChanged,                   this, remove_diagram);
+		connect(diagram, &Diagram::usedTitleBlockTemplateChanged,         this, remove_diagram);
+		connect(&diagram->border_and_titleblock, &BorderTitleBlock::informationChanged,     this, remove_diagram);
+		connect(&diagram->border_and_titleblock, &BorderTitleBlock::titleBlockFolioChanged, this, remove_diagram);
+		connect(&diagram->border_and_titleblock, &BorderTitleBlock::borderChanged,          this, remove_diagram);
+		connect(&diagram->border_and_titleblock, &BorderTitleBlock::displayChanged,         this, remove_diagram);
+	}
+}
+
+/**
+ * @brief DiagramPictureCache::remove
+ * Drop the recording of @diagram
+ * @param diagram
+ */
+void DiagramPictureCache::remove(Diagram *diagram) {
+	m_entries.remove(diagram);
+}
+
+/**
+ * @brief DiagramPictureCache::clear
+ * Drop every recordings
+ */
+void DiagramPictureCache::clear() {
+	m_entries.clear();
+}
+
+/**
+ * @brief DiagramPictureCache::sameOptions
+ * @return true if @a and @b render a folio the same way
+ */
+bool DiagramPictureCache::sameOptions(const ExportProperties &a, const ExportProperties &b)
+{
+	return a.draw_grid               == b.draw_grid &&
+		   a.draw_border             == b.draw_border &&
+		   a.draw_titleblock         == b.draw_titleblock &&
+		   a.draw_terminals          == b.draw_terminals &&
+		   a.draw_colored_conductors == b.draw_colored_conductors &&
+		   a.exported_area           == b.exported_area;
+}
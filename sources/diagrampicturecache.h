@@ -0,0 +1,72 @@
+/*
+	Copyright 2006-2019 The QElectroTech Team
+	This file is part of QElectroTech.
+
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef DIAGRAMPICTURECACHE_H
+#define DIAGRAMPICTURECACHE_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QPicture>
+#include <QColor>
+
+#include "exportproperties.h"
+
+class QETProject;
+class Diagram;
+
+/**
+ * @brief The DiagramPictureCache class
+ * Keep the recording (QPicture) of the folios of a project, as rendered for
+ * printing with given ExportProperties, so a folio printed on several pages
+ * or printed several times is rendered only once.
+ * A recording is dropped as soon as its folio can have changed :
+ * when the title block or the border of the folio change, and for every
+ * folio of the project when the undo stack of the project change
+ * or when the folios or the properties of the project change.
+ * There is one cache per project, retrieved with DiagramPictureCache::cache().
+ */
+class DiagramPictureCache : public QObject
+{
+	Q_OBJECT
+
+	public:
+		static DiagramPictureCache *cache(QETProject *project);
+
+		bool picture(Diagram *diagram, const ExportProperties &options, const QRect &rect, QPicture &picture) const;
+		void insert(Diagram *diagram, const ExportProperties &options, const QRect &rect, const QPicture &picture);
+		void remove(Diagram *diagram);
+		void clear();
+
+	private:
+		DiagramPictureCache(QETProject *project);
+		static bool sameOptions(const ExportProperties &a, const ExportProperties &b);
+
+	private:
+		struct Entry
+		{
+			ExportProperties options;
+			QRect rect;
+			QColor background;
+			QPicture picture;
+		};
+
+		QHash<Diagram *, Entry> m_entries;
+		QSet<Diagram *> m_connected_diagrams;
+};
+
+#endif // DIAGRAMPICTURECACHE_H
@@ -22,9 +22,11 @@
 #include "exportproperties.h"
 #include "qeticons.h"
 #include "qetmessagebox.h"
+#include "diagrampicturecache.h"
 
 #include <QPrinter>
 #include <QPrintDialog>
+#include "qettrace.h"
 
 /**
 	Constructeur
@@ -353,6 +355,7 @@ void DiagramPrintDialog::browseFilePrintTypeDialog() {
 	@param options Options de rendu
 */
 void DiagramPrintDialog::print(const QList<Diagram *> &diagrams, bool fit_page, const ExportProperties& options) {
+	QET_TRACE("DiagramPrintDialog::print");
 	//qDebug() << "Demande d'impression de " << diagrams.count() << "schemas.";
 #if QT_VERSION >= QT_VERSION_CHECK(5, 6, 0)
     #ifdef Q_OS_WIN
@@ -400,6 +403,7 @@ void DiagramPrintDialog::print(const QList<Diagram *> &diagrams, bool fit_page,
 	@param printer Imprimante a utiliser
 */
 void DiagramPrintDialog::printDiagram(Diagram *diagram, bool fit_page, const ExportProperties &options, QPainter *qp, QPrinter *printer) {
+	QET_TRACE("DiagramPrintDialog::printDiagram");
 	//qDebug() << printer -> paperSize() << printer -> paperRect() << diagram -> title();
 	// l'imprimante utilise-t-elle toute la feuille ?
 	bool full_page = printer -> fullPage();
@@ -409,30 +413,21 @@ void DiagramPrintDialog::printDiagram(Diagram *diagram, bool fit_page, const Exp
 		// utiliser cette condition pour agir differemment en cas d'impression physique
 	}
 	
-	saveReloadDiagramParameters(diagram, options, true);
-	
-	// deselectionne tous les elements
-	QList<QGraphicsItem *> selected_elmts = diagram -> selectedItems();
-	foreach (QGraphicsItem *qgi, selected_elmts) qgi -> setSelected(false);
-	
-	// enleve le flag focusable de tous les elements concernes pour eviter toute reprise de focus par un champ de texte editable
-	QList<QGraphicsItem *> focusable_items;
-	foreach (QGraphicsItem *qgi, diagram -> items()) {
-		if (qgi -> flags() & QGraphicsItem::ItemIsFocusable) {
-			focusable_items << qgi;
-			qgi -> setFlag(QGraphicsItem::ItemIsFocusable, false);
-		}
-	}
+	QRect diagram_rect = diagramRect(diagram, options);
 	
-	// evite toute autre forme d'interaction
-	foreach (QGraphicsView *view, diagram -> views()) {
-		view -> setInteractive(false);
+	// le schema est enregistre une seule fois, puis rejoue pour chaque page ;
+	// l'enregistrement est conserve tant que le schema n'est pas modifie
+	QPicture picture;
+	DiagramPictureCache *cache = DiagramPictureCache::cache(project_);
+	if (!cache -> picture(diagram, options, diagram_rect, picture)) {
+		picture = recordDiagram(diagram, options, diagram_rect);
+		cache -> insert(diagram, options, diagram_rect, picture);
 	}
 	
-	QRect diagram_rect = diagramRect(diagram, options);
 	if (fit_page) {
 		// impression adaptee sur une seule page
-		diagram -> render(qp, QRectF(), diagram_rect, Qt::KeepAspectRatio);
+		QRect target_rect(0, 0, qp -> device() -> width(), qp -> device() -> height());
+		playPicture(qp, picture, target_rect, QRect(QPoint(0, 0), diagram_rect.size()));
 	} else {
 		// impression sur une ou plusieurs pages
 		QRect printed_area = full_page ? printer -> paperRect() : printer -> pageRect();
@@ -481,17 +476,53 @@ void DiagramPrintDialog::printDiagram(Diagram *diagram, bool fit_page, const Exp
 		for (int i = 0 ; i < pages_to_print.count() ; ++ i) {
 			QRect current_rect(pages_to_print.at(i));
 			//qDebug() << "    " << current_rect;
-			diagram -> render(
-				qp,
-				QRect(QPoint(0,0), current_rect.size()),
-				current_rect.translated(diagram_rect.topLeft()),
-				Qt::KeepAspectRatio
-			);
+			playPicture(qp, picture, QRect(QPoint(0,0), current_rect.size()), current_rect);
 			if (i != pages_to_print.count() - 1) {
 				printer -> newPage();
 			}
 		}
 	}
+}
+
+/**
+	Enregistre le rendu d'un schema dans une QPicture
+	@param diagram Schema a enregistrer
+	@param options Options de rendu a appliquer
+	@param diagram_rect Zone du schema a enregistrer
+	@return l'enregistrement, dont l'origine correspond au coin superieur
+	gauche de diagram_rect
+*/
+QPicture DiagramPrintDialog::recordDiagram(Diagram *diagram, const ExportProperties &options, const QRect &diagram_rect) {
+	diagram -> materialize();
+	saveReloadDiagramParameters(diagram, options, true);
+	
+	// deselectionne tous les elements
+	QList<QGraphicsItem *> selected_elmts = diagram -> selectedItems();
+	foreach (QGraphicsItem *qgi, selected_elmts) qgi -> setSelected(false);
+	
+	// enleve le flag focusable de tous les elements concernes pour eviter toute reprise de focus par un champ de texte editable
+	QList<QGraphicsItem *> focusable_items;
+	foreach (QGraphicsItem *qgi, diagram -> items()) {
+		if (qgi -> flags() & QGraphicsItem::ItemIsFocusable) {
+			focusable_items << qgi;
+			qgi -> setFlag(QGraphicsItem::ItemIsFocusable, false);
+		}
+	}
+	
+	// evite toute autre forme d'interaction
+	foreach (QGraphicsView *view, diagram -> views()) {
+		view -> setInteractive(false);
+	}
+	
+	QPicture picture;
+	QPainter picture_painter(&picture);
+	diagram -> render(
+		&picture_painter,
+		QRectF(QPointF(0, 0), diagram_rect.size()),
+		diagram_rect,
+		Qt::KeepAspectRatio
+	);
+	picture_painter.end();
 	
 	// remet en place les interactions
 	foreach (QGraphicsView *view, diagram -> views()) {
@@ -507,6 +538,33 @@ void DiagramPrintDialog::printDiagram(Diagram *diagram, bool fit_page, const Exp
 	foreach (QGraphicsItem *qgi, selected_elmts) qgi -> setSelected(true);
 	
 	saveReloadDiagramParameters(diagram, options, false);
+	
+	return(picture);
+}
+
+/**
+	Rejoue une partie de l'enregistrement d'un schema
+	@param qp QPainter a utiliser
+	@param picture Enregistrement du schema
+	@param target Zone du peripherique dans laquelle dessiner
+	@param source Zone de l'enregistrement a dessiner ; elle est mise a
+	l'echelle pour tenir dans target en conservant ses proportions
+*/
+void DiagramPrintDialog::playPicture(QPainter *qp, const QPicture &picture, const QRect &target, const QRect &source) {
+	if (source.isEmpty() || target.isEmpty()) return;
+	
+	qreal ratio = qMin(
+		qreal(target.width())  / source.width(),
+		qreal(target.height()) / source.height()
+	);
+	
+	qp -> save();
+	qp -> setClipRect(target, Qt::IntersectClip);
+	qp -> translate(target.topLeft());
+	qp -> scale(ratio, ratio);
+	qp -> translate(-source.topLeft());
+	qp -> drawPicture(0, 0, picture);
+	qp -> restore();
 }
 
 /**
@@ -57,6 +57,8 @@ class DiagramPrintDialog : public QWidget
 	void buildPrintTypeDialog();
 	void buildDialog();
 	void saveReloadDiagramParameters(Diagram *, const ExportProperties&, bool);
+	QPicture recordDiagram(Diagram *, const ExportProperties &, const QRect &);
+	void playPicture(QPainter *, const QPicture &, const QRect &, const QRect &);
 	void savePageSetupForCurrentPrinter();
 	void loadPageSetupForCurrentPrinter();
 	QString settingsSectionName(const QPrinter *);
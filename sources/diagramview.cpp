@@ -45,6 +45,12 @@
 #include "multipastedialog.h"
 #include "changetitleblockcommand.h"
 #include "conductorcreator.h"
+#include "diagrammimedata.h"
+
+namespace {
+		///Value of the setting "diagrameditor/zoom-out-beyond-of-folio", -1 when not yet read
+	int zoom_out_beyond_of_folio = -1;
+}
 
 /**
 	Constructeur
@@ -73,7 +79,6 @@ DiagramView::DiagramView(Diagram *diagram, QWidget *parent) :
 	setRenderHint(QPainter::SmoothPixmapTransform, true);
 
 	setScene(m_diagram);
-	m_diagram -> undoStack().setClean();
 	setWindowIcon(QET::Icons::QETLogo);
 	setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
 	setResizeAnchor(QGraphicsView::AnchorUnderMouse);
@@ -81,8 +86,6 @@ DiagramView::DiagramView(Diagram *diagram, QWidget *parent) :
 	setSelectionMode();
 	adjustSceneRect();
 	updateWindowTitle();
-	m_diagram->loadElmtFolioSeq();
-	m_diagram->loadCndFolioSeq();
 	
 	m_paste_here = new QAction(QET::Icons::EditPaste, tr("Coller ici", "context menu action"), this);
 	connect(m_paste_here, SIGNAL(triggered()), this, SLOT(pasteHere()));
@@ -101,7 +104,7 @@ DiagramView::DiagramView(Diagram *diagram, QWidget *parent) :
 	}
 
 	connect(m_diagram, SIGNAL(showDiagram(Diagram*)), this, SIGNAL(showDiagram(Diagram*)));
-	connect(m_diagram, SIGNAL(selectionChanged()), this, SIGNAL(selectionChanged()));
+	connect(m_diagram, SIGNAL(compressedSelectionChanged()), this, SIGNAL(selectionChanged()));
 	connect(m_diagram, SIGNAL(sceneRectChanged(QRectF)), this, SLOT(adjustSceneRect()));
 	connect(&(m_diagram -> border_and_titleblock), SIGNAL(diagramTitleChanged(const QString &)), this, SLOT(updateWindowTitle()));
 	connect(diagram, SIGNAL(editElementRequired(ElementsLocation)), this, SIGNAL(editElementRequired(ElementsLocation)));
@@ -298,8 +301,7 @@ void DiagramView::zoom(const qreal zoom_factor)
 	}
 	else
 	{
-		QSettings settings;
-		if (settings.value("diagrameditor/zoom-out-beyond-of-folio", false).toBool() ||
+		if (zoomOutBeyondOfFolio() ||
 			(horizontalScrollBar()->maximum() || verticalScrollBar()->maximum()) )
 			if (zoom_factor >= 0){
 				scale(zoom_factor, zoom_factor);
@@ -352,9 +354,9 @@ void DiagramView::cut() {
 */
 void DiagramView::copy() {
 	QClipboard *presse_papier = QApplication::clipboard();
-	QString contenu_presse_papier = m_diagram -> toXml(false).toString(4);
-	if (presse_papier -> supportsSelection()) presse_papier -> setText(contenu_presse_papier, QClipboard::Selection);
-	presse_papier -> setText(contenu_presse_papier);
+	QDomDocument contenu_presse_papier = m_diagram -> toXml(false);
+	if (presse_papier -> supportsSelection()) presse_papier -> setMimeData(new DiagramMimeData(contenu_presse_papier), QClipboard::Selection);
+	presse_papier -> setMimeData(new DiagramMimeData(contenu_presse_papier));
 }
 
 /**
@@ -366,11 +368,14 @@ void DiagramView::copy() {
 void DiagramView::paste(const QPointF &pos, QClipboard::Mode clipboard_mode) {
 	if (!isInteractive() || m_diagram -> isReadOnly()) return;
 
-	QString texte_presse_papier = QApplication::clipboard() -> text(clipboard_mode);
-	if ((texte_presse_papier).isEmpty()) return;
-
+		//A copy made by this instance of QElectroTech is pasted without parsing the xml text
 	QDomDocument document_xml;
-	if (!document_xml.setContent(texte_presse_papier)) return;
+	if (!DiagramMimeData::snapshot(QApplication::clipboard() -> mimeData(clipboard_mode), document_xml))
+	{
+		QString texte_presse_papier = QApplication::clipboard() -> text(clipboard_mode);
+		if ((texte_presse_papier).isEmpty()) return;
+		if (!document_xml.setContent(texte_presse_papier)) return;
+	}
 
 	DiagramContent content_pasted;
 	m_diagram->fromXml(document_xml, pos, false, &content_pasted);
@@ -838,8 +843,7 @@ void DiagramView::adjustSceneRect()
 	QRectF scene_rect = m_diagram->sceneRect();
 	scene_rect.adjust(-Diagram::margin, -Diagram::margin, Diagram::margin, Diagram::margin);
 	
-	QSettings settings;
-	if (settings.value("diagrameditor/zoom-out-beyond-of-folio", false).toBool())
+	if (zoomOutBeyondOfFolio())
 	{
 			//When zoom out beyong of folio is active,
 			//we always adjust the scene rect to be 1/3 bigger than the wiewport
@@ -850,6 +854,29 @@ void DiagramView::adjustSceneRect()
 	setSceneRect(scene_rect);
 }
 
+/**
+ * @brief DiagramView::zoomOutBeyondOfFolio
+ * The setting is read once, instead of at each zoom and each adjustment of the scene rect.
+ * @return true if the user allow to zoom out beyond of the folio
+ */
+bool DiagramView::zoomOutBeyondOfFolio()
+{
+	if (zoom_out_beyond_of_folio < 0)
+	{
+		QSettings settings;
+		zoom_out_beyond_of_folio = settings.value("diagrameditor/zoom-out-beyond-of-folio", false).toBool() ? 1 : 0;
+	}
+	return zoom_out_beyond_of_folio == 1;
+}
+
+/**
+ * @brief DiagramView::reloadSettings
+ * Must be called when the settings used by the diagram views are changed
+ */
+void DiagramView::reloadSettings() {
+	zoom_out_beyond_of_folio = -1;
+}
+
 /**
 	Met a jour le titre du widget
 */
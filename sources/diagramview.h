@@ -69,6 +69,8 @@ class DiagramView : public QGraphicsView
 		void editSelection();
 		void setEventInterface (DVEventInterface *event_interface);
 		QList<QAction *> contextMenuActions() const;
+		static bool zoomOutBeyondOfFolio();
+		static void reloadSettings();
 	
 	protected:
 		void mouseDoubleClickEvent(QMouseEvent *) override;
@@ -0,0 +1,448 @@
+/*
+	Copyright 2006-2019 The QElectroTech Team
+	This file is part of QElectroTech.
+
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "elementpartsmodel.h"
+#include "customelementpart.h"
+#include "partterminal.h"
+
+#include <QGraphicsItem>
+#include <algorithm>
+
+/**
+	Above this number of pending additions / removals, the model is reset
+	instead of being updated row by row.
+*/
+#define QET_PARTS_MODEL_RESET_THRESHOLD 64
+
+namespace {
+	/**
+	 * @brief appendRows
+	 * Append to @selection the rows of @rows, contiguous rows are merged in a single range.
+	 * @param model
+	 * @param rows
+	 * @param selection
+	 */
+	void appendRows(const QAbstractItemModel *model, QVector<int> &rows, QItemSelection &selection)
+	{
+		if (rows.isEmpty()) {
+			return;
+		}
+
+		std::sort(rows.begin(), rows.end());
+		int first = rows.first();
+		int last = first;
+		for (int i = 1 ; i < rows.size() ; ++i)
+		{
+			if (rows.at(i) == last + 1) {
+				last = rows.at(i);
+				continue;
+			}
+			selection.append(QItemSelectionRange(model->index(first, 0), model->index(last, 0)));
+			first = last = rows.at(i);
+		}
+		selection.append(QItemSelectionRange(model->index(first, 0), model->index(last, 0)));
+	}
+}
+
+/**
+ * @brief ElementPartsModel::Key::operator <
+ * @param other
+ * @return true if this key is stacked under @other
+ */
+bool ElementPartsModel::Key::operator<(const ElementPartsModel::Key &other) const
+{
+	if (terminal != other.terminal) {
+		return other.terminal;
+	}
+	if (z != other.z) {
+		return z < other.z;
+	}
+	return sequence < other.sequence;
+}
+
+/**
+ * @brief ElementPartsModel::ElementPartsModel
+ * @param parent
+ */
+ElementPartsModel::ElementPartsModel(QObject *parent) :
+	QAbstractListModel(parent)
+{}
+
+ElementPartsModel::~ElementPartsModel()
+{}
+
+/**
+ * @brief ElementPartsModel::rowCount
+ * @param parent
+ * @return the number of listed parts
+ */
+int ElementPartsModel::rowCount(const QModelIndex &parent) const
+{
+	if (parent.isValid()) {
+		return 0;
+	}
+	return m_entries.size();
+}
+
+/**
+ * @brief ElementPartsModel::data
+ * The name of the part is only asked for the displayed rows, so the cost
+ * of the model don't depend of the number of parts.
+ * @param index
+ * @param role
+ * @return
+ */
+QVariant ElementPartsModel::data(const QModelIndex &index, int role) const
+{
+	QGraphicsItem *part = partFromIndex(index);
+	if (!part) {
+		return QVariant();
+	}
+
+	if (role == Qt::DisplayRole)
+	{
+		if (CustomElementPart *cep = dynamic_cast<CustomElementPart *>(part)) {
+			return cep->name();
+		}
+	}
+	else if (role == PartRole)
+	{
+		QVariant v;
+		v.setValue<QGraphicsItem *>(part);
+		return v;
+	}
+
+	return QVariant();
+}
+
+/**
+ * @brief ElementPartsModel::partFromIndex
+ * @param index
+ * @return the part at @index or nullptr if @index is not valid
+ * or if the part is about to be removed from the model
+ */
+QGraphicsItem *ElementPartsModel::partFromIndex(const QModelIndex &index) const
+{
+	if (!index.isValid() || index.row() >= m_entries.size()) {
+		return nullptr;
+	}
+
+	QGraphicsItem *part = m_entries.at(indexOfRow(index.row())).part;
+		//The part is perhaps already deleted
+	if (m_to_remove.contains(part)) {
+		return nullptr;
+	}
+	return part;
+}
+
+/**
+ * @brief ElementPartsModel::indexFromPart
+ * @param part
+ * @return the index of @part or an invalid index if @part isn't listed
+ */
+QModelIndex ElementPartsModel::indexFromPart(QGraphicsItem *part) const
+{
+	if (!m_keys.contains(part) || m_to_remove.contains(part)) {
+		return QModelIndex();
+	}
+
+	int i = indexOfKey(m_keys.value(part));
+	if (i < 0) {
+		return QModelIndex();
+	}
+	return index(rowOfIndex(i), 0);
+}
+
+/**
+ * @brief ElementPartsModel::partAdded
+ * @param part : part added to the scene
+ */
+void ElementPartsModel::partAdded(QGraphicsItem *part)
+{
+	if ((m_keys.contains(part) && !m_to_remove.contains(part)) ||
+		m_to_add_set.contains(part)) {
+		return;
+	}
+
+	m_to_add << part;
+	m_to_add_set.insert(part);
+	scheduleUpdate();
+}
+
+/**
+ * @brief ElementPartsModel::partRemoved
+ * @param part : part removed from the scene or about to be deleted
+ */
+void ElementPartsModel::partRemoved(QGraphicsItem *part)
+{
+	m_selection_changed.remove(part);
+	m_to_add_set.remove(part);
+	if (m_keys.contains(part)) {
+		m_to_remove.insert(part);
+	}
+	scheduleUpdate();
+}
+
+/**
+ * @brief ElementPartsModel::partZValueChanged
+ * The part is moved to its new row
+ * @param part
+ */
+void ElementPartsModel::partZValueChanged(QGraphicsItem *part)
+{
+	if (!m_keys.contains(part) || m_to_remove.contains(part)) {
+		return;
+	}
+
+	m_to_remove.insert(part);
+	m_to_add << part;
+	m_to_add_set.insert(part);
+	m_selection_changed.insert(part);
+	scheduleUpdate();
+}
+
+/**
+ * @brief ElementPartsModel::partSelectionChanged
+ * Remember that the selection state of @part changed,
+ * the change is retrieved by takeSelectionChanges()
+ * @param part
+ */
+void ElementPartsModel::partSelectionChanged(QGraphicsItem *part) {
+	m_selection_changed.insert(part);
+}
+
+/**
+ * @brief ElementPartsModel::clear
+ * Remove every parts of the model
+ */
+void ElementPartsModel::clear()
+{
+	beginResetModel();
+	m_entries.clear();
+	m_keys.clear();
+	m_to_add.clear();
+	m_to_add_set.clear();
+	m_to_remove.clear();
+	m_selection_changed.clear();
+	endResetModel();
+}
+
+/**
+ * @brief ElementPartsModel::takeSelectionChanges
+ * Apply the pending changes and fill @selected and @deselected with the rows
+ * whose the selection state changed since the last call of this method.
+ * @param selected
+ * @param deselected
+ */
+void ElementPartsModel::takeSelectionChanges(QItemSelection &selected, QItemSelection &deselected)
+{
+	applyPendingChanges();
+
+	QVector<int> selected_rows, deselected_rows;
+	for (QGraphicsItem *part : m_selection_changed)
+	{
+		if (!m_keys.contains(part)) {
+			continue;
+		}
+
+		int i = indexOfKey(m_keys.value(part));
+		if (i < 0) {
+			continue;
+		}
+
+		if (part->isSelected()) {
+			selected_rows << rowOfIndex(i);
+		} else {
+			deselected_rows << rowOfIndex(i);
+		}
+	}
+	m_selection_changed.clear();
+
+	appendRows(this, selected_rows, selected);
+	appendRows(this, deselected_rows, deselected);
+}
+
+/**
+ * @brief ElementPartsModel::applyPendingChanges
+ * Apply to the model the additions, removals and zValue changes
+ * notified since the last call.
+ */
+void ElementPartsModel::applyPendingChanges()
+{
+	m_update_scheduled = false;
+	if (m_to_add.isEmpty() && m_to_remove.isEmpty()) {
+		return;
+	}
+
+	QList<QGraphicsItem *> added;
+	for (QGraphicsItem *part : m_to_add) {
+		if (m_to_add_set.remove(part)) {
+			added << part;
+		}
+	}
+	m_to_add.clear();
+
+	if (added.size() + m_to_remove.size() > QET_PARTS_MODEL_RESET_THRESHOLD) {
+		applyAtOnce(added);
+	} else {
+		applyOneByOne(added);
+	}
+}
+
+/**
+ * @brief ElementPartsModel::keyForPart
+ * @param part
+ * @return a new sort key for @part
+ */
+ElementPartsModel::Key ElementPartsModel::keyForPart(QGraphicsItem *part)
+{
+	Key key;
+	key.terminal = part->type() == PartTerminal::Type;
+	key.z = part->zValue();
+	key.sequence = ++m_sequence;
+	return key;
+}
+
+/**
+ * @brief ElementPartsModel::indexOfKey
+ * @param key
+ * @return the index in m_entries of the entry with the key @key, or -1
+ */
+int ElementPartsModel::indexOfKey(const ElementPartsModel::Key &key) const
+{
+	auto it = std::lower_bound(m_entries.constBegin(), m_entries.constEnd(), key,
+							   [](const Entry &entry, const Key &k) {return entry.key < k;});
+	if (it == m_entries.constEnd() || it->key.sequence != key.sequence) {
+		return -1;
+	}
+	return int(it - m_entries.constBegin());
+}
+
+/**
+ * @brief ElementPartsModel::scheduleUpdate
+ * Apply the pending changes at the next turn of the event loop
+ */
+void ElementPartsModel::scheduleUpdate()
+{
+	if (m_update_scheduled) {
+		return;
+	}
+	m_update_scheduled = true;
+	QMetaObject::invokeMethod(this, "applyScheduledChanges", Qt::QueuedConnection);
+}
+
+/**
+ * @brief ElementPartsModel::applyScheduledChanges
+ * Apply the pending changes at the turn of the event loop, if they weren't
+ * already applied by the editor, and notify it.
+ */
+void ElementPartsModel::applyScheduledChanges()
+{
+	if (!m_update_scheduled) {
+		return;
+	}
+	applyPendingChanges();
+	emit pendingChangesApplied();
+}
+
+/**
+ * @brief ElementPartsModel::applyOneByOne
+ * Apply the pending changes row by row, used when only few parts changed
+ * @param added
+ */
+void ElementPartsModel::applyOneByOne(const QList<QGraphicsItem *> &added)
+{
+	for (QGraphicsItem *part : m_to_remove)
+	{
+		int i = indexOfKey(m_keys.take(part));
+		if (i < 0) {
+			continue;
+		}
+		int row = rowOfIndex(i);
+		beginRemoveRows(QModelIndex(), row, row);
+		m_entries.remove(i);
+		endRemoveRows();
+	}
+	m_to_remove.clear();
+
+	for (QGraphicsItem *part : added)
+	{
+		Entry entry;
+		entry.part = part;
+		entry.key = keyForPart(part);
+
+		auto it = std::upper_bound(m_entries.constBegin(), m_entries.constEnd(), entry.key,
+								   [](const Key &k, const Entry &e) {return k < e.key;});
+		int i = int(it - m_entries.constBegin());
+		int row = m_entries.size() - i;
+
+		beginInsertRows(QModelIndex(), row, row);
+		m_entries.insert(i, entry);
+		m_keys.insert(part, entry.key);
+		endInsertRows();
+
+		if (part->isSelected()) {
+			m_selection_changed.insert(part);
+		}
+	}
+}
+
+/**
+ * @brief ElementPartsModel::applyAtOnce
+ * Apply the pending changes in one pass and reset the model,
+ * used when a lot of parts changed (loading, paste, delete of a big selection...)
+ * @param added
+ */
+void ElementPartsModel::applyAtOnce(const QList<QGraphicsItem *> &added)
+{
+	beginResetModel();
+
+	QVector<Entry> entries;
+	entries.reserve(m_entries.size() + added.size());
+	for (const Entry &entry : m_entries)
+	{
+		if (m_to_remove.contains(entry.part)) {
+			m_keys.remove(entry.part);
+		} else {
+			entries << entry;
+		}
+	}
+	m_to_remove.clear();
+
+	for (QGraphicsItem *part : added)
+	{
+		Entry entry;
+		entry.part = part;
+		entry.key = keyForPart(part);
+		entries << entry;
+		m_keys.insert(part, entry.key);
+	}
+
+	std::sort(entries.begin(), entries.end(),
+			  [](const Entry &a, const Entry &b) {return a.key < b.key;});
+	m_entries = entries;
+
+	endResetModel();
+
+		//The reset cleared the selection of the views
+	m_selection_changed.clear();
+	for (const Entry &entry : m_entries) {
+		if (entry.part->isSelected()) {
+			m_selection_changed.insert(entry.part);
+		}
+	}
+}
@@ -0,0 +1,112 @@
+/*
+	Copyright 2006-2019 The QElectroTech Team
+	This file is part of QElectroTech.
+
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef ELEMENTPARTSMODEL_H
+#define ELEMENTPARTSMODEL_H
+
+#include <QAbstractListModel>
+#include <QItemSelection>
+#include <QVector>
+#include <QHash>
+#include <QSet>
+
+class QGraphicsItem;
+
+/**
+ * @brief The ElementPartsModel class
+ * List model of the primitives of an ElementScene, ordered like they are
+ * stacked in the scene (terminals first, then the others parts from the top
+ * most to the bottom most).
+ * The model is not rebuilt from the scene : the scene notify it each time a
+ * part is added, removed, change of zValue or of selection state
+ * (see ElementScene::notifyPartChange) and the model only apply the changes.
+ * Changes are gathered and applied at once by applyPendingChanges(), which is
+ * called by the editor and, at worst, at the next turn of the event loop.
+ * In the latter case pendingChangesApplied() is emitted, so the views can
+ * restore the selection of the added rows (a reset clears it).
+ */
+class ElementPartsModel : public QAbstractListModel
+{
+	Q_OBJECT
+
+	public:
+		enum Role {
+			PartRole = Qt::UserRole + 1
+		};
+
+		ElementPartsModel(QObject *parent = nullptr);
+		~ElementPartsModel() override;
+
+		int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+		QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+		QGraphicsItem *partFromIndex(const QModelIndex &index) const;
+		QModelIndex indexFromPart(QGraphicsItem *part) const;
+
+		void partAdded(QGraphicsItem *part);
+		void partRemoved(QGraphicsItem *part);
+		void partZValueChanged(QGraphicsItem *part);
+		void partSelectionChanged(QGraphicsItem *part);
+
+		void clear();
+		void takeSelectionChanges(QItemSelection &selected, QItemSelection &deselected);
+
+	signals:
+			///Emitted after the changes were applied at the turn of the event loop
+		void pendingChangesApplied();
+
+	public slots:
+		void applyPendingChanges();
+
+	private slots:
+		void applyScheduledChanges();
+
+	private:
+			///Sort key of a part, the model is sorted from the bottom most part to the top most.
+		struct Key
+		{
+			bool terminal;
+			qreal z;
+			quint64 sequence;
+			bool operator<(const Key &other) const;
+		};
+		struct Entry
+		{
+			QGraphicsItem *part;
+			Key key;
+		};
+
+		Key keyForPart(QGraphicsItem *part);
+		int indexOfKey(const Key &key) const;
+		int rowOfIndex(int index) const {return m_entries.size() - 1 - index;}
+		int indexOfRow(int row) const {return m_entries.size() - 1 - row;}
+		void scheduleUpdate();
+		void applyOneByOne(const QList<QGraphicsItem *> &added);
+		void applyAtOnce(const QList<QGraphicsItem *> &added);
+
+	private:
+		QVector<Entry> m_entries;
+		QHash<QGraphicsItem *, Key> m_keys;
+		QList<QGraphicsItem *> m_to_add;
+		QSet<QGraphicsItem *> m_to_add_set,
+							  m_to_remove,
+							  m_selection_changed;
+		quint64 m_sequence = 0;
+		bool m_update_scheduled = false;
+};
+
+#endif // ELEMENTPARTSMODEL_H
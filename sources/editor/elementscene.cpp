@@ -35,6 +35,7 @@
 #include "QPropertyUndoCommand/qpropertyundocommand.h"
 #include "namelistdialog.h"
 #include "namelistwidget.h"
+#include "elementpartsmodel.h"
 
 #include <algorithm>
 #include <QKeyEvent>
@@ -58,6 +59,7 @@ ElementScene::ElementScene(QETElementEditor *editor, QObject *parent) :
 		//http://tech-artists.org/t/qt-properly-removing-qgraphicitems/3063
 	
 	m_behavior = Normal;
+	m_parts_model = new ElementPartsModel(this);
 	setItemIndexMethod(NoIndex);
 	setGrid(1, 1);
 	initPasteArea();
@@ -590,6 +592,52 @@ void ElementScene::setElementInfo(const DiagramContext& dc)
 	}
 }
 
+/**
+ * @brief ElementScene::partsModel
+ * @return the model listing the parts of this scene
+ */
+ElementPartsModel *ElementScene::partsModel() const {
+	return m_parts_model;
+}
+
+/**
+ * @brief ElementScene::notifyPartChange
+ * Must be called by the itemChange method of each primitive, to keep up to date
+ * the parts model of the element scene that contains @part.
+ * The model is called directly instead of through a signal, because
+ * the scene signals are often blocked when parts are added or removed.
+ * @param part : the primitive that changes
+ * @param change
+ * @param value
+ */
+void ElementScene::notifyPartChange(QGraphicsItem *part, QGraphicsItem::GraphicsItemChange change, const QVariant &value)
+{
+	Q_UNUSED(value)
+		//When the change is ItemSceneChange, scene() is the old scene
+	ElementScene *scene = qobject_cast<ElementScene *>(part->scene());
+	if (!scene) {
+		return;
+	}
+
+	switch (change)
+	{
+		case QGraphicsItem::ItemSceneChange:
+			scene->m_parts_model->partRemoved(part);
+			break;
+		case QGraphicsItem::ItemSceneHasChanged:
+			scene->m_parts_model->partAdded(part);
+			break;
+		case QGraphicsItem::ItemZValueHasChanged:
+			scene->m_parts_model->partZValueChanged(part);
+			break;
+		case QGraphicsItem::ItemSelectedHasChanged:
+			scene->m_parts_model->partSelectionChanged(part);
+			break;
+		default:
+			break;
+	}
+}
+
 /**
  * @brief ElementScene::slot_select
  * Select the item in content, every others items in the scene are deselected
@@ -656,7 +704,6 @@ void ElementScene::slot_delete() {
 	m_undo_stack.push(new DeletePartsCommand(this, selected_items));
 	
 	// removing items does not trigger QGraphicsScene::selectionChanged()
-	emit(partsRemoved());
 	emit(selectionChanged());
 }
 
@@ -857,6 +904,8 @@ void ElementScene::reset()
 {
 	clearSelection();
 	undoStack().clear();
+		//Clear the model at once instead of removing the parts one by one
+	m_parts_model->clear();
 
 		//We don't add handlers, because it's the role of the primitive or decorator to remove it.
 	QList<QGraphicsItem*> items_list;
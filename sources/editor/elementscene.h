@@ -26,6 +26,7 @@
 
 class CustomElementPart;
 class ElementEditionCommand;
+class ElementPartsModel;
 class ElementPrimitiveDecorator;
 class QETElementEditor;
 class ESEventInterface;
@@ -70,6 +71,7 @@ class ElementScene : public QGraphicsScene
 					   m_elmt_information; /// element kind info
 		QGIManager m_qgi_manager;
 		QUndoStack m_undo_stack;
+		ElementPartsModel *m_parts_model = nullptr;
 
 		ESEventInterface *m_event_interface = nullptr;
 		Behavior m_behavior;
@@ -121,6 +123,8 @@ class ElementScene : public QGraphicsScene
 		void copy();
 		QETElementEditor* editor() const;
 		void setElementInfo(const DiagramContext& dc);
+		ElementPartsModel *partsModel() const;
+		static void notifyPartChange(QGraphicsItem *part, QGraphicsItem::GraphicsItemChange change, const QVariant &value);
 	
 	protected:
 		void mouseMoveEvent         (QGraphicsSceneMouseEvent *) override;
@@ -159,10 +163,6 @@ class ElementScene : public QGraphicsScene
 	signals:
 			/// Signal emitted after one or several parts were added
 		void partsAdded();
-			/// Signal emitted after one or several parts were removed
-		void partsRemoved();
-			/// Signal emitted when the zValue of one or several parts change
-		void partsZValueChanged();
 			/// Signal emitted when users have defined the copy/paste area
 		void pasteAreaDefined(const QRectF &);
 			/// Signal emitted when need zoomFit
@@ -43,8 +43,14 @@ CustomElementGraphicPart::CustomElementGraphicPart(QETElementEditor *editor, QGr
 /**
  * @brief CustomElementGraphicPart::~CustomElementGraphicPart
  * Destructor
+ * A part deleted while still in the scene don't send ItemSceneChange,
+ * so we notify the scene ourself.
  */
-CustomElementGraphicPart::~CustomElementGraphicPart() {}
+CustomElementGraphicPart::~CustomElementGraphicPart()
+{
+	if (scene())
+		ElementScene::notifyPartChange(this, QGraphicsItem::ItemSceneChange, QVariant());
+}
 
 /**
  * @brief CustomElementGraphicPart::drawCross
@@ -409,6 +415,7 @@ QVariant CustomElementGraphicPart::itemChange(GraphicsItemChange change, const Q
 		if (change == QGraphicsItem::ItemPositionChange || change == QGraphicsItem::ItemPositionHasChanged)
 			updateCurrentPartEditor();
 
+	ElementScene::notifyPartChange(this, change, value);
 	return(QGraphicsObject::itemChange(change, value));
 }
 
@@ -204,6 +204,7 @@ QVariant PartArc::itemChange(QGraphicsItem::GraphicsItemChange change, const QVa
 		setSelected(false); //This is item removed from scene, then we deselect this, and so, the handlers is also removed.
 	}
 	
+	ElementScene::notifyPartChange(this, change, value);
 	return QGraphicsItem::itemChange(change, value);
 }
 
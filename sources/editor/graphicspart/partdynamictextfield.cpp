@@ -46,6 +46,17 @@ PartDynamicTextField::PartDynamicTextField(QETElementEditor *editor, QGraphicsIt
 	document()->setDefaultTextOption(option);
 }
 
+/**
+ * @brief PartDynamicTextField::~PartDynamicTextField
+ * A part deleted while still in the scene don't send ItemSceneChange,
+ * so we notify the scene ourself.
+ */
+PartDynamicTextField::~PartDynamicTextField()
+{
+	if (scene())
+		ElementScene::notifyPartChange(this, QGraphicsItem::ItemSceneChange, QVariant());
+}
+
 QString PartDynamicTextField::name() const
 {
 	return tr("Champ de texte dynamique", "element part name");
@@ -493,6 +504,7 @@ QVariant PartDynamicTextField::itemChange(QGraphicsItem::GraphicsItemChange chan
 	else if ((change == QGraphicsItem::ItemSelectedHasChanged) && (value.toBool() == true))
 		updateCurrentPartEditor();
 	
+	ElementScene::notifyPartChange(this, change, value);
 	return(QGraphicsTextItem::itemChange(change, value));
 }
 
@@ -62,6 +62,7 @@ class PartDynamicTextField : public QGraphicsTextItem, public CustomElementPart
 	
 	public:
 		PartDynamicTextField(QETElementEditor *editor, QGraphicsItem *parent = nullptr);
+		~PartDynamicTextField() override;
 		
 		enum {Type = UserType + 1110};
 		int type() const override {return Type;}
@@ -200,6 +200,7 @@ QVariant PartEllipse::itemChange(QGraphicsItem::GraphicsItemChange change, const
 		setSelected(false); //This item is removed from scene, then we deselect this, and so, the handlers is also removed.
 	}
 	
+	ElementScene::notifyPartChange(this, change, value);
 	return QGraphicsItem::itemChange(change, value);
 }
 
@@ -176,6 +176,7 @@ QVariant PartLine::itemChange(QGraphicsItem::GraphicsItemChange change, const QV
 		setSelected(false); //This is item removed from scene, then we deselect this, and so, the handlers is also removed.
 	}
 	
+	ElementScene::notifyPartChange(this, change, value);
 	return QGraphicsItem::itemChange(change, value);
 }
 
@@ -294,6 +294,7 @@ QVariant PartPolygon::itemChange(QGraphicsItem::GraphicsItemChange change, const
 		setSelected(false); //This is item removed from scene, then we deselect this, and so, the handlers is also removed.
 	}
 	
+	ElementScene::notifyPartChange(this, change, value);
 	return QGraphicsItem::itemChange(change, value);
 }
 
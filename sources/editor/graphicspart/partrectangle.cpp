@@ -308,6 +308,7 @@ QVariant PartRectangle::itemChange(QGraphicsItem::GraphicsItemChange change, con
 		setSelected(false); //This item is removed from scene, then we deselect this, and so, the handlers is also removed.
 	}
 	
+	ElementScene::notifyPartChange(this, change, value);
 	return QGraphicsItem::itemChange(change, value);
 }
 
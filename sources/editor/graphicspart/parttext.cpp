@@ -49,6 +49,8 @@ PartText::PartText(QETElementEditor *editor, QGraphicsItem *parent) :
 
 /// Destructeur
 PartText::~PartText() {
+	if (scene())
+		ElementScene::notifyPartChange(this, QGraphicsItem::ItemSceneChange, QVariant());
 }
 
 /**
@@ -179,6 +181,7 @@ QVariant PartText::itemChange(GraphicsItemChange change, const QVariant &value)
 			updateCurrentPartEditor();
 		}
 	}
+	ElementScene::notifyPartChange(this, change, value);
 	return(QGraphicsTextItem::itemChange(change, value));
 }
 
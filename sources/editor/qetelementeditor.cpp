@@ -28,6 +28,7 @@
 #include "qeticons.h"
 #include "qetmessagebox.h"
 #include "editorcommands.h"
+#include "elementpartsmodel.h"
 
 // editeurs de primitives
 #include "arceditor.h"
@@ -57,13 +58,6 @@
 #include <QModelIndex>
 #include <utility>
 
-/*
-	Nombre maximum de primitives affichees par la "liste des parties"
-	Au-dela, un petit message est affiche, indiquant que ce nombre a ete depasse
-	et que la liste ne sera donc pas mise a jour.
-*/
-#define QET_MAX_PARTS_IN_ELEMENT_EDITOR_LIST 200
-
 /**
 	Constructeur
 	@param parent QWidget parent
@@ -251,7 +245,6 @@ void QETElementEditor::setupActions() {
 	
 	connect(m_depth_action_group, &QActionGroup::triggered, [this](QAction *action) {
 		this->elementScene()->undoStack().push(new ChangeZValueCommand(this->elementScene(), action->data().value<QET::DepthOption>()));
-		emit(this->elementScene()->partsZValueChanged());
 	});
 	
 	depth_toolbar = addToolBar(tr("Profondeur", "toolbar title"));
@@ -565,13 +558,16 @@ void QETElementEditor::setupInterface()
 	m_undo_dock -> setWidget(undo_view);
 	
 	// panel sur le cote pour la liste des parties
-	m_parts_list = new QListWidget(this);
+	// the model is kept up to date by the scene, the view only display the visible rows
+	m_parts_list = new QListView(this);
+	m_parts_list -> setModel(m_elmt_scene -> partsModel());
 	m_parts_list -> setSelectionMode(QAbstractItemView::ExtendedSelection);
-	connect(m_elmt_scene,   SIGNAL(partsAdded()),           this, SLOT(slot_createPartsList()));
-	connect(m_elmt_scene,   SIGNAL(partsRemoved()),         this, SLOT(slot_createPartsList()));
-	connect(m_elmt_scene,   SIGNAL(partsZValueChanged()),   this, SLOT(slot_createPartsList()));
+	m_parts_list -> setEditTriggers(QAbstractItemView::NoEditTriggers);
+	m_parts_list -> setUniformItemSizes(true);
 	connect(m_elmt_scene,   SIGNAL(selectionChanged()),     this, SLOT(slot_updatePartsList()));
-	connect(m_parts_list, SIGNAL(itemSelectionChanged()), this, SLOT(slot_updateSelectionFromPartsList()));
+	connect(m_elmt_scene -> partsModel(), SIGNAL(pendingChangesApplied()), this, SLOT(slot_updatePartsList()));
+	connect(m_parts_list -> selectionModel(), SIGNAL(selectionChanged(QItemSelection, QItemSelection)),
+			this, SLOT(slot_updateSelectionFromPartsList(QItemSelection, QItemSelection)));
 	m_parts_dock = new QDockWidget(tr("Parties", "dock title"), this);
 	m_parts_dock -> setObjectName("parts_list");
 	m_parts_dock -> setAllowedAreas(Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea);
@@ -581,7 +577,6 @@ void QETElementEditor::setupInterface()
 	m_parts_dock -> setWidget(m_parts_list);
 	
 	slot_updateInformations();
-	slot_createPartsList();
 	
 	// barre d'etat
 	statusBar() -> showMessage(tr("Éditeur d'éléments", "status bar message"));
@@ -830,7 +825,7 @@ void QETElementEditor::fromFile(const QString &filepath) {
 	
 	// chargement de l'element
 	m_elmt_scene -> fromXml(document_xml);
-	slot_createPartsList();
+	slot_updatePartsList();
 	
 	// gestion de la lecture seule
 	if (!infos_file.isWritable()) {
@@ -1346,72 +1341,48 @@ void QETElementEditor::firstActivation(QEvent *event) {
 }
 
 /**
-	Remplit la liste des parties
-*/
-void QETElementEditor::slot_createPartsList() {
-	m_parts_list -> blockSignals(true);
-	m_parts_list -> clear();
-	QList<QGraphicsItem *> qgis = m_elmt_scene -> zItems();
-	
-	// on ne construit plus la liste a partir de 200 primitives
-	// c'est ingerable : la maj de la liste prend trop de temps et le resultat
-	// est inexploitable
-	if (qgis.count() <= QET_MAX_PARTS_IN_ELEMENT_EDITOR_LIST) {
-		for (int j = qgis.count() - 1 ; j >= 0 ; -- j) {
-			QGraphicsItem *qgi = qgis[j];
-			if (CustomElementPart *cep = dynamic_cast<CustomElementPart *>(qgi)) {
-				QString part_desc = cep -> name();
-				QListWidgetItem *qlwi = new QListWidgetItem(part_desc);
-				QVariant v;
-				v.setValue<QGraphicsItem *>(qgi);
-				qlwi -> setData(42, v);
-				m_parts_list -> addItem(qlwi);
-				qlwi -> setSelected(qgi -> isSelected());
-			}
-		}
-	} else {
-		m_parts_list -> addItem(new QListWidgetItem(tr("Trop de primitives, liste non générée.")));
-	}
-	m_parts_list -> blockSignals(false);
-}
-
-/**
-	Met a jour la selection dans la liste des parties
+	Met a jour la selection dans la liste des parties.
+	Seules les parties dont l'etat de selection a change depuis le dernier
+	appel sont traitees ; l'ajout, la suppression et le changement de zValue
+	des parties sont directement notifies au modele par la scene.
 */
 void QETElementEditor::slot_updatePartsList() {
-	int items_count = m_elmt_scene -> items().count();
-	if (m_parts_list -> count() != items_count) {
-		slot_createPartsList();
-	} else if (items_count <= QET_MAX_PARTS_IN_ELEMENT_EDITOR_LIST) {
-		m_parts_list -> blockSignals(true);
-		int i = 0;
-		QList<QGraphicsItem *> items = m_elmt_scene -> zItems();
-		for (int j = items.count() - 1 ; j >= 0 ; -- j) {
-			QGraphicsItem *qgi = items[j];
-			QListWidgetItem *qlwi = m_parts_list -> item(i);
-			if (qlwi) qlwi -> setSelected(qgi -> isSelected());
-			++ i;
-		}
-		m_parts_list -> blockSignals(false);
-	}
+	QItemSelection selected, deselected;
+	m_elmt_scene -> partsModel() -> takeSelectionChanges(selected, deselected);
+	if (selected.isEmpty() && deselected.isEmpty()) return;
+	
+	m_updating_parts_list = true;
+	QItemSelectionModel *selection_model = m_parts_list -> selectionModel();
+	selection_model -> select(deselected, QItemSelectionModel::Deselect);
+	selection_model -> select(selected,   QItemSelectionModel::Select);
+	m_updating_parts_list = false;
 }
 
 /**
 	Met a jour la selection des parties de l'element a partir de la liste des
 	parties
+	@param selected lignes nouvellement selectionnees dans la liste
+	@param deselected lignes nouvellement deselectionnees dans la liste
 */
-void QETElementEditor::slot_updateSelectionFromPartsList() {
-	m_elmt_scene  -> blockSignals(true);
-	m_parts_list -> blockSignals(true);
-	for (int i = 0 ; i < m_parts_list -> count() ; ++ i) {
-		QListWidgetItem *qlwi = m_parts_list -> item(i);
-		QGraphicsItem *qgi = qlwi -> data(42).value<QGraphicsItem *>();
-		if (qgi) {
-			qgi -> setSelected(qlwi -> isSelected());
+void QETElementEditor::slot_updateSelectionFromPartsList(const QItemSelection &selected, const QItemSelection &deselected) {
+	if (m_updating_parts_list) return;
+	
+	ElementPartsModel *model = m_elmt_scene -> partsModel();
+	m_elmt_scene -> blockSignals(true);
+	foreach (const QModelIndex &index, deselected.indexes()) {
+		if (QGraphicsItem *qgi = model -> partFromIndex(index)) {
+			qgi -> setSelected(false);
+		}
+	}
+	foreach (const QModelIndex &index, selected.indexes()) {
+		if (QGraphicsItem *qgi = model -> partFromIndex(index)) {
+			qgi -> setSelected(true);
 		}
 	}
-	m_parts_list -> blockSignals(false);
 	m_elmt_scene -> blockSignals(false);
+	
+	// consomme les changements de selection que l'on vient de provoquer
+	slot_updatePartsList();
 	slot_updateInformations();
 	slot_updateMenus();
 }
@@ -1510,7 +1481,7 @@ void QETElementEditor::fromLocation(const ElementsLocation &location)
 
 		//Load the element
 	m_elmt_scene -> fromXml(document_xml);
-	slot_createPartsList();
+	slot_updatePartsList();
 
 		//location is read only
 	if (!location.isWritable())
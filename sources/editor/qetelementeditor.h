@@ -66,7 +66,9 @@ class QETElementEditor : public QETMainWindow {
 	/// Container for the list of existing primitives
 	QDockWidget *m_parts_dock;
 	/// List of primitives
-	QListWidget *m_parts_list;
+	QListView *m_parts_list;
+	/// true while the selection of the list of primitives is synchronized from the scene
+	bool m_updating_parts_list = false;
 	/// actions for the "file" menu
 	QAction *new_element, *open, *open_dxf, *open_file, *save, *save_as, *save_as_file, *reload, *quit;
 	/// actions for the "edit" menu
@@ -147,9 +149,8 @@ class QETElementEditor : public QETMainWindow {
 	void slot_updateInformations();
 	void slot_updateMenus();
 	void slot_updateTitle();
-	void slot_createPartsList();
 	void slot_updatePartsList();
-	void slot_updateSelectionFromPartsList();
+	void slot_updateSelectionFromPartsList(const QItemSelection &selected, const QItemSelection &deselected);
 	bool checkElement();
 	void pasteFromFile();
 	void pasteFromElement();
@@ -54,6 +54,7 @@ QList <Element *> ElementProvider::freeElement(const int filter) const{
 	//serch in all diagram
 	foreach (Diagram *d, diag_list) {
 		//get all element in diagram d
+		d->materialize();
 		QList <Element *> elmt_list;
 		elmt_list = d->elements();
 		foreach (Element *elmt, elmt_list) {
@@ -73,6 +74,9 @@ QList <Element *> ElementProvider::fromUuids(QList<QUuid> uuid_list) const {
 	QList <Element *> found_element;
 
 	foreach (Diagram *d, diag_list) {
+			//A dehydrated folio is only materialized if it contains one of the searched elements
+		if (d->hasDehydratedElement(uuid_list))
+			d->materialize();
 		foreach(Element *elmt, d->elements()) {
 			if (uuid_list.contains(elmt->uuid())) {
 				found_element << elmt;
@@ -96,6 +100,7 @@ QList <Element *> ElementProvider::find(const int filter) const {
 	//serch in all diagram
 	foreach (Diagram *d, diag_list) {
 		//get all element in diagram d
+		d->materialize();
 		QList <Element *> elmt_list;
 		elmt_list = d->elements();
 		foreach (Element *elmt, elmt_list) {
@@ -19,10 +19,13 @@
 #include "factory/elementfactory.h"
 #include "element.h"
 #include "qet.h"
+#include "diagramcontext.h"
 
 #include <QImageWriter>
 #include <QSqlQuery>
 #include <QSqlError>
+#include <QDataStream>
+#include <QRegularExpression>
 
 /**
 	Construct a cache for elements collections.
@@ -88,6 +91,71 @@ ElementsCollectionCache::ElementsCollectionCache(const QString &database_path, Q
 					   "pixmap BLOB, PRIMARY KEY(path),"
 					   "FOREIGN KEY(path) REFERENCES names (path) ON DELETE CASCADE);");
 
+			//The index written by the previous versions has no hotspot,
+			//it's dropped and filled again at the next loading of the collections
+		QSqlQuery index_columns(cache_db_);
+		if (index_columns.exec("PRAGMA table_info(element_index)"))
+		{
+			bool has_index = false, has_hotspot = false;
+			while (index_columns.next())
+			{
+				has_index = true;
+				if (index_columns.value(1).toString() == "hotspot_x") {
+					has_hotspot = true;
+				}
+			}
+			index_columns.finish();
+			if (has_index && !has_hotspot) {
+				cache_db_.exec("DROP TABLE element_index");
+			}
+		}
+
+		cache_db_.exec("CREATE TABLE IF NOT EXISTS element_index"
+					   "("
+					   "path VARCHAR(512) NOT NULL,"
+					   "mtime INTEGER NOT NULL,"
+					   "size INTEGER NOT NULL,"
+					   "uuid VARCHAR(512) NOT NULL,"
+					   "names BLOB,"
+					   "informations BLOB,"
+					   "hotspot_x INTEGER,"
+					   "hotspot_y INTEGER,"
+					   "PRIMARY KEY(path)"
+					   ");");
+
+			//Pictures of the elements drawn by ElementPictureFactory,
+			//hash is the hash of the definition used to draw them
+		cache_db_.exec("CREATE TABLE IF NOT EXISTS element_pictures"
+					   "("
+					   "uuid VARCHAR(512) NOT NULL,"
+					   "hash VARCHAR(64) NOT NULL,"
+					   "picture BLOB,"
+					   "low_picture BLOB,"
+					   "PRIMARY KEY(uuid)"
+					   ");");
+
+			//Full-text index of the element index, only available if
+			//the SQLite library is built with FTS5.
+		QSqlQuery search_table(cache_db_);
+		if (search_table.exec("SELECT name FROM sqlite_master WHERE type = 'table' AND name = 'element_search'") && search_table.next()) {
+			search_available_ = true;
+		}
+		else
+		{
+			search_table.finish();
+			search_available_ = search_table.exec("CREATE VIRTUAL TABLE element_search USING fts5"
+												  "("
+												  "path UNINDEXED,"
+												  "names,"
+												  "informations,"
+												  "collection_path,"
+												  "tokenize = 'unicode61 remove_diacritics 1'"
+												  ");");
+				//The table is new, fill it with the existing index
+			search_rebuild_ = search_available_;
+		}
+		search_table.finish();
+
 			// prepare queries
 		select_name_   = new QSqlQuery(cache_db_);
 		select_pixmap_ = new QSqlQuery(cache_db_);
@@ -97,6 +165,10 @@ ElementsCollectionCache::ElementsCollectionCache(const QString &database_path, Q
 		select_pixmap_ -> prepare("SELECT pixmap FROM pixmaps WHERE path = :path AND uuid = :uuid");
 		insert_name_   -> prepare("REPLACE INTO names (path, locale, uuid, name) VALUES (:path, :locale, :uuid, :name)");
 		insert_pixmap_ -> prepare("REPLACE INTO pixmaps (path, uuid, pixmap) VALUES (:path, :uuid, :pixmap)");
+		select_pictures_ = new QSqlQuery(cache_db_);
+		insert_pictures_ = new QSqlQuery(cache_db_);
+		select_pictures_ -> prepare("SELECT picture, low_picture FROM element_pictures WHERE uuid = :uuid AND hash = :hash");
+		insert_pictures_ -> prepare("REPLACE INTO element_pictures (uuid, hash, picture, low_picture) VALUES (:uuid, :hash, :picture, :low_picture)");
 	}
 }
 
@@ -108,6 +180,8 @@ ElementsCollectionCache::~ElementsCollectionCache() {
 	delete select_pixmap_;
 	delete insert_name_;
 	delete insert_pixmap_;
+	delete select_pictures_;
+	delete insert_pictures_;
 	cache_db_.close();
 }
 
@@ -168,9 +242,21 @@ bool ElementsCollectionCache::fetchElement(ElementsLocation &location)
 	}
 	else
 	{
+		if (!index_loaded_) {
+			loadIndex();
+		}
+
 		QString element_path = location.toString();
-		bool got_name   = fetchNameFromCache(element_path, location.uuid());
-		bool got_pixmap = fetchPixmapFromCache(element_path, location.uuid());
+			//The uuid is read from the index, so the definition
+			//is only parsed if the element was modified
+		bool changed = false;
+		QUuid uuid = elementMetadata(location, &changed).uuid;
+		if (changed) {
+			commitIndex();
+		}
+
+		bool got_name   = fetchNameFromCache(element_path, uuid);
+		bool got_pixmap = fetchPixmapFromCache(element_path, uuid);
 
 		if (got_name && got_pixmap) {
 			return(true);
@@ -178,8 +264,8 @@ bool ElementsCollectionCache::fetchElement(ElementsLocation &location)
 
 		if (fetchData(location))
 		{
-			cacheName(element_path, location.uuid());
-			cachePixmap(element_path, location.uuid());
+			cacheName(element_path, uuid);
+			cachePixmap(element_path, uuid);
 		}
 		return(true);
 	}
@@ -268,8 +354,8 @@ bool ElementsCollectionCache::fetchPixmapFromCache(const QString &path, const QU
 			current_pixmap_.detach();
 			current_pixmap_.loadFromData(ba, qPrintable(pixmap_storage_format_));
 			select_pixmap_ -> finish();
+			return(true);
 		}
-		return(true);
 	}
 	else
 		qDebug() << "select_pixmap_->exec() failed";
@@ -323,3 +409,490 @@ bool ElementsCollectionCache::cachePixmap(const QString &path, const QUuid &uuid
 	}
 	return(true);
 }
+
+/**
+ * @brief ElementsCollectionCache::fetchPictures
+ * Retrieve the compiled pictures of the element with the uuid @uuid
+ * if they were drawn from a definition with the hash @hash.
+ * @param uuid : uuid of the element
+ * @param hash : hash of the definition of the element
+ * @param picture : picture for the normal zoom
+ * @param low_picture : picture for the low zoom
+ * @return True if the retrieval succeeded, false otherwise.
+ * @see ElementPictureFactory
+ */
+bool ElementsCollectionCache::fetchPictures(const QUuid &uuid, const QByteArray &hash, QPicture &picture, QPicture &low_picture)
+{
+	if (!select_pictures_ || uuid.isNull() || hash.isEmpty()) {
+		return(false);
+	}
+
+	select_pictures_ -> bindValue(":uuid", uuid.toString());
+	select_pictures_ -> bindValue(":hash", QString::fromLatin1(hash));
+	if (!select_pictures_ -> exec())
+	{
+		qDebug() << "select_pictures_->exec() failed";
+		return(false);
+	}
+
+	bool ok = false;
+	if (select_pictures_ -> first())
+	{
+		QByteArray ba     = select_pictures_ -> value(0).toByteArray();
+		QByteArray low_ba = select_pictures_ -> value(1).toByteArray();
+		picture.setData(ba.constData(), uint(ba.size()));
+		low_picture.setData(low_ba.constData(), uint(low_ba.size()));
+		ok = !picture.isNull();
+	}
+	select_pictures_ -> finish();
+	return(ok);
+}
+
+/**
+ * @brief ElementsCollectionCache::cachePictures
+ * Cache the compiled pictures of the element with the uuid @uuid,
+ * drawn from a definition with the hash @hash. The pictures previously
+ * cached for this uuid are replaced.
+ * @param uuid : uuid of the element
+ * @param hash : hash of the definition of the element
+ * @param picture : picture for the normal zoom
+ * @param low_picture : picture for the low zoom
+ * @return True if the caching succeeded, false otherwise.
+ */
+bool ElementsCollectionCache::cachePictures(const QUuid &uuid, const QByteArray &hash, const QPicture &picture, const QPicture &low_picture)
+{
+	if (!insert_pictures_ || uuid.isNull() || hash.isEmpty()) {
+		return(false);
+	}
+
+	insert_pictures_ -> bindValue(":uuid", uuid.toString());
+	insert_pictures_ -> bindValue(":hash", QString::fromLatin1(hash));
+	insert_pictures_ -> bindValue(":picture", QByteArray(picture.data(), int(picture.size())));
+	insert_pictures_ -> bindValue(":low_picture", QByteArray(low_picture.data(), int(low_picture.size())));
+	if (!insert_pictures_ -> exec())
+	{
+		qDebug() << cache_db_.lastError();
+		return(false);
+	}
+	return(true);
+}
+
+/**
+ * @brief ElementsCollectionCache::loadIndex
+ * Read the whole index of the elements metadata from the database.
+ * Must be called from the thread of the cache, before loading the file collections.
+ * The paths asked by elementMetadata() are tracked from this call,
+ * see commitIndex(true).
+ * @return true if the index was read
+ */
+bool ElementsCollectionCache::loadIndex()
+{
+	QMutexLocker locker(&index_mutex_);
+	seen_paths_.clear();
+	if (index_loaded_ || !cache_db_.isOpen()) {
+		return(index_loaded_);
+	}
+
+	QSqlQuery select(cache_db_);
+	select.setForwardOnly(true);
+	if (!select.exec("SELECT path, mtime, size, uuid, names, informations, hotspot_x, hotspot_y FROM element_index")) {
+		qDebug() << cache_db_.lastError();
+		return(false);
+	}
+
+	while (select.next())
+	{
+		ElementMetadata metadata;
+		metadata.mtime = select.value(1).toLongLong();
+		metadata.size  = select.value(2).toLongLong();
+		metadata.uuid  = QUuid(select.value(3).toString());
+
+		QHash<QString, QString> names;
+		QByteArray names_ba = select.value(4).toByteArray();
+		QDataStream names_stream(&names_ba, QIODevice::ReadOnly);
+		names_stream >> names;
+		for (auto it = names.constBegin() ; it != names.constEnd() ; ++it) {
+			metadata.names.addName(it.key(), it.value());
+		}
+
+		QByteArray informations_ba = select.value(5).toByteArray();
+		QDataStream informations_stream(&informations_ba, QIODevice::ReadOnly);
+		informations_stream >> metadata.informations;
+		metadata.hotspot = QPoint(select.value(6).toInt(), select.value(7).toInt());
+
+		index_.insert(select.value(0).toString(), metadata);
+	}
+	index_loaded_ = true;
+	return(true);
+}
+
+/**
+ * @brief ElementsCollectionCache::elementMetadata
+ * Return the metadata of the element of a file system collection at @location.
+ * The metadata come from the index if the modification time and the size
+ * of the file didn't change, else the definition is parsed and the index updated
+ * (the database is only written by commitIndex()).
+ * This method is thread safe, it's used by the threads loading the collections.
+ * @param location : location of an element of a file system collection
+ * @param changed : if not nullptr, set to true if the definition was parsed
+ * because the element is new or was modified.
+ * @param previous : if not nullptr and the definition was parsed, set to the
+ * replaced metadata (null if the element is new).
+ * @return the metadata, null if the element doesn't exist.
+ */
+ElementsCollectionCache::ElementMetadata ElementsCollectionCache::elementMetadata(const ElementsLocation &location, bool *changed, ElementMetadata *previous)
+{
+	if (changed) {
+		*changed = false;
+	}
+
+	QFileInfo file_info(location.fileSystemPath());
+	if (location.isProject() || !file_info.isFile()) {
+		return(ElementMetadata());
+	}
+
+	QString path = location.toString();
+	qint64 mtime = file_info.lastModified().toMSecsSinceEpoch();
+	qint64 size = file_info.size();
+
+	{
+		QMutexLocker locker(&index_mutex_);
+		seen_paths_.insert(path);
+		auto it = index_.constFind(path);
+		if (it != index_.constEnd() && it->mtime == mtime && it->size == size) {
+			return(it.value());
+		}
+	}
+
+		//Parse outside of the lock, the others threads can continue to use the index
+	ElementMetadata metadata = readMetadata(location, file_info);
+
+	QMutexLocker locker(&index_mutex_);
+	if (previous) {
+		*previous = index_.value(path);
+	}
+	index_.insert(path, metadata);
+	dirty_paths_.insert(path);
+	if (changed) {
+		*changed = true;
+	}
+	return(metadata);
+}
+
+/**
+ * @brief ElementsCollectionCache::commitIndex
+ * Write to the database the index entries updated since the last commit.
+ * The cached names and pixmaps of the modified elements are removed.
+ * Must be called from the thread of the cache.
+ * @param remove_unseen : if true, remove from the index the elements which
+ * were not asked since loadIndex(), i.e. the elements removed from the collections.
+ * Use it only after loading the whole file collections.
+ */
+void ElementsCollectionCache::commitIndex(bool remove_unseen)
+{
+	QMutexLocker locker(&index_mutex_);
+	if (!cache_db_.isOpen()) {
+		return;
+	}
+
+	QStringList removed;
+	if (remove_unseen)
+	{
+		for (auto it = index_.begin() ; it != index_.end() ; )
+		{
+			if (seen_paths_.contains(it.key())) {
+				++it;
+			} else {
+				removed << it.key();
+				dirty_paths_.remove(it.key());
+				it = index_.erase(it);
+			}
+		}
+	}
+
+	if (dirty_paths_.isEmpty() && removed.isEmpty() && !(search_rebuild_ && index_loaded_)) {
+		return;
+	}
+
+	cache_db_.transaction();
+
+	QSqlQuery insert(cache_db_);
+	insert.prepare("REPLACE INTO element_index (path, mtime, size, uuid, names, informations, hotspot_x, hotspot_y) "
+				   "VALUES (:path, :mtime, :size, :uuid, :names, :informations, :hotspot_x, :hotspot_y)");
+	QSqlQuery delete_index(cache_db_), delete_name(cache_db_), delete_pixmap(cache_db_);
+	delete_index .prepare("DELETE FROM element_index WHERE path = :path");
+	delete_name  .prepare("DELETE FROM names WHERE path = :path");
+	delete_pixmap.prepare("DELETE FROM pixmaps WHERE path = :path");
+
+	for (const QString &path : dirty_paths_)
+	{
+		const ElementMetadata metadata = index_.value(path);
+
+		QHash<QString, QString> names;
+		for (const QString &lang : metadata.names.langs()) {
+			names.insert(lang, metadata.names[lang]);
+		}
+		QByteArray names_ba, informations_ba;
+		QDataStream names_stream(&names_ba, QIODevice::WriteOnly);
+		names_stream << names;
+		QDataStream informations_stream(&informations_ba, QIODevice::WriteOnly);
+		informations_stream << metadata.informations;
+
+		insert.bindValue(":path", path);
+		insert.bindValue(":mtime", metadata.mtime);
+		insert.bindValue(":size", metadata.size);
+		insert.bindValue(":uuid", metadata.uuid.toString());
+		insert.bindValue(":names", names_ba);
+		insert.bindValue(":informations", informations_ba);
+		insert.bindValue(":hotspot_x", metadata.hotspot.x());
+		insert.bindValue(":hotspot_y", metadata.hotspot.y());
+		if (!insert.exec()) {
+			qDebug() << cache_db_.lastError();
+		}
+
+			//The element was modified, the cached name and pixmap are perhaps obsolete
+		delete_name.bindValue(":path", path);
+		delete_name.exec();
+		delete_pixmap.bindValue(":path", path);
+		delete_pixmap.exec();
+	}
+
+	for (const QString &path : removed)
+	{
+		delete_index.bindValue(":path", path);
+		delete_index.exec();
+		delete_name.bindValue(":path", path);
+		delete_name.exec();
+		delete_pixmap.bindValue(":path", path);
+		delete_pixmap.exec();
+	}
+
+	if (search_available_)
+	{
+		if (search_rebuild_ && index_loaded_)
+		{
+			cache_db_.exec("DELETE FROM element_search");
+			updateSearchIndex(index_.keys(), QStringList());
+			search_rebuild_ = false;
+		}
+		else {
+			updateSearchIndex(dirty_paths_.toList(), removed);
+		}
+	}
+
+	cache_db_.commit();
+	dirty_paths_.clear();
+}
+
+/**
+ * @brief ElementsCollectionCache::hasFullTextSearch
+ * @return true if the full-text index is available, else
+ * searchElements() match the in memory index.
+ */
+bool ElementsCollectionCache::hasFullTextSearch() const {
+	return(search_available_);
+}
+
+/**
+ * @brief ElementsCollectionCache::searchElements
+ * Search the elements of the file system collections whose the names (in every language),
+ * the informations or the collection path match @text.
+ * Each word of @text is searched as a prefix of a word, the words of a group
+ * must all match and the groups are separated by "+", see searchTerms().
+ * Only the elements of the index are searched, i.e. the elements loaded
+ * at least once, see elementMetadata().
+ * @param text : the searched text
+ * @return the collection paths of the matching elements, the best match first.
+ */
+QStringList ElementsCollectionCache::searchElements(const QString &text)
+{
+	QStringList paths;
+	QList<QStringList> terms = searchTerms(text);
+	if (terms.isEmpty()) {
+		return(paths);
+	}
+
+	if (search_available_ && !search_rebuild_)
+	{
+		QSqlQuery select(cache_db_);
+		select.setForwardOnly(true);
+		select.prepare("SELECT path FROM element_search WHERE element_search MATCH :query "
+					   "ORDER BY bm25(element_search, 0.0, 10.0, 5.0, 1.0)");
+		select.bindValue(":query", searchQuery(terms));
+		if (select.exec())
+		{
+			while (select.next()) {
+				paths << select.value(0).toString();
+			}
+			return(paths);
+		}
+		qDebug() << select.lastError();
+	}
+
+		//No full-text index, match the in memory index
+	QMutexLocker locker(&index_mutex_);
+	for (auto it = index_.constBegin() ; it != index_.constEnd() ; ++it)
+	{
+		QStringList strings;
+		strings << it.key();
+		for (const QString &lang : it->names.langs()) {
+			strings << it->names[lang];
+		}
+		strings << it->informations.values();
+		if (matchSearchTerms(terms, strings.join("\n"))) {
+			paths << it.key();
+		}
+	}
+	paths.sort();
+	return(paths);
+}
+
+/**
+ * @brief ElementsCollectionCache::searchTerms
+ * Split a searched text in groups of words : the groups are separated by "+"
+ * and the words by spaces. A string match the text if it match
+ * all the words of at least one group.
+ * Words without letter nor digit are ignored.
+ * @param text
+ * @return the groups of words of @text
+ */
+QList<QStringList> ElementsCollectionCache::searchTerms(const QString &text)
+{
+	QList<QStringList> terms;
+	for (const QString &group : text.split("+", QString::SkipEmptyParts))
+	{
+		QStringList words;
+		for (const QString &word : group.split(QRegularExpression("\\s+"), QString::SkipEmptyParts))
+		{
+			for (const QChar &c : word)
+			{
+				if (c.isLetterOrNumber())
+				{
+					words << word;
+					break;
+				}
+			}
+		}
+		if (!words.isEmpty()) {
+			terms << words;
+		}
+	}
+	return(terms);
+}
+
+/**
+ * @brief ElementsCollectionCache::matchSearchTerms
+ * @param terms : groups of words returned by searchTerms()
+ * @param str
+ * @return true if @str contain (case insensitive) all the words of one group of @terms
+ */
+bool ElementsCollectionCache::matchSearchTerms(const QList<QStringList> &terms, const QString &str)
+{
+	for (const QStringList &words : terms)
+	{
+		bool match = true;
+		for (const QString &word : words)
+		{
+			if (!str.contains(word, Qt::CaseInsensitive))
+			{
+				match = false;
+				break;
+			}
+		}
+		if (match) {
+			return(true);
+		}
+	}
+	return(false);
+}
+
+/**
+ * @brief ElementsCollectionCache::readMetadata
+ * Parse the definition of the element at @location
+ * @param location
+ * @param file_info : file info of the element
+ * @return the metadata of the element
+ */
+ElementsCollectionCache::ElementMetadata ElementsCollectionCache::readMetadata(const ElementsLocation &location, const QFileInfo &file_info)
+{
+	ElementMetadata metadata;
+	metadata.mtime = file_info.lastModified().toMSecsSinceEpoch();
+	metadata.size  = file_info.size();
+
+	QDomElement root = location.xml();
+	QList<QDomElement> uuid_list = QET::findInDomElement(root, "uuid");
+	if (!uuid_list.isEmpty()) {
+		metadata.uuid = QUuid(uuid_list.first().attribute("uuid"));
+	}
+	metadata.names.fromXml(root);
+	metadata.hotspot = QPoint(root.attribute("hotspot_x").toInt(), root.attribute("hotspot_y").toInt());
+
+	DiagramContext context;
+	context.fromXml(root.firstChildElement("elementInformations"), "elementInformation");
+	for (const QString &key : context.keys()) {
+		metadata.informations.insert(key, context.value(key).toString());
+	}
+	return(metadata);
+}
+
+/**
+ * @brief ElementsCollectionCache::searchQuery
+ * @param terms : groups of words returned by searchTerms()
+ * @return the FTS5 query matching @terms, each word being used as a prefix.
+ */
+QString ElementsCollectionCache::searchQuery(const QList<QStringList> &terms)
+{
+	QStringList groups;
+	for (const QStringList &words : terms)
+	{
+		QStringList tokens;
+		for (QString word : words) {
+			tokens << "\"" + word.replace("\"", "\"\"") + "\"*";
+		}
+		groups << "(" + tokens.join(" AND ") + ")";
+	}
+	return(groups.join(" OR "));
+}
+
+/**
+ * @brief ElementsCollectionCache::updateSearchIndex
+ * Write to the full-text index the entries of the index at the paths @updated,
+ * and remove the entries at the paths @removed.
+ * Must be called by commitIndex(), in its transaction.
+ * @param updated
+ * @param removed
+ */
+void ElementsCollectionCache::updateSearchIndex(const QStringList &updated, const QStringList &removed)
+{
+	QSqlQuery insert(cache_db_), delete_search(cache_db_);
+	insert.prepare("INSERT INTO element_search (path, names, informations, collection_path) "
+				   "VALUES (:path, :names, :informations, :collection_path)");
+	delete_search.prepare("DELETE FROM element_search WHERE path = :path");
+
+	for (const QString &path : updated + removed)
+	{
+		delete_search.bindValue(":path", path);
+		delete_search.exec();
+	}
+
+	for (const QString &path : updated)
+	{
+		const ElementMetadata metadata = index_.value(path);
+		QStringList names;
+		for (const QString &lang : metadata.names.langs()) {
+			names << metadata.names[lang];
+		}
+
+			//The separators of the path are replaced, so each directory is a word
+		QString collection_path = path;
+		collection_path.replace("://", " ").replace("/", " ");
+
+		insert.bindValue(":path", path);
+		insert.bindValue(":names", names.join("\n"));
+		insert.bindValue(":informations", QStringList(metadata.informations.values()).join("\n"));
+		insert.bindValue(":collection_path", collection_path);
+		if (!insert.exec()) {
+			qDebug() << cache_db_.lastError();
+		}
+	}
+}
@@ -19,17 +19,46 @@
 #define ELEMENTS_COLLECTION_CACHE_H
 
 #include <QSqlDatabase>
+#include <QMutex>
+#include <QFileInfo>
+#include <QSet>
+#include <QPicture>
 #include "elementslocation.h"
+#include "nameslist.h"
 
 /**
 	This class implements a SQLite cache for data related to elements
 	collections, mainly names and pixmaps. This avoids the cost of parsing XML
 	definitions of elements and building full CustomElement objects when
 	(re)loading the elements panel.
+	It also holds the compiled pictures (normal and low zoom) drawn by the
+	ElementPictureFactory, so they are not drawn again from the XML
+	definition at each session.
+	The cache also holds an index of the metadata of the elements of the
+	file system collections (names, uuid, informations, hotspot...), checked against
+	the modification time and the size of the files, so only the elements
+	modified since the last session are parsed again.
+	When the SQLite library provides it, a FTS5 full-text index of the names,
+	informations and paths of these elements is maintained alongside the
+	index, and used by searchElements().
 */
 class ElementsCollectionCache : public QObject
 {
 	public:
+	/**
+		Metadata of an element of a file system collection, as stored in the index
+	*/
+	struct ElementMetadata
+	{
+		qint64 mtime = -1;                   ///< Modification time of the file, in ms since epoch
+		qint64 size = -1;                    ///< Size of the file
+		QUuid uuid;                          ///< Uuid of the element
+		NamesList names;                     ///< Localized names of the element
+		QHash<QString, QString> informations;///< Information fields of the element
+		QPoint hotspot;                      ///< Hotspot of the element
+		bool isNull() const {return mtime < 0;}
+	};
+	
 	// constructor, destructor
 	ElementsCollectionCache(const QString &database_path, QObject * = nullptr);
 	~ElementsCollectionCache() override;
@@ -48,6 +77,20 @@ class ElementsCollectionCache : public QObject
 	bool fetchPixmapFromCache(const QString &path, const QUuid &uuid);
 	bool cacheName(const QString &path, const QUuid &uuid = QUuid::createUuid());
 	bool cachePixmap(const QString &path, const QUuid &uuid = QUuid::createUuid());
+	bool fetchPictures(const QUuid &uuid, const QByteArray &hash, QPicture &picture, QPicture &low_picture);
+	bool cachePictures(const QUuid &uuid, const QByteArray &hash, const QPicture &picture, const QPicture &low_picture);
+	bool loadIndex();
+	ElementMetadata elementMetadata(const ElementsLocation &, bool *changed = nullptr, ElementMetadata *previous = nullptr);
+	void commitIndex(bool remove_unseen = false);
+	bool hasFullTextSearch() const;
+	QStringList searchElements(const QString &text);
+	static QList<QStringList> searchTerms(const QString &text);
+	static bool matchSearchTerms(const QList<QStringList> &terms, const QString &str);
+	
+	private:
+	static ElementMetadata readMetadata(const ElementsLocation &, const QFileInfo &);
+	static QString searchQuery(const QList<QStringList> &terms);
+	void updateSearchIndex(const QStringList &updated, const QStringList &removed);
 	
 	// attributes
 	private:
@@ -56,9 +99,18 @@ class ElementsCollectionCache : public QObject
 	QSqlQuery *select_pixmap_;      ///< Prepared statement to fetch pixmaps from the cache
 	QSqlQuery *insert_name_;        ///< Prepared statement to insert names into the cache
 	QSqlQuery *insert_pixmap_;      ///< Prepared statement to insert pixmaps into the cache
+	QSqlQuery *select_pictures_ = nullptr; ///< Prepared statement to fetch compiled pictures from the cache
+	QSqlQuery *insert_pictures_ = nullptr; ///< Prepared statement to insert compiled pictures into the cache
 	QString locale_;                ///< Locale to be used when dealing with names
 	QString pixmap_storage_format_; ///< Storage format for cached pixmaps
 	QString current_name_;          ///< Last name fetched
 	QPixmap current_pixmap_;        ///< Last pixmap fetched
+	QHash<QString, ElementMetadata> index_; ///< In memory copy of the index, by element path
+	QSet<QString> dirty_paths_;     ///< Paths of the index entries parsed since the last commit
+	QSet<QString> seen_paths_;      ///< Paths of the index entries asked since the index was loaded
+	bool index_loaded_ = false;     ///< True if the index was read from the database
+	bool search_available_ = false; ///< True if the full-text search table is available
+	bool search_rebuild_ = false;   ///< True if the full-text search table must be filled from the index
+	QMutex index_mutex_;            ///< Protect the in memory index, used by the threads loading the collections
 };
 #endif
@@ -37,6 +37,14 @@
 #include "dynamicelementtextitem.h"
 
 #include <QGraphicsSimpleTextItem>
+#include <QtConcurrent>
+#include "qettrace.h"
+
+/**
+	Nombre maximal d'octets d'images rendues en attente d'enregistrement
+	lors d'un export, afin de limiter la memoire utilisee.
+*/
+#define QET_EXPORT_MAX_PENDING_BYTES (256 * 1024 * 1024)
 
 /**
 	Constructeur
@@ -86,10 +94,15 @@ ExportDialog::ExportDialog(QETProject *project, QWidget *parent) : QDialog(paren
 	connect(deSelectAll, SIGNAL(clicked()),            this, SLOT(slot_deSelectAllClicked()));
 
 
+	// barre de progression, affichee pendant l'export
+	progress_bar_ = new QProgressBar(this);
+	progress_bar_ -> setVisible(false);
+
 	QVBoxLayout *layout = new QVBoxLayout(this);
 	layout -> addLayout(hLayout);
 	layout -> addWidget(initDiagramsListPart(), 1);
 	layout -> addWidget(epw);
+	layout -> addWidget(progress_bar_);
 	layout -> addWidget(buttons);
 	
 	// connexions signaux/slots
@@ -216,11 +229,17 @@ qreal ExportDialog::diagramRatio(Diagram *diagram) {
 	ou elements
 */
 QSize ExportDialog::diagramSize(Diagram *diagram) {
+	bool use_border = epw -> exportProperties().exported_area == QET::BorderArea;
+	
+	// les dimensions de la zone des elements ne sont connues qu'une fois
+	// les elements du schema charges
+	if (!use_border) diagram -> materialize();
+	
 	// sauvegarde le parametre useBorder du schema
 	bool state_useBorder = diagram -> useBorder();
 	
 	// applique le useBorder adequat et calcule le ratio
-	diagram -> setUseBorder(epw -> exportProperties().exported_area == QET::BorderArea);
+	diagram -> setUseBorder(use_border);
 	QSize diagram_size = diagram -> imageSize();
 	
 	// restaure le parametre useBorder du schema
@@ -329,6 +348,7 @@ void ExportDialog::slot_resetSize(int diagram_id) {
 	@return l'image a exporter
 */
 QImage ExportDialog::generateImage(Diagram *diagram, int width, int height, bool keep_aspect_ratio) {
+	QET_TRACE("ExportDialog::generateImage");
 	saveReloadDiagramParameters(diagram, true);
 	
 	QImage image(width, height, QImage::Format_RGB32);
@@ -354,6 +374,7 @@ void ExportDialog::saveReloadDiagramParameters(Diagram *diagram, bool save) {
 	static ExportProperties state_exportProperties;
 	
 	if (save) {
+		diagram -> materialize();
 		// memorise les parametres relatifs au schema tout en appliquant les nouveaux
 		state_exportProperties = diagram -> applyProperties(epw -> exportProperties());
 	} else {
@@ -371,6 +392,7 @@ void ExportDialog::saveReloadDiagramParameters(Diagram *diagram, bool save) {
 	@param io_device Peripherique de sortie pour le code SVG (souvent : un fichier)
 */
 void ExportDialog::generateSvg(Diagram *diagram, int width, int height, bool keep_aspect_ratio, QIODevice &io_device) {
+	QET_TRACE("ExportDialog::generateSvg");
 	saveReloadDiagramParameters(diagram, true);
 	
 	// genere une QPicture a partir du schema
@@ -393,29 +415,44 @@ void ExportDialog::generateSvg(Diagram *diagram, int width, int height, bool kee
 }
 
 /**
-	Exporte le schema en DXF
+	Exporte le schema en DXF dans un fichier, dans ce thread.
+	@param diagram Schema a exporter en DXF
+	@param width  Largeur de l'export DXF
+	@param height Hauteur de l'export DXF
+	@param keep_aspect_ratio True pour conserver le ratio, false sinon
+	@param file_path Chemin du fichier DXF
+	@return true si le fichier a ete ecrit
+*/
+bool ExportDialog::generateDxf(Diagram *diagram, int width, int height, bool keep_aspect_ratio, const QString &file_path) {
+	return(generateDxf(diagram, width, height, keep_aspect_ratio).write(file_path));
+}
+
+/**
+	Extrait la geometrie du schema sous la forme d'une liste de primitives DXF.
+	Doit etre appelee depuis le thread de l'interface, car elle parcourt la
+	scene ; le code DXF peut ensuite etre mis en forme et ecrit depuis
+	n'importe quel thread avec Createdxf::write().
 	@param diagram Schema a exporter en DXF
 	@param width  Largeur de l'export DXF
 	@param height Hauteur de l'export DXF
 	@param keep_aspect_ratio True pour conserver le ratio, false sinon
-	@param io_device Peripherique de sortie pour le code DXF (souvent : un fichier)
+	@return le dessin DXF du schema
 */
-void ExportDialog::generateDxf(Diagram *diagram, int width, int height, bool keep_aspect_ratio, QString &file_path) {
+Createdxf ExportDialog::generateDxf(Diagram *diagram, int width, int height, bool keep_aspect_ratio) {
+	QET_TRACE("ExportDialog::generateDxf");
     saveReloadDiagramParameters(diagram, true);
 
 	width  -= 2*Diagram::margin;
 	height -= 2*Diagram::margin;
 
-	Createdxf::xScale = Createdxf::sheetWidth  / double(width);
-	Createdxf::yScale = Createdxf::sheetHeight / double(height);
-
-	Createdxf::dxfBegin(file_path);
+	Createdxf dxf(Createdxf::sheetWidth  / double(width),
+				  Createdxf::sheetHeight / double(height));
 
 	//Add project elements (lines, rectangles, circles, texts) to dxf file
     if (epw -> exportProperties().draw_border) {
-    Createdxf::drawRectangle(file_path, 0, 0, double(width)*Createdxf::xScale, double(height)*Createdxf::yScale, 0);
+    dxf.drawRectangle(0, 0, double(width)*dxf.xScale(), double(height)*dxf.yScale(), 0);
     }
-    diagram -> border_and_titleblock.drawDxf(width, height, keep_aspect_ratio, file_path, 0);
+    diagram -> border_and_titleblock.drawDxf(width, height, keep_aspect_ratio, dxf, 0);
 
 	// Build the lists of elements.
 	QList<Element *> list_elements;
@@ -444,7 +481,7 @@ void ExportDialog::generateDxf(Diagram *diagram, int width, int height, bool kee
 		qreal rowHeight = (list_rectangles[0] -> height())/30;
 		QRectF row_RectF(x0, y0, list_rectangles[0] -> width(), rowHeight);
 
-		fillRow(file_path, row_RectF, authorTranslatable, titleTranslatable, folioTranslatable, dateTranslatable);
+		fillRow(dxf, row_RectF, authorTranslatable, titleTranslatable, folioTranslatable, dateTranslatable);
 		QList<Diagram *> diagram_list = ptr -> project() -> diagrams();
 
 		int startDiagram = (ptr -> getId()) *29;
@@ -453,13 +490,13 @@ void ExportDialog::generateDxf(Diagram *diagram, int width, int height, bool kee
 			y0 += rowHeight;
 			QRectF row_rect(x0, y0, list_rectangles[0] -> width(), rowHeight);
 			if (settings.value("genericpanel/folio", true).toBool()){
-			fillRow(file_path, row_rect, diagram_list[i] -> border_and_titleblock.author(),
+			fillRow(dxf, row_rect, diagram_list[i] -> border_and_titleblock.author(),
 					diagram_list[i] -> title(),
 					diagram_list[i] -> border_and_titleblock.finalfolio(),
 					diagram_list[i] -> border_and_titleblock.date().toString("dd/MM/yy"));
 					
 		}else{
-				fillRow(file_path, row_rect, diagram_list[i] -> border_and_titleblock.author(),
+				fillRow(dxf, row_rect, diagram_list[i] -> border_and_titleblock.author(),
 					diagram_list[i] -> title(),
 					QString::number(diagram_list[i] ->folioIndex()+1),
 					diagram_list[i] -> border_and_titleblock.date().toString("dd/MM/yy"));
@@ -486,7 +523,7 @@ void ExportDialog::generateDxf(Diagram *diagram, int width, int height, bool kee
 		}
 	}
 
-	foreach (QetShapeItem *qsi, list_shapes) qsi->toDXF(file_path, qsi->pen());
+	foreach (QetShapeItem *qsi, list_shapes) qsi->toDXF(dxf, qsi->pen());
 
 	//Draw elements
 	foreach(Element *elmt, list_elements)
@@ -496,8 +533,8 @@ void ExportDialog::generateDxf(Diagram *diagram, int width, int height, bool kee
 		qreal elem_pos_x = elmt -> pos().x();
 		qreal elem_pos_y = elmt -> pos().y();// - (diagram -> margin / 2);
 
-		qreal hotspot_x = (elem_pos_x) * Createdxf::xScale;
-		qreal hotspot_y = Createdxf::sheetHeight - (elem_pos_y) * Createdxf::yScale;
+		qreal hotspot_x = (elem_pos_x) * dxf.xScale();
+		qreal hotspot_y = Createdxf::sheetHeight - (elem_pos_y) * dxf.yScale();
 
 		ElementPictureFactory::primitives primitives = ElementPictureFactory::instance()->getPrimitives(elmt->location());
 
@@ -507,11 +544,11 @@ void ExportDialog::generateDxf(Diagram *diagram, int width, int height, bool kee
 			if (fontSize < 0) 
 				fontSize = text->font().pixelSize();
 			
-			fontSize *= Createdxf::yScale;
+			fontSize *= dxf.yScale();
 			qreal x = elem_pos_x + text->pos().x();
 			qreal y = elem_pos_y + text->pos().y();
-			x *= Createdxf::xScale;
-			y = Createdxf::sheetHeight - (y * Createdxf::yScale);// - fontSize;
+			x *= dxf.xScale();
+			y = Createdxf::sheetHeight - (y * dxf.yScale());// - fontSize;
 			QPointF transformed_point = rotation_transformed(x, y, hotspot_x, hotspot_y, rotation_angle);
 			x = transformed_point.x();
 			y = transformed_point.y();
@@ -521,7 +558,7 @@ void ExportDialog::generateDxf(Diagram *diagram, int width, int height, bool kee
 			{
 				qreal angle = 360 - (text->rotation() + rotation_angle);
 				if (line.size() > 0 && line != "_" ) {
-					Createdxf::drawText(file_path, line, x, y, fontSize, angle, 0);
+					dxf.drawText(line, x, y, fontSize, angle, 0);
 				}
 				angle += 1080;
 				// coordinates for next line
@@ -538,25 +575,25 @@ void ExportDialog::generateDxf(Diagram *diagram, int width, int height, bool kee
 
 		for (QLineF line : primitives.m_lines)
 		{
-			qreal x1 = (elem_pos_x + line.p1().x()) * Createdxf::xScale;
-			qreal y1 = Createdxf::sheetHeight - (elem_pos_y + line.p1().y()) * Createdxf::yScale;
+			qreal x1 = (elem_pos_x + line.p1().x()) * dxf.xScale();
+			qreal y1 = Createdxf::sheetHeight - (elem_pos_y + line.p1().y()) * dxf.yScale();
 			QPointF transformed_point = rotation_transformed(x1, y1, hotspot_x, hotspot_y, rotation_angle);
 			x1 = transformed_point.x();
 			y1 = transformed_point.y();
-			qreal x2 = (elem_pos_x + line.p2().x()) * Createdxf::xScale;
-			qreal y2 = Createdxf::sheetHeight - (elem_pos_y + line.p2().y()) * Createdxf::yScale;
+			qreal x2 = (elem_pos_x + line.p2().x()) * dxf.xScale();
+			qreal y2 = Createdxf::sheetHeight - (elem_pos_y + line.p2().y()) * dxf.yScale();
 			transformed_point = rotation_transformed(x2, y2, hotspot_x, hotspot_y, rotation_angle);
 			x2 = transformed_point.x();
 			y2 = transformed_point.y();
-			Createdxf::drawLine(file_path, x1, y1, x2, y2, 0);
+			dxf.drawLine(x1, y1, x2, y2, 0);
 		}
 
 		for (QRectF rect : primitives.m_rectangles)
 		{
-			qreal x1 = (elem_pos_x + rect.bottomLeft().x()) * Createdxf::xScale;
-			qreal y1 = Createdxf::sheetHeight - (elem_pos_y + rect.bottomLeft().y()) * Createdxf::yScale;
-			qreal w = rect.width() * Createdxf::xScale;
-			qreal h = rect.height() * Createdxf::yScale;
+			qreal x1 = (elem_pos_x + rect.bottomLeft().x()) * dxf.xScale();
+			qreal y1 = Createdxf::sheetHeight - (elem_pos_y + rect.bottomLeft().y()) * dxf.yScale();
+			qreal w = rect.width() * dxf.xScale();
+			qreal h = rect.height() * dxf.yScale();
 			// opposite corner
 			qreal x2 = x1 + w;
 			qreal y2 = y1 + h;
@@ -570,36 +607,36 @@ void ExportDialog::generateDxf(Diagram *diagram, int width, int height, bool kee
 			qreal bottom_left_y = (y1 < y2) ? y1 : y2;
 			w = (x1 < x2) ? x2-x1 : x1-x2;
 			h = (y1 < y2) ? y2-y1 : y1-y2;
-			Createdxf::drawRectangle(file_path, bottom_left_x, bottom_left_y, w, h, 0);
+			dxf.drawRectangle(bottom_left_x, bottom_left_y, w, h, 0);
 		}
 
 		for (QRectF circle_rect : primitives.m_circles)
 		{
-			qreal x1 = (elem_pos_x + circle_rect.center().x()) * Createdxf::xScale;
-			qreal y1 = Createdxf::sheetHeight - (elem_pos_y + circle_rect.center().y()) * Createdxf::yScale;
-			qreal r = circle_rect.width() * Createdxf::xScale / 2;
+			qreal x1 = (elem_pos_x + circle_rect.center().x()) * dxf.xScale();
+			qreal y1 = Createdxf::sheetHeight - (elem_pos_y + circle_rect.center().y()) * dxf.yScale();
+			qreal r = circle_rect.width() * dxf.xScale() / 2;
 			QPointF transformed_point = rotation_transformed(x1, y1, hotspot_x, hotspot_y, rotation_angle);
 			x1 = transformed_point.x();
 			y1 = transformed_point.y();
-			Createdxf::drawCircle(file_path, r, x1, y1, 0);
+			dxf.drawCircle(r, x1, y1, 0);
 		}
 
 		for (QVector<QPointF> polygon : primitives.m_polygons)
 		{
 			if (polygon.size() == 0)
 				continue;
-			qreal x1 = (elem_pos_x + polygon.at(0).x()) * Createdxf::xScale;
-			qreal y1 = Createdxf::sheetHeight - (elem_pos_y + polygon.at(0).y()) * Createdxf::yScale;
+			qreal x1 = (elem_pos_x + polygon.at(0).x()) * dxf.xScale();
+			qreal y1 = Createdxf::sheetHeight - (elem_pos_y + polygon.at(0).y()) * dxf.yScale();
 			QPointF transformed_point = rotation_transformed(x1, y1, hotspot_x, hotspot_y, rotation_angle);
 			x1 = transformed_point.x();
 			y1 = transformed_point.y();
 			for (int i = 1; i < polygon.size(); ++i ) {
-				qreal x2 = (elem_pos_x + polygon.at(i).x()) * Createdxf::xScale;
-				qreal y2 = Createdxf::sheetHeight - (elem_pos_y + polygon.at(i).y()) * Createdxf::yScale;
+				qreal x2 = (elem_pos_x + polygon.at(i).x()) * dxf.xScale();
+				qreal y2 = Createdxf::sheetHeight - (elem_pos_y + polygon.at(i).y()) * dxf.yScale();
 				QPointF transformed_point = rotation_transformed(x2, y2, hotspot_x, hotspot_y, rotation_angle);
 				x2 = transformed_point.x();
 				y2 = transformed_point.y();
-				Createdxf::drawLine(file_path, x1, y1, x2, y2, 0);
+				dxf.drawLine(x1, y1, x2, y2, 0);
 				x1 = x2;
 				y1 = y2;
 			}
@@ -610,24 +647,24 @@ void ExportDialog::generateDxf(Diagram *diagram, int width, int height, bool kee
 		{
 			if (arc.size() == 0)
 				continue;
-			qreal x = (elem_pos_x + arc.at(0)) * Createdxf::xScale;
-			qreal y = Createdxf::sheetHeight - (elem_pos_y + arc.at(1)) * Createdxf::yScale;
-			qreal w = arc.at(2) * Createdxf::xScale;
-			qreal h = arc.at(3) * Createdxf::yScale;
+			qreal x = (elem_pos_x + arc.at(0)) * dxf.xScale();
+			qreal y = Createdxf::sheetHeight - (elem_pos_y + arc.at(1)) * dxf.yScale();
+			qreal w = arc.at(2) * dxf.xScale();
+			qreal h = arc.at(3) * dxf.yScale();
 			qreal startAngle = arc.at(4);
 			qreal spanAngle = arc .at(5);
-			Createdxf::drawArcEllipse(file_path, x, y, w, h, startAngle, spanAngle, hotspot_x, hotspot_y, rotation_angle, 0);
+			dxf.drawArcEllipse(x, y, w, h, startAngle, spanAngle, hotspot_x, hotspot_y, rotation_angle, 0);
 		}
 	}
 
 	//Draw conductors
 	foreach(Conductor *cond, list_conductors) {
 		foreach(ConductorSegment *segment, cond -> segmentsList()) {
-			qreal x1 = (segment -> firstPoint().x()) * Createdxf::xScale;
-			qreal y1 = Createdxf::sheetHeight - (segment -> firstPoint().y() * Createdxf::yScale);
-			qreal x2 = (segment -> secondPoint().x()) * Createdxf::xScale;
-			qreal y2 = Createdxf::sheetHeight - (segment -> secondPoint().y() * Createdxf::yScale);
-			Createdxf::drawLine(file_path, x1, y1, x2, y2, 0);
+			qreal x1 = (segment -> firstPoint().x()) * dxf.xScale();
+			qreal y1 = Createdxf::sheetHeight - (segment -> firstPoint().y() * dxf.yScale());
+			qreal x2 = (segment -> secondPoint().x()) * dxf.xScale();
+			qreal y2 = Createdxf::sheetHeight - (segment -> secondPoint().y() * dxf.yScale());
+			dxf.drawLine(x1, y1, x2, y2, 0);
 		}
 		//Draw conductor text item
 		ConductorTextItem *textItem = cond -> textItem();
@@ -635,14 +672,14 @@ void ExportDialog::generateDxf(Diagram *diagram, int width, int height, bool kee
 			qreal fontSize = textItem -> font().pointSizeF();
 			if (fontSize < 0)
 				fontSize = textItem -> font().pixelSize();
-			fontSize *= Createdxf::yScale;
-			qreal x = (textItem -> pos().x()) * Createdxf::xScale;
-			qreal y = Createdxf::sheetHeight - (textItem -> pos().y() * Createdxf::yScale) - fontSize;
+			fontSize *= dxf.yScale();
+			qreal x = (textItem -> pos().x()) * dxf.xScale();
+			qreal y = Createdxf::sheetHeight - (textItem -> pos().y() * dxf.yScale()) - fontSize;
 			QStringList lines = textItem->toPlainText().split('\n');
 			foreach (QString line, lines) {
 				qreal angle = 360 - (textItem -> rotation());
 				if (line.size() > 0 && line != "_" )
-					Createdxf::drawText(file_path, line, x, y, fontSize, angle, 0 );
+					dxf.drawText(line, x, y, fontSize, angle, 0 );
 
 				angle += 1080;
 				// coordinates for next line
@@ -664,14 +701,14 @@ void ExportDialog::generateDxf(Diagram *diagram, int width, int height, bool kee
 		qreal fontSize = dti -> font().pointSizeF();
 		if (fontSize < 0)
 			fontSize = dti -> font().pixelSize();
-		fontSize *= Createdxf::yScale;
-		qreal x = (dti->scenePos().x()) * Createdxf::xScale;
-		qreal y = Createdxf::sheetHeight - (dti->scenePos().y() * Createdxf::yScale) - fontSize*1.05;
+		fontSize *= dxf.yScale();
+		qreal x = (dti->scenePos().x()) * dxf.xScale();
+		qreal y = Createdxf::sheetHeight - (dti->scenePos().y() * dxf.yScale()) - fontSize*1.05;
 		QStringList lines = dti -> toPlainText().split('\n');
 		foreach (QString line, lines) {
 			qreal angle = 360 - (dti -> rotation());
 			if (line.size() > 0 && line != "_" )
-				Createdxf::drawText(file_path, line, x, y, fontSize, angle, 0);
+				dxf.drawText(line, x, y, fontSize, angle, 0);
 
 			angle += 1080;
 			// coordinates for next line
@@ -685,46 +722,46 @@ void ExportDialog::generateDxf(Diagram *diagram, int width, int height, bool kee
 				x += fontSize*1.06;
 		}
 	}
-	Createdxf::dxfEnd(file_path);
 
     saveReloadDiagramParameters(diagram, false);
+	return(dxf);
 }
 
-void ExportDialog::fillRow(const QString& file_path, const QRectF &row_rect, QString author, const QString& title,
+void ExportDialog::fillRow(Createdxf &dxf, const QRectF &row_rect, QString author, const QString& title,
 							   QString folio, QString date)
 {
 	qreal x = row_rect.bottomLeft().x();
 	qreal y = row_rect.bottomLeft().y();
 
-	x *= Createdxf::xScale;
-	y = Createdxf::sheetHeight - y * Createdxf::yScale;
-	qreal height = row_rect.height() * Createdxf::yScale *0.7;
+	x *= dxf.xScale();
+	y = Createdxf::sheetHeight - y * dxf.yScale();
+	qreal height = row_rect.height() * dxf.yScale() *0.7;
 	y += height*0.2;
 
-	Createdxf::drawTextAligned(file_path, std::move(folio),
-							   x + 0.02*DiagramFolioList::colWidths[0]*row_rect.width()*Createdxf::xScale, y, height, 0, 0, 5, 0,
-							   x + 0.95*DiagramFolioList::colWidths[0]*row_rect.width()*Createdxf::xScale, 0);
+	dxf.drawTextAligned(std::move(folio),
+						x + 0.02*DiagramFolioList::colWidths[0]*row_rect.width()*dxf.xScale(), y, height, 0, 0, 5, 0,
+						x + 0.95*DiagramFolioList::colWidths[0]*row_rect.width()*dxf.xScale(), 0);
 
-	x += DiagramFolioList::colWidths[0]*row_rect.width()*Createdxf::xScale;
+	x += DiagramFolioList::colWidths[0]*row_rect.width()*dxf.xScale();
 	QString heading = tr("Titre");
 	if (title == heading)
-		Createdxf::drawTextAligned(file_path, title,
-								   x + 0.02*DiagramFolioList::colWidths[1]*row_rect.width()*Createdxf::xScale, y, height, 0, 0, 5, 0,
-								   x + 0.02*DiagramFolioList::colWidths[1]*row_rect.width()*Createdxf::xScale, 0);
+		dxf.drawTextAligned(title,
+							x + 0.02*DiagramFolioList::colWidths[1]*row_rect.width()*dxf.xScale(), y, height, 0, 0, 5, 0,
+							x + 0.02*DiagramFolioList::colWidths[1]*row_rect.width()*dxf.xScale(), 0);
 	else
-		Createdxf::drawTextAligned(file_path, title,
-								   x + 0.02*DiagramFolioList::colWidths[1]*row_rect.width()*Createdxf::xScale, y, height, 0, 0, 5, 0,
-								   x + 0.02*DiagramFolioList::colWidths[1]*row_rect.width()*Createdxf::xScale, 0, true);
-
-	x += DiagramFolioList::colWidths[1]*row_rect.width()*Createdxf::xScale;
-	Createdxf::drawTextAligned(file_path, std::move(author),
-							   x + 0.02*DiagramFolioList::colWidths[2]*row_rect.width()*Createdxf::xScale, y, height, 0, 0, 5, 0,
-							   x + 3.02*DiagramFolioList::colWidths[2]*row_rect.width()*Createdxf::xScale, 0);
-
-	x += DiagramFolioList::colWidths[2]*row_rect.width()*Createdxf::xScale;
-	Createdxf::drawTextAligned(file_path, std::move(date),
-							   x + 0.02*DiagramFolioList::colWidths[3]*row_rect.width()*Createdxf::xScale, y, height, 0, 0, 5, 0,
-							   x + 5.02*DiagramFolioList::colWidths[3]*row_rect.width()*Createdxf::xScale, 0);
+		dxf.drawTextAligned(title,
+							x + 0.02*DiagramFolioList::colWidths[1]*row_rect.width()*dxf.xScale(), y, height, 0, 0, 5, 0,
+							x + 0.02*DiagramFolioList::colWidths[1]*row_rect.width()*dxf.xScale(), 0, true);
+
+	x += DiagramFolioList::colWidths[1]*row_rect.width()*dxf.xScale();
+	dxf.drawTextAligned(std::move(author),
+						x + 0.02*DiagramFolioList::colWidths[2]*row_rect.width()*dxf.xScale(), y, height, 0, 0, 5, 0,
+						x + 3.02*DiagramFolioList::colWidths[2]*row_rect.width()*dxf.xScale(), 0);
+
+	x += DiagramFolioList::colWidths[2]*row_rect.width()*dxf.xScale();
+	dxf.drawTextAligned(std::move(date),
+						x + 0.02*DiagramFolioList::colWidths[3]*row_rect.width()*dxf.xScale(), y, height, 0, 0, 5, 0,
+						x + 5.02*DiagramFolioList::colWidths[3]*row_rect.width()*dxf.xScale(), 0);
 }
 
 QPointF ExportDialog::rotation_transformed(qreal px, qreal py , qreal origin_x, qreal origin_y, qreal angle) {
@@ -793,21 +830,140 @@ void ExportDialog::slot_export() {
 		return;
 	}
 	
-	// exporte chaque schema a exporter
+	// exporte chaque schema a exporter : les schemas sont rendus l'un apres
+	// l'autre dans ce thread, les images et les dessins DXF sont encodes et
+	// enregistres en parallele par le pool de threads
+	export_errors_.clear();
+	progress_bar_ -> setRange(0, diagrams_to_export.count());
+	progress_bar_ -> setValue(0);
+	progress_bar_ -> setVisible(true);
+	buttons -> setEnabled(false);
+	
 	foreach(ExportDiagramLine *diagram_line, diagrams_to_export) {
 		exportDiagram(diagram_line);
 	}
+	waitForPendingSaves(0, 0);
+	
+	buttons -> setEnabled(true);
+	progress_bar_ -> setVisible(false);
+	
+	// en cas d'erreur, le dialogue reste ouvert
+	if (!export_errors_.isEmpty()) {
+		QET::QetMessageBox::critical(
+			this,
+			tr("Erreur lors de l'export", "message box title"),
+			tr("Les fichiers suivants n'ont pas pu être exportés :", "message box content")
+				+ "\n\n" + export_errors_.join("\n"),
+			QMessageBox::Ok
+		);
+		return;
+	}
 	
 	// fermeture du dialogue
 	accept();
 }
 
+/**
+	Attend la fin de l'enregistrement des images en cours jusqu'a ce qu'il
+	reste au plus max_pending images en attente, et que l'ajout d'une image
+	de incoming_bytes octets ne depasse pas la limite de memoire.
+	L'interface reste rafraichie pendant l'attente.
+	@param max_pending Nombre maximal d'images en attente
+	@param incoming_bytes Taille de la prochaine image a enregistrer
+*/
+void ExportDialog::waitForPendingSaves(int max_pending, qint64 incoming_bytes) {
+	forever {
+		// recupere le resultat des enregistrements termines
+		for (auto it = pending_saves_.begin() ; it != pending_saves_.end() ; ) {
+			if (it -> future.isFinished()) {
+				pending_bytes_ -= it -> bytes;
+				fileExported(it -> future.result());
+				it = pending_saves_.erase(it);
+			} else {
+				++ it;
+			}
+		}
+		
+		if (pending_saves_.isEmpty()) return;
+		if (pending_saves_.count() <= max_pending &&
+			pending_bytes_ + incoming_bytes <= QET_EXPORT_MAX_PENDING_BYTES) return;
+		
+		// attend la fin du plus ancien enregistrement
+		QEventLoop loop;
+		QFutureWatcher<QString> watcher;
+		connect(&watcher, &QFutureWatcher<QString>::finished, &loop, &QEventLoop::quit);
+		watcher.setFuture(pending_saves_.first().future);
+		if (!watcher.isFinished()) {
+			loop.exec(QEventLoop::ExcludeUserInputEvents);
+		}
+	}
+}
+
+/**
+	Confie l'enregistrement d'un fichier au pool de threads, apres avoir
+	attendu si besoin que le nombre et la taille des fichiers en attente
+	le permettent.
+	@param bytes Memoire occupee par les donnees du fichier jusqu'a son enregistrement
+	@param save Fonction d'enregistrement, retournant un message d'erreur vide en cas de succes
+*/
+void ExportDialog::queueSave(qint64 bytes, const std::function<QString()> &save) {
+	// limite le nombre et la taille des fichiers en attente
+	waitForPendingSaves(qMax(1, QThreadPool::globalInstance() -> maxThreadCount()), bytes);
+	
+	PendingSave pending_save;
+	pending_save.bytes = bytes;
+	pending_save.future = QtConcurrent::run(save);
+	pending_saves_ << pending_save;
+	pending_bytes_ += pending_save.bytes;
+}
+
+/**
+	Comptabilise un fichier exporte
+	@param error Message d'erreur, vide si le fichier a ete exporte
+*/
+void ExportDialog::fileExported(const QString &error) {
+	if (!error.isEmpty()) {
+		export_errors_ << error;
+	}
+	progress_bar_ -> setValue(progress_bar_ -> value() + 1);
+}
+
+/**
+	Enregistre une image. Cette methode peut etre appelee depuis un thread
+	du pool de threads.
+	@param image Image a enregistrer
+	@param file_path Chemin du fichier
+	@param format Format de l'image (PNG, JPG, BMP)
+	@return un message d'erreur, ou une chaine vide si l'image a ete enregistree
+*/
+QString ExportDialog::saveImage(const QImage &image, const QString &file_path, const QByteArray &format) {
+	QFile target_file(file_path);
+	if (!image.save(&target_file, format.constData())) {
+		return(file_path + " : " + target_file.errorString());
+	}
+	return(QString());
+}
+
+/**
+	Enregistre un dessin DXF. Cette methode peut etre appelee depuis un thread
+	du pool de threads.
+	@param dxf Dessin DXF a enregistrer
+	@param file_path Chemin du fichier
+	@return un message d'erreur, ou une chaine vide si le dessin a ete enregistre
+*/
+QString ExportDialog::saveDxf(const Createdxf &dxf, const QString &file_path) {
+	QString error;
+	dxf.write(file_path, &error);
+	return(error);
+}
+
 /**
 	Exporte un schema
 	@param diagram_line La ligne decrivant le schema a exporter et la maniere
 	de l'exporter
 */
 void ExportDialog::exportDiagram(ExportDiagramLine *diagram_line) {
+	QET_TRACE("ExportDialog::exportDiagram");
 	ExportProperties export_properties(epw -> exportProperties());
 	
 	// recupere le format a utiliser (acronyme et extension)
@@ -826,17 +982,14 @@ void ExportDialog::exportDiagram(ExportDiagramLine *diagram_line) {
 	
 	// verifie qu'il est possible d'ecrire dans le fichier en question
 	if (file_infos.exists() && !file_infos.isWritable()) {
-		QET::QetMessageBox::critical(
-			this,
-			tr("Impossible d'écrire dans ce fichier", "message box title"),
+		fileExported(
 			QString(
 				tr(
 					"Il semblerait que vous n'ayez pas les permissions "
 					"nécessaires pour écrire dans le fichier %1.",
 					"message box content"
 				)
-			).arg(diagram_path),
-			QMessageBox::Ok
+			).arg(diagram_path)
 		);
 		return;
 	}
@@ -854,23 +1007,47 @@ void ExportDialog::exportDiagram(ExportDiagramLine *diagram_line) {
 			target_file
 		);
 	} else if (format_acronym == "DXF") {
-		generateDxf(
+		// l'extraction des primitives reste dans ce thread, la mise en forme
+		// du code DXF et l'ecriture sont confiees au pool de threads
+		Createdxf dxf = generateDxf(
 			diagram_line -> diagram,
 			diagram_line -> width  -> value(),
 			diagram_line -> height -> value(),
-			diagram_line -> keep_ratio -> isChecked(),
-			diagram_path
+			diagram_line -> keep_ratio -> isChecked()
 		);
+		
+		queueSave(dxf.memorySize(), [dxf, diagram_path]() {
+			return(saveDxf(dxf, diagram_path));
+		});
+		return;
 	} else {
+		// le rendu reste dans ce thread, l'encodage et l'ecriture sont
+		// confies au pool de threads
 		QImage image = generateImage(
 			diagram_line -> diagram,
 			diagram_line -> width  -> value(),
 			diagram_line -> height -> value(),
 			diagram_line -> keep_ratio -> isChecked()
 		);
-		image.save(&target_file, format_acronym.toUtf8().data());
+		
+		const QByteArray format = format_acronym.toUtf8();
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+		qint64 image_size = qint64(image.sizeInBytes());
+#else
+		qint64 image_size = qint64(image.byteCount());
+#endif
+		queueSave(image_size, [image, diagram_path, format]() {
+			return(saveImage(image, diagram_path, format));
+		});
+		return;
 	}
 	target_file.close();
+	
+	if (target_file.error() != QFileDevice::NoError) {
+		fileExported(diagram_path + " : " + target_file.errorString());
+	} else {
+		fileExported(QString());
+	}
 }
 
 /**
@@ -18,8 +18,11 @@
 #ifndef EXPORTDIALOG_H
 #define EXPORTDIALOG_H
 #include <QtWidgets>
+#include <QFuture>
+#include <functional>
 #include "diagram.h"
 #include "qetproject.h"
+#include "createdxf.h"
 class QSvgGenerator;
 class ExportPropertiesWidget;
 /**
@@ -42,6 +45,9 @@ class ExportDialog : public QDialog {
 	public:
 	int diagramsToExportCount() const;
 	static QPointF rotation_transformed(qreal, qreal, qreal, qreal, qreal);
+	void generateSvg(Diagram *, int, int, bool, QIODevice &);
+	Createdxf generateDxf(Diagram *, int, int, bool);
+	bool generateDxf(Diagram *, int, int, bool, const QString &);
 	
 	private:
 	class ExportDiagramLine {
@@ -61,6 +67,12 @@ class ExportDialog : public QDialog {
 		QPushButton *preview;
 		QPushButton *clipboard;
 	};
+
+		///Image or DXF drawing being saved in a worker thread
+	struct PendingSave {
+		QFuture<QString> future;
+		qint64 bytes;
+	};
 	
 	// attributes
 	private:
@@ -72,6 +84,7 @@ class ExportDialog : public QDialog {
 
 	QPushButton *selectAll;
 	QPushButton *deSelectAll;
+	QProgressBar *progress_bar_;
 
 	// mappers
 	QSignalMapper *preview_mapper_;
@@ -83,16 +96,24 @@ class ExportDialog : public QDialog {
 	
 	// project whose diagrams are to be exported
 	QETProject *project_;
+
+	// images being saved and errors of the current export
+	QList<PendingSave> pending_saves_;
+	qint64 pending_bytes_ = 0;
+	QStringList export_errors_;
 	
 	// methods
 	private:
 	QWidget *initDiagramsListPart();
 	void saveReloadDiagramParameters(Diagram *, bool = true);
-	void generateSvg(Diagram *, int, int, bool, QIODevice &);
-	void generateDxf(Diagram *, int, int, bool, QString &);
-	void fillRow(const QString&, const QRectF &, QString, const QString&, QString, QString);
+	void fillRow(Createdxf &, const QRectF &, QString, const QString&, QString, QString);
 	QImage generateImage(Diagram *, int, int, bool);
 	void exportDiagram(ExportDiagramLine *);
+	void waitForPendingSaves(int, qint64);
+	void queueSave(qint64, const std::function<QString()> &);
+	void fileExported(const QString &);
+	static QString saveImage(const QImage &, const QString &, const QByteArray &);
+	static QString saveDxf(const Createdxf &, const QString &);
 	qreal diagramRatio(Diagram *);
 	QSize diagramSize(Diagram *);
 	
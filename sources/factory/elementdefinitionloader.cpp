@@ -0,0 +1,175 @@
+/*
+	Copyright 2006-2019 The QElectroTech Team
+	This file is part of QElectroTech.
+	
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+	
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "elementdefinitionloader.h"
+#include "elementslocation.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QThread>
+#include <QtConcurrent>
+
+/**
+	Number of parsed definitions kept by the loader
+*/
+#define QET_DEFINITION_LOADER_SIZE 32
+
+/**
+ * @brief ElementDefinitionLoader::instance
+ * @return the loader, created at the first call.
+ */
+ElementDefinitionLoader *ElementDefinitionLoader::instance()
+{
+	static ElementDefinitionLoader *loader = new ElementDefinitionLoader(QCoreApplication::instance());
+	return loader;
+}
+
+/**
+ * @brief ElementDefinitionLoader::cachedDocument
+ * Can be called from any thread, but only the main thread use the kept definitions.
+ * @param file_path
+ * @return a copy of the parsed definition of the file @file_path,
+ * or a null document if the definition isn't loaded or if the file was modified since.
+ */
+QDomDocument ElementDefinitionLoader::cachedDocument(const QString &file_path)
+{
+	if (!QCoreApplication::instance() ||
+		QThread::currentThread() != QCoreApplication::instance()->thread()) {
+		return QDomDocument();
+	}
+
+	QDomDocument document = instance()->document(file_path);
+	if (document.isNull()) {
+		return document;
+	}
+		//The caller can modify the returned document
+	return document.cloneNode(true).toDocument();
+}
+
+/**
+ * @brief ElementDefinitionLoader::ElementDefinitionLoader
+ * @param parent
+ */
+ElementDefinitionLoader::ElementDefinitionLoader(QObject *parent) :
+	QObject(parent)
+{}
+
+/**
+ * @brief ElementDefinitionLoader::prefetch
+ * Start the loading of the definition of @location in a worker thread,
+ * if it isn't already loaded or being loaded.
+ * Only the elements of the file system collections are loaded,
+ * the definitions of the elements embedded in a project are already in memory.
+ * @param location
+ */
+void ElementDefinitionLoader::prefetch(const ElementsLocation &location)
+{
+	if (!location.isElement() || !location.isFileSystem() ||
+		isLoading(location) || isLoaded(location)) {
+		return;
+	}
+
+	const QString file_path = location.fileSystemPath();
+	m_loading.insert(file_path);
+
+	QFutureWatcher<Definition> *watcher = new QFutureWatcher<Definition>(this);
+	connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, file_path]()
+	{
+		m_loading.remove(file_path);
+		insert(file_path, watcher->result());
+		watcher->deleteLater();
+		emit loaded(file_path);
+	});
+	watcher->setFuture(QtConcurrent::run(&ElementDefinitionLoader::read, file_path));
+}
+
+/**
+ * @brief ElementDefinitionLoader::isLoaded
+ * @param location
+ * @return true if the definition of @location is parsed and up to date
+ */
+bool ElementDefinitionLoader::isLoaded(const ElementsLocation &location) const {
+	return location.isFileSystem() && !document(location.fileSystemPath()).isNull();
+}
+
+/**
+ * @brief ElementDefinitionLoader::isLoading
+ * @param location
+ * @return true if the definition of @location is being loaded
+ */
+bool ElementDefinitionLoader::isLoading(const ElementsLocation &location) const {
+	return location.isFileSystem() && m_loading.contains(location.fileSystemPath());
+}
+
+/**
+ * @brief ElementDefinitionLoader::read
+ * Read and parse the file @file_path, called in a worker thread.
+ * @param file_path
+ * @return the parsed definition, the document is null if the file can't be parsed.
+ */
+ElementDefinitionLoader::Definition ElementDefinitionLoader::read(const QString &file_path)
+{
+	Definition definition;
+	definition.last_modified = QFileInfo(file_path).lastModified();
+
+	QFile file(file_path);
+	QDomDocument document;
+	if (document.setContent(&file)) {
+		definition.document = document;
+	}
+	return definition;
+}
+
+/**
+ * @brief ElementDefinitionLoader::insert
+ * Keep @definition, and forget the oldest definition if there is too many kept definitions
+ * @param file_path
+ * @param definition
+ */
+void ElementDefinitionLoader::insert(const QString &file_path, const ElementDefinitionLoader::Definition &definition)
+{
+	m_paths.removeAll(file_path);
+	if (definition.document.isNull())
+	{
+		m_definitions.remove(file_path);
+		return;
+	}
+
+	m_definitions.insert(file_path, definition);
+	m_paths.append(file_path);
+	while (m_paths.size() > QET_DEFINITION_LOADER_SIZE) {
+		m_definitions.remove(m_paths.takeFirst());
+	}
+}
+
+/**
+ * @brief ElementDefinitionLoader::document
+ * @param file_path
+ * @return the kept definition of @file_path if the file wasn't modified since it was parsed,
+ * else a null document
+ */
+QDomDocument ElementDefinitionLoader::document(const QString &file_path) const
+{
+	auto it = m_definitions.constFind(file_path);
+	if (it == m_definitions.constEnd() ||
+		it->last_modified != QFileInfo(file_path).lastModified()) {
+		return QDomDocument();
+	}
+	return it->document;
+}
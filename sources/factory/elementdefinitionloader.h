@@ -0,0 +1,75 @@
+/*
+	Copyright 2006-2019 The QElectroTech Team
+	This file is part of QElectroTech.
+	
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+	
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef ELEMENTDEFINITIONLOADER_H
+#define ELEMENTDEFINITIONLOADER_H
+
+#include <QObject>
+#include <QDomDocument>
+#include <QDateTime>
+#include <QHash>
+#include <QSet>
+#include <QStringList>
+
+class ElementsLocation;
+
+/**
+ * @brief The ElementDefinitionLoader class
+ * Read and parse the xml definition of the elements of the file system collections
+ * in a worker thread, before they are needed.
+ * The elements panel start the loading when the mouse hover an element,
+ * so the definition is often already parsed when the element is dragged to a folio.
+ * The last parsed definitions are kept, and used by ElementsLocation::xml()
+ * as long as the file is not modified.
+ * This class must only be used from the main thread.
+ */
+class ElementDefinitionLoader : public QObject
+{
+	Q_OBJECT
+
+	public:
+		static ElementDefinitionLoader *instance();
+		static QDomDocument cachedDocument(const QString &file_path);
+
+		void prefetch(const ElementsLocation &location);
+		bool isLoaded(const ElementsLocation &location) const;
+		bool isLoading(const ElementsLocation &location) const;
+
+	signals:
+			/// Emitted when the loading of the definition at @file_path is finished, even if it failed.
+		void loaded(const QString &file_path);
+
+	private:
+		ElementDefinitionLoader(QObject *parent = nullptr);
+
+		struct Definition
+		{
+			QDomDocument document;
+			QDateTime last_modified;
+		};
+		static Definition read(const QString &file_path);
+		void insert(const QString &file_path, const Definition &definition);
+		QDomDocument document(const QString &file_path) const;
+
+	private:
+		QHash<QString, Definition> m_definitions;
+			///Paths of the kept definitions, from the oldest to the newest
+		QStringList m_paths;
+		QSet<QString> m_loading;
+};
+
+#endif // ELEMENTDEFINITIONLOADER_H
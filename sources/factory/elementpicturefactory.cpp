@@ -20,6 +20,7 @@
 #include "qet.h"
 #include "qetapp.h"
 #include "partline.h"
+#include "elementscollectioncache.h"
 
 #include <QDomElement>
 #include <QPainter>
@@ -28,9 +29,30 @@
 #include <iostream>
 #include <QAbstractTextDocumentLayout>
 #include <QGraphicsSimpleTextItem>
+#include <QCryptographicHash>
+#include <QTextStream>
+#include <QFile>
+#include <QThread>
+#include "qettrace.h"
 
 ElementPictureFactory* ElementPictureFactory::m_factory = nullptr;
 
+namespace {
+	/**
+	 * @brief pictureCache
+	 * @return the collections cache used to keep the pictures between the sessions,
+	 * nullptr if there is no cache or if it can't be used from the current thread.
+	 */
+	ElementsCollectionCache *pictureCache()
+	{
+		ElementsCollectionCache *cache = QETApp::collectionCache();
+		if (cache && cache->thread() == QThread::currentThread()) {
+			return cache;
+		}
+		return nullptr;
+	}
+}
+
 /**
  * @brief ElementPictureFactory::getPictures
  * Set the picture of the element at location.
@@ -52,14 +74,14 @@ void ElementPictureFactory::getPictures(const ElementsLocation &location, QPictu
 		return;
 	}
 	
-	if(m_pictures_H.keys().contains(uuid))
+	if(m_pictures_H.contains(uuid))
 	{
 		picture = m_pictures_H.value(uuid);
 		low_picture = m_low_pictures_H.value(uuid);
 	}
 	else
 	{
-		if (build(location))
+		if (load(location, uuid))
 		{
 			picture = m_pictures_H.value(uuid);
 			low_picture = m_low_pictures_H.value(uuid);
@@ -81,7 +103,7 @@ QPixmap ElementPictureFactory::pixmap(const ElementsLocation &location)
 		return m_pixmap_H.value(uuid);
 	}
 	
-	if(build(location))
+	if(m_pictures_H.contains(uuid) || load(location, uuid))
 	{
 		QDomElement dom = location.xml();
 			//size
@@ -125,12 +147,108 @@ ElementPictureFactory::primitives ElementPictureFactory::getPrimitives(const Ele
 	return m_primitives_H.value(location.uuid());
 }
 
+/**
+ * @brief ElementPictureFactory::invalidate
+ * Remove the pictures, pixmap and primitives of the element with the uuid @uuid,
+ * they will be built again at the next request.
+ * Used when the definition of an element was modified outside of QElectroTech.
+ * @param uuid
+ */
+void ElementPictureFactory::invalidate(const QUuid &uuid)
+{
+	if (uuid.isNull()) {
+		return;
+	}
+
+	m_pictures_H.remove(uuid);
+	m_low_pictures_H.remove(uuid);
+	m_pixmap_H.remove(uuid);
+	if (m_primitives_H.contains(uuid)) {
+		qDeleteAll(m_primitives_H.take(uuid).m_texts);
+	}
+}
+
 ElementPictureFactory::~ElementPictureFactory() {
 	for (primitives p : m_primitives_H.values()) {
 		qDeleteAll(p.m_texts);
 	}
 }
 
+/**
+ * @brief ElementPictureFactory::load
+ * Store in m_pictures_H and m_low_pictures_H the pictures of the element at @location.
+ * The pictures are read from the collections cache if they were drawn
+ * from the same definition in a previous session, else they are built
+ * and written in the cache.
+ * Note that the primitives are only stored by build().
+ * @param location
+ * @param uuid : uuid of the element at @location
+ * @return true if the pictures are available
+ */
+bool ElementPictureFactory::load(const ElementsLocation &location, const QUuid &uuid)
+{
+	ElementsCollectionCache *cache = uuid.isNull() ? nullptr : pictureCache();
+	QByteArray hash;
+	if (cache)
+	{
+		hash = definitionHash(location);
+		QPicture picture, low_picture;
+		if (cache->fetchPictures(uuid, hash, picture, low_picture))
+		{
+			m_pictures_H.insert(uuid, picture);
+			m_low_pictures_H.insert(uuid, low_picture);
+			return true;
+		}
+	}
+
+	if (!build(location)) {
+		return false;
+	}
+
+	if (cache && !hash.isEmpty()) {
+		cache->cachePictures(uuid, hash, m_pictures_H.value(uuid), m_low_pictures_H.value(uuid));
+	}
+	return true;
+}
+
+/**
+ * @brief ElementPictureFactory::definitionHash
+ * @param location
+ * @return the hash of the definition of the element at @location,
+ * the version of QElectroTech and Qt are included because they
+ * can change the drawing. Return an empty array if the definition can't be read.
+ * For an element of a file collection, the content of the file is hashed without parsing it,
+ * so a modification of the file is detected even if its modification time is kept.
+ */
+QByteArray ElementPictureFactory::definitionHash(const ElementsLocation &location)
+{
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	hash.addData(QET::version.toUtf8());
+	hash.addData(qVersion());
+
+	if (location.isFileSystem())
+	{
+		QFile file(location.fileSystemPath());
+		if (!file.open(QIODevice::ReadOnly) || !hash.addData(&file)) {
+			return QByteArray();
+		}
+	}
+	else
+	{
+		QDomElement dom = location.xml();
+		if (dom.isNull()) {
+			return QByteArray();
+		}
+		QByteArray ba;
+		QTextStream stream(&ba);
+		dom.save(stream, 0);
+		stream.flush();
+		hash.addData(ba);
+	}
+
+	return hash.result().toHex();
+}
+
 /**
  * @brief ElementPictureFactory::build
  * Build the picture from location.
@@ -143,6 +261,7 @@ ElementPictureFactory::~ElementPictureFactory() {
  */
 bool ElementPictureFactory::build(const ElementsLocation &location, QPicture *picture, QPicture *low_picture)
 {
+	QET_TRACE("ElementPictureFactory::build");
 	QDomElement dom = location.xml();
 	
 		//Check if the curent version can read the xml description
@@ -229,13 +348,29 @@ bool ElementPictureFactory::build(const ElementsLocation &location, QPicture *pi
 	painter.end();
 	low_painter.end();
 
+		//The uuid is read from the already parsed definition
+	QUuid uuid;
+	QList<QDomElement> uuid_list = QET::findInDomElement(dom, "uuid");
+	if (!uuid_list.isEmpty()) {
+		uuid = QUuid(uuid_list.first().attribute("uuid"));
+	}
+
 	if (!picture) {
-		m_pictures_H.insert(location.uuid(), pic);
-		m_primitives_H.insert(location.uuid(), primitives_);
+		m_pictures_H.insert(uuid, pic);
 	}
 	if (!low_picture) {
-		m_low_pictures_H.insert(location.uuid(), low_pic);
-		m_primitives_H.insert(location.uuid(), primitives_);
+		m_low_pictures_H.insert(uuid, low_pic);
+	}
+	if (!picture || !low_picture)
+	{
+			//Don't leak the texts of the primitives previously built for this uuid
+		if (m_primitives_H.contains(uuid)) {
+			qDeleteAll(m_primitives_H.take(uuid).m_texts);
+		}
+		m_primitives_H.insert(uuid, primitives_);
+	}
+	else {
+		qDeleteAll(primitives_.m_texts);
 	}
 	return true;
 }
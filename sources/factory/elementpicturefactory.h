@@ -85,6 +85,7 @@ class ElementPictureFactory
 		void getPictures(const ElementsLocation &location, QPicture &picture, QPicture &low_picture);
 		QPixmap pixmap(const ElementsLocation &location);
 		ElementPictureFactory::primitives getPrimitives(const ElementsLocation &location);
+		void invalidate(const QUuid &uuid);
 		
 	private:
 		ElementPictureFactory() {}
@@ -92,7 +93,9 @@ class ElementPictureFactory
 		ElementPictureFactory operator= (const ElementPictureFactory &);
 		~ElementPictureFactory();
 		
+		bool load(const ElementsLocation &location, const QUuid &uuid);
 		bool build(const ElementsLocation &location, QPicture *picture=nullptr, QPicture *low_picture=nullptr);
+		static QByteArray definitionHash(const ElementsLocation &location);
 		void parseElement(const QDomElement &dom, QPainter &painter, primitives &prim) const;
 		void parseLine   (const QDomElement &dom, QPainter &painter, primitives &prim) const;
 		void parseRect   (const QDomElement &dom, QPainter &painter, primitives &prim) const;
@@ -0,0 +1,184 @@
+/*
+	Copyright 2006-2019 The QElectroTech Team
+	This file is part of QElectroTech.
+	
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+	
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "memoryreport.h"
+#include "qetproject.h"
+#include "diagram.h"
+#include "element.h"
+#include "conductor.h"
+#include "conductortextitem.h"
+#include "conductorsegment.h"
+#include "terminal.h"
+#include "dynamicelementtextitem.h"
+#include "elementtextitemgroup.h"
+#include "elementdefinitiondata.h"
+#include "undohistory.h"
+
+namespace {
+	qint64 stringSize(const QString &str) {
+		return str.size() * qint64(sizeof(QChar));
+	}
+
+	qint64 contextSize(const DiagramContext &context)
+	{
+		qint64 size = 0;
+		for (const QString &key : context.keys()) {
+			size += sizeof(QVariant) + stringSize(context.value(key).toString());
+		}
+		return size;
+	}
+
+	QString formatSize(qint64 size) {
+		return QString("%1 KiB").arg(size / 1024.0, 0, 'f', 1);
+	}
+
+		///@return "@count @name : @size, x bytes per item"
+	QString itemsSize(int count, const QString &name, qint64 size) {
+		return QString("%1 %2 : %3, %4 bytes each")
+				.arg(count)
+				.arg(name, formatSize(size))
+				.arg(count ? size / count : 0);
+	}
+}
+
+/**
+ * @brief MemoryReport::elementSize
+ * @param element
+ * @return the estimated size of @element in bytes, without its shared definition data
+ */
+qint64 MemoryReport::elementSize(const Element *element)
+{
+	qint64 size = sizeof(Element);
+	size += element->terminals().size() * qint64(sizeof(Terminal));
+	for (DynamicElementTextItem *deti : element->dynamicTextItems()) {
+		size += sizeof(DynamicElementTextItem) + stringSize(deti->text());
+	}
+	for (ElementTextItemGroup *group : element->textGroups())
+	{
+		size += sizeof(ElementTextItemGroup);
+		for (DynamicElementTextItem *deti : group->texts()) {
+			size += sizeof(DynamicElementTextItem) + stringSize(deti->text());
+		}
+	}
+	size += contextSize(element->elementInformations());
+	return size;
+}
+
+/**
+ * @brief MemoryReport::conductorSize
+ * @param conductor
+ * @return the estimated size of @conductor in bytes
+ */
+qint64 MemoryReport::conductorSize(const Conductor *conductor)
+{
+	qint64 size = sizeof(Conductor);
+	size += conductor->segmentsList().size() * qint64(sizeof(ConductorSegment));
+	if (conductor->textItem()) {
+		size += sizeof(ConductorTextItem) + stringSize(conductor->textItem()->toPlainText());
+	}
+	return size;
+}
+
+/**
+ * @brief MemoryReport::diagramSize
+ * @param diagram
+ * @return the estimated size of the items of @diagram in bytes.
+ * For a dehydrated folio, only the compressed content is counted.
+ */
+qint64 MemoryReport::diagramSize(const Diagram *diagram)
+{
+	if (diagram->isDehydrated()) {
+		return diagram->dehydratedSize();
+	}
+
+	qint64 size = 0;
+	for (Element *element : diagram->elements()) {
+		size += elementSize(element);
+	}
+	for (Conductor *conductor : diagram->conductors()) {
+		size += conductorSize(conductor);
+	}
+	return size;
+}
+
+/**
+ * @brief MemoryReport::projectReport
+ * @param project
+ * @return a report of the memory used by each folio of @project
+ */
+QString MemoryReport::projectReport(QETProject *project)
+{
+	QString report = QString("Project \"%1\"\n").arg(project->title());
+	qint64 total = 0, total_elements_size = 0, total_conductors_size = 0;
+	int total_elements = 0, total_conductors = 0;
+	for (Diagram *diagram : project->diagrams())
+	{
+		if (diagram->isDehydrated())
+		{
+			const qint64 size = diagramSize(diagram);
+			total += size;
+			report += QString("  %1 : %2 (dehydrated)\n").arg(diagram->title(), formatSize(size));
+			continue;
+		}
+
+		const QList<Element *> elements = diagram->elements();
+		const QList<Conductor *> conductors = diagram->conductors();
+		qint64 elements_size = 0, conductors_size = 0;
+		for (Element *element : elements) {
+			elements_size += elementSize(element);
+		}
+		for (Conductor *conductor : conductors) {
+			conductors_size += conductorSize(conductor);
+		}
+
+		total += elements_size + conductors_size;
+		total_elements_size   += elements_size;
+		total_conductors_size += conductors_size;
+		total_elements   += elements.size();
+		total_conductors += conductors.size();
+
+		report += QString("  %1 : %2 (%3 ; %4)\n")
+				  .arg(diagram->title(), formatSize(elements_size + conductors_size),
+					   itemsSize(elements.size(), "elements", elements_size),
+					   itemsSize(conductors.size(), "conductors", conductors_size));
+	}
+	report += QString("  Total : %1 (%2 ; %3)\n")
+			  .arg(formatSize(total),
+				   itemsSize(total_elements, "elements", total_elements_size),
+				   itemsSize(total_conductors, "conductors", total_conductors_size));
+	report += QString("  Undo history : %1 in memory, %2 spilled to disk (budget %3)\n")
+			  .arg(formatSize(project->undoHistory()->memorySize()),
+				   formatSize(project->undoHistory()->spilledSize()),
+				   formatSize(project->undoHistory()->budget()));
+	return report;
+}
+
+/**
+ * @brief MemoryReport::definitionsReport
+ * @return a report of the memory used by the element definitions shared between the elements
+ */
+QString MemoryReport::definitionsReport()
+{
+	const QList<QSharedPointer<const ElementDefinitionData>> definitions = ElementDefinitionData::definitions();
+	qint64 total = 0;
+	for (const QSharedPointer<const ElementDefinitionData> &definition : definitions) {
+		total += definition->memorySize();
+	}
+	return QString("Shared element definitions : %1 (%2 definitions)\n")
+			.arg(formatSize(total))
+			.arg(definitions.size());
+}
@@ -0,0 +1,43 @@
+/*
+	Copyright 2006-2019 The QElectroTech Team
+	This file is part of QElectroTech.
+	
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+	
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef MEMORYREPORT_H
+#define MEMORYREPORT_H
+
+#include <QString>
+
+class QETProject;
+class Diagram;
+class Element;
+class Conductor;
+
+/**
+ * @brief The MemoryReport namespace
+ * Estimation of the memory used by the opened projects, printed with the --memory-report option.
+ * The sizes are approximations : the size of the objects, their own data and strings
+ * are summed, the data shared between objects (element definitions) is reported apart.
+ */
+namespace MemoryReport
+{
+	qint64 elementSize(const Element *element);
+	qint64 conductorSize(const Conductor *conductor);
+	qint64 diagramSize(const Diagram *diagram);
+	QString projectReport(QETProject *project);
+	QString definitionsReport();
+}
+
+#endif // MEMORYREPORT_H
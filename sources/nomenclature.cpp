@@ -16,6 +16,7 @@
 		along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include <QtDebug>
+#include <QtConcurrent>
 
 #include "nomenclature.h"
 #include "elementprovider.h"
@@ -43,6 +44,8 @@ nomenclature::~nomenclature() {
 
 /**
 		Save to csv file
+		The user choose the file and the type of export (flat or grouped by article),
+		the file is written in a worker thread while a progress dialog is displayed.
 		@param true if success
 */
 bool nomenclature::saveToCSVFile()
@@ -52,38 +55,313 @@ bool nomenclature::saveToCSVFile()
 	if (!name.endsWith(".csv")) {
 		name += ".csv";
 	}
-	QString filename = QFileDialog::getSaveFileName(this->m_parent, QObject::tr("Enregister sous... "), name, QObject::tr("Fichiers csv (*.csv)"));
-	QFile file(filename);
-	if( !filename.isEmpty() ) {
-		if(QFile::exists ( filename )){
-			// if file already exist -> delete it
-			if(!QFile::remove ( filename ) ){
-				QMessageBox::critical(this->m_parent, QObject::tr("Erreur"),
-									  QObject::tr("Impossible de remplacer le fichier!\n\n")+
-                                      "Destination : "+filename+"\n");
-				return false;
-			}	
+	QString flat_filter = QObject::tr("Fichiers csv (*.csv)");
+	QString grouped_filter = QObject::tr("Fichiers csv, articles identiques regroupés (*.csv)");
+	QString selected_filter = flat_filter;
+	QString filename = QFileDialog::getSaveFileName(this->m_parent, QObject::tr("Enregister sous... "), name,
+													flat_filter + ";;" + grouped_filter, &selected_filter);
+	if (filename.isEmpty()) {
+		return false;
+	}
+
+	if(QFile::exists ( filename )){
+		// if file already exist -> delete it
+		if(!QFile::remove ( filename ) ){
+			QMessageBox::critical(this->m_parent, QObject::tr("Erreur"),
+								  QObject::tr("Impossible de remplacer le fichier!\n\n")+
+								  "Destination : "+filename+"\n");
+			return false;
+		}
+	}
+
+	ExportType type = selected_filter == grouped_filter ? GroupedList : FlatList;
+
+		//Copy the data of the elements in this thread,
+		//the worker thread don't access to the diagrams.
+	const QVector<ElementData> elements_data = elementsData();
+	const QString title = m_project->title();
+
+	QProgressDialog progress_dialog(QObject::tr("Export de la nomenclature..."), QObject::tr("Annuler"),
+									0, elements_data.size(), m_parent);
+	progress_dialog.setWindowModality(Qt::WindowModal);
+	progress_dialog.setMinimumDuration(500);
+
+	QAtomicInt progress(0);
+	QAtomicInt canceled(0);
+	QString error;
+
+	QEventLoop loop;
+	QFutureWatcher<bool> watcher;
+	QObject::connect(&watcher, &QFutureWatcher<bool>::finished, &loop, &QEventLoop::quit);
+	QObject::connect(&progress_dialog, &QProgressDialog::canceled, [&canceled]() {canceled.store(1);});
+
+	QTimer timer;
+	timer.setInterval(100);
+	QObject::connect(&timer, &QTimer::timeout, [&progress_dialog, &progress]() {
+		progress_dialog.setValue(progress.load());
+	});
+
+	watcher.setFuture(QtConcurrent::run([&]() {
+		return writeNomenclature(filename, title, elements_data, type, progress, canceled, error);
+	}));
+	timer.start();
+	if (!watcher.isFinished()) {
+		loop.exec();
+	}
+	timer.stop();
+	progress_dialog.reset();
+
+	if (!watcher.result())
+	{
+		if (!error.isEmpty()) {
+			QMessageBox::critical(this->m_parent, QObject::tr("Erreur"), error);
+		}
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief nomenclature::saveToCSVFile
+ * Write the nomenclature in @file_name, without dialog and in the calling thread.
+ * @param file_name : the csv file to write, replaced if it already exist
+ * @param type : the kind of list to write
+ * @param error : if not nullptr, set to the error message when the file can't be written
+ * @return true if the file was written
+ */
+bool nomenclature::saveToCSVFile(const QString &file_name, ExportType type, QString *error) const
+{
+	QAtomicInt progress(0);
+	QAtomicInt canceled(0);
+	QString error_message;
+	const bool written = writeNomenclature(file_name, m_project->title(), elementsData(), type, progress, canceled, error_message);
+	if (error) {
+		*error = error_message;
+	}
+	return written;
+}
+
+/**
+ * @brief nomenclature::elementsData
+ * Copy the data of the elements to export, in the order of the nomenclature.
+ * Labels are not evaluated here, only the formulas and the values
+ * of the diagrams used to evaluate them are copied.
+ * @return
+ */
+QVector<nomenclature::ElementData> nomenclature::elementsData() const
+{
+	static const QStringList info_keys {
+		"label",
+		"formula",
+		"designation",
+		"description",
+		"plant",
+		"comment",
+		"manufacturer",
+		"manufacturer-reference",
+		"supplier",
+		"quantity",
+		"unity",
+		"auxiliary1",
+		"auxiliary2",
+		"machine-manufacturer-reference",
+		"location",
+		"function"
+	};
+
+	QVector<ElementData> data_list;
+
+	QSettings settings;
+	const bool export_terminal = settings.value("nomenclature/terminal-exportlist", true).toBool();
+	const bool first_column_is_0 = settings.value("border-columns_0", true).toBool();
+
+	for (Diagram *d : m_list_diagram)
+	{
+		//Get only simple, master and unlinked slave element.
+		ElementProvider ep(d);
+		QList <Element *> list_elements;
+
+		if (export_terminal) {
+			list_elements << ep.find(Element::Simple | Element::Master | Element::Terminale);
+		} else {
+			list_elements << ep.find(Element::Simple | Element::Master);
+		}
+		list_elements << ep.freeElement(Element::Slave);
+
+		if (list_elements.isEmpty()) {
+			continue;
+		}
+
+		const autonum::FormulaContext diagram_context(d);
+		autonum::sequentialNumbers empty_seq;
+		const QString folio_label = autonum::AssignVariables::formulaToLabel(d->border_and_titleblock.folio(), empty_seq, diagram_context);
+
+		for (Element *elmt : list_elements)
+		{
+			ElementData data;
+			data.folio_index = d->folioIndex();
+			data.folio_title = d->title();
+			data.folio_label = folio_label;
+			data.name        = elmt->name();
+			data.position    = d->convertPosition(elmt->scenePos()).toString();
+			data.context     = diagram_context;
+			data.context.setElement(d, elmt, first_column_is_0);
+			data.sequence    = elmt->sequenceStruct();
+
+			DiagramContext elmt_info = elmt->elementInformations();
+			for (const QString &key : info_keys) {
+				data.formulas << elmt_info[key].toString();
+			}
+
+			data_list << data;
 		}
-		if (file.open(QIODevice::WriteOnly | QIODevice::Text)){
-			QTextStream stream(&file);
-			stream << getNomenclature() << endl;
+	}
+
+	return data_list;
+}
+
+/**
+ * @brief nomenclature::writeNomenclature
+ * Write the nomenclature to the file @file_name. The rows are written one by one,
+ * and, for a grouped list, the identical articles (same manufacturer and
+ * same manufacturer reference) are counted at the same time.
+ * This method don't access to the project and can be called from a worker thread.
+ * @param file_name : file to write
+ * @param title : title of the project
+ * @param elements_data : data of the elements to write
+ * @param type : type of export
+ * @param progress : number of written elements, updated while writing
+ * @param canceled : if set to non zero, the writing is stopped and the file removed
+ * @param error : set to the error message if the file can't be written
+ * @return true if the file is written
+ */
+bool nomenclature::writeNomenclature(const QString &file_name,
+									 const QString &title,
+									 const QVector<ElementData> &elements_data,
+									 ExportType type,
+									 QAtomicInt &progress,
+									 const QAtomicInt &canceled,
+									 QString &error)
+{
+	QFile file(file_name);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+	{
+		error = QObject::tr("Impossible d'écrire le fichier!\n\n") + "Destination : " + file_name + "\n";
+		return false;
+	}
+
+	struct Article
+	{
+		QString manufacturer;
+		QString reference;
+		QString designation;
+		QString description;
+		QString supplier;
+		QString unity;
+		double quantity = 0;
+		QStringList labels;
+	};
+	QVector<Article> articles;
+	QHash<QString, int> articles_index;
+
+	QTextStream stream(&file);
+	stream << QObject::tr("NOMENCLATURE : ") + title + "\n\n";
+	stream << header();
+
+	for (const ElementData &data : elements_data)
+	{
+		if (canceled.load()) {
+			break;
 		}
-		else return false;
+
+		const QStringList info = elementInfo(data);
+		stream << info.join(";") << "\n";
+
+		if (type == GroupedList)
+		{
+			const QString &reference = info.at(ManufacturerReferenceColumn);
+			if (!reference.isEmpty())
+			{
+				const QString &manufacturer = info.at(ManufacturerColumn);
+				const QString key = manufacturer + QChar('\n') + reference;
+				int i = articles_index.value(key, -1);
+				if (i < 0)
+				{
+					Article article;
+					article.manufacturer = manufacturer;
+					article.reference    = reference;
+					article.designation  = info.at(DesignationColumn);
+					article.description  = info.at(DescriptionColumn);
+					article.supplier     = info.at(SupplierColumn);
+					article.unity        = info.at(UnityColumn);
+					i = articles.size();
+					articles << article;
+					articles_index.insert(key, i);
+				}
+
+					//An element without valid quantity count for one article
+				bool ok = false;
+				double quantity = info.at(QuantityColumn).toDouble(&ok);
+				articles[i].quantity += (ok && quantity > 0) ? quantity : 1;
+				if (!info.at(LabelColumn).isEmpty()) {
+					articles[i].labels << info.at(LabelColumn);
+				}
+			}
+		}
+
+		progress.ref();
 	}
-	else return false;
-	
+
+	if (!canceled.load() && type == GroupedList)
+	{
+		stream << "\n" << QObject::tr("ARTICLES") << "\n";
+		stream << QObject::tr("Fabricant") +";"
+		""+ QObject::tr("Numéro de commande") +";"
+		""+ QObject::tr("Désignation") +";"
+		""+ QObject::tr("Description") +";"
+		""+ QObject::tr("Fournisseur") +";"
+		""+ QObject::tr("Quantité") +";"
+		""+ QObject::tr("Unité") +";"
+		""+ QObject::tr("Labels") +"\n";
+
+		for (const Article &article : articles)
+		{
+			stream << article.manufacturer << ";"
+				   << article.reference << ";"
+				   << article.designation << ";"
+				   << article.description << ";"
+				   << article.supplier << ";"
+				   << QString::number(article.quantity) << ";"
+				   << article.unity << ";"
+				   << article.labels.join(", ") << "\n";
+		}
+	}
+
+	stream << endl;
+	file.close();
+
+	if (canceled.load())
+	{
+		file.remove();
+		return false;
+	}
+	if (file.error() != QFileDevice::NoError)
+	{
+		error = QObject::tr("Impossible d'écrire le fichier!\n\n") + "Destination : " + file_name + "\n";
+		return false;
+	}
+
 	return true;
 }
 
 /**
- * @brief nomenclature::getNomenclature
- * Create and formated a nomenclature to csv file.
- * @return The QString of nomenclature
+ * @brief nomenclature::header
+ * @return the two rows of header of the nomenclature
  */
-QString nomenclature::getNomenclature()
+QString nomenclature::header()
 {
-	//Process...
-	QString data = QObject::tr("NOMENCLATURE : ") + m_project -> title() + "\n\n";
+	QString data;
     data += QObject::tr("A001") +";"  //:Don't translate this text!    //ID for folio position in project
     ""+ QObject::tr("B001") +";"      //:Don't translate this text!    //ID for folio title
     ""+ QObject::tr("C001") +";"      //:Don't translate this text!    //ID for folio number
@@ -127,67 +405,25 @@ QString nomenclature::getNomenclature()
 	""+ QObject::tr("Localisation") +";"
 	""+ QObject::tr("Fonction") +"\n";
 
-
-	if(m_list_diagram.isEmpty()) return data;
-
-	foreach (Diagram *d, m_list_diagram) {
-		//Get only simple, master and unlinked slave element.
-		ElementProvider ep(d);
-		QSettings settings;
-		QList <Element *> list_elements;
-		
-		if (settings.value("nomenclature/terminal-exportlist", true).toBool()){
-		list_elements << ep.find(Element::Simple | Element::Master | Element::Terminale);
-		
-		}else{
-		
-		list_elements << ep.find(Element::Simple | Element::Master);
-		
-		}
-		
-		list_elements << ep.freeElement(Element::Slave);
-
-		foreach (Element *elmt, list_elements) {
-			data += getElementInfo(elmt);
-		}
-	}
-
 	return data;
 }
 
 /**
- * @brief nomenclature::getElementInfo
- * @param elmt : the element to getinfo
- * @return : QString with information about element formated to csv file
+ * @brief nomenclature::elementInfo
+ * @param data : the data of the element
+ * @return : the fields of the row of the element, with the labels evaluated
  */
-QString nomenclature::getElementInfo(Element *elmt) {
-	QString info;
-
-	Diagram *diagram = elmt -> diagram();
-	DiagramContext elmt_info = elmt -> elementInformations();
-	autonum::sequentialNumbers empty_seq;
-
-	info += QString::number(diagram -> folioIndex()+1) + ";";
-	info += diagram -> title() + ";";
-	info += autonum::AssignVariables::formulaToLabel(diagram->border_and_titleblock.folio(), empty_seq, diagram) + ";";
-	info += elmt -> name() + ";";
-	info += elmt-> diagram()-> convertPosition(elmt -> scenePos()).toString() + ";";
-	info += autonum::AssignVariables::formulaToLabel(elmt_info["label"].toString(), elmt->rSequenceStruct(), elmt->diagram(), elmt) + ";";
-	info += autonum::AssignVariables::formulaToLabel(elmt_info["formula"].toString(), elmt->rSequenceStruct(), elmt->diagram(), elmt) + ";";
-	info += autonum::AssignVariables::formulaToLabel(elmt_info["designation"].toString(), elmt->rSequenceStruct(), elmt->diagram(), elmt) + ";";
-	info += autonum::AssignVariables::formulaToLabel(elmt_info["description"].toString(), elmt->rSequenceStruct(), elmt->diagram(), elmt) + ";";
-	info += autonum::AssignVariables::formulaToLabel(elmt_info["plant"].toString(), elmt->rSequenceStruct(), elmt->diagram(), elmt) + ";";
-	info += autonum::AssignVariables::formulaToLabel(elmt_info["comment"].toString(), elmt->rSequenceStruct(), elmt->diagram(), elmt) + ";";
-	info += autonum::AssignVariables::formulaToLabel(elmt_info["manufacturer"].toString(), elmt->rSequenceStruct(), elmt->diagram(), elmt) + ";";
-	info += autonum::AssignVariables::formulaToLabel(elmt_info["manufacturer-reference"].toString(), elmt->rSequenceStruct(), elmt->diagram(), elmt) + ";";
-	info += autonum::AssignVariables::formulaToLabel(elmt_info["supplier"].toString(), elmt->rSequenceStruct(), elmt->diagram(), elmt) + ";";
-	info += autonum::AssignVariables::formulaToLabel(elmt_info["quantity"].toString(), elmt->rSequenceStruct(), elmt->diagram(), elmt) + ";";
-	info += autonum::AssignVariables::formulaToLabel(elmt_info["unity"].toString(), elmt->rSequenceStruct(), elmt->diagram(), elmt) + ";";
-	info += autonum::AssignVariables::formulaToLabel(elmt_info["auxiliary1"].toString(), elmt->rSequenceStruct(), elmt->diagram(), elmt) + ";";
-	info += autonum::AssignVariables::formulaToLabel(elmt_info["auxiliary2"].toString(), elmt->rSequenceStruct(), elmt->diagram(), elmt) + ";";
-	info += autonum::AssignVariables::formulaToLabel(elmt_info["machine-manufacturer-reference"].toString(), elmt->rSequenceStruct(), elmt->diagram(), elmt) + ";";
-	info += autonum::AssignVariables::formulaToLabel(elmt_info["location"].toString(), elmt->rSequenceStruct(), elmt->diagram(), elmt) + ";";
-	info += autonum::AssignVariables::formulaToLabel(elmt_info["function"].toString(), elmt->rSequenceStruct(), elmt->diagram(), elmt) + "\n";
+QStringList nomenclature::elementInfo(const ElementData &data)
+{
+	QStringList info;
+	info << QString::number(data.folio_index+1);
+	info << data.folio_title;
+	info << data.folio_label;
+	info << data.name;
+	info << data.position;
+	for (const QString &formula : data.formulas) {
+		info << autonum::AssignVariables::formulaToLabel(formula, data.sequence, data.context);
+	}
 
 	return info;
 }
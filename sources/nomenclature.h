@@ -25,6 +25,7 @@
 #include "qetgraphicsitem/element.h"
 #include "diagramcontent.h"
 #include "diagramposition.h"
+#include "assignvariables.h"
 
 class QETProject;
 class Diagram;
@@ -32,6 +33,9 @@ class Element;
 
 /**
 		This class represents a nomenclature...
+		The data of the elements are copied in the GUI thread, then the labels
+		are evaluated and the rows written to the csv file in a worker thread,
+		so the export can be followed and canceled and don't freeze the application.
 */
 class nomenclature
 {
@@ -39,6 +43,19 @@ class nomenclature
 	QETProject *m_project;
 	QList<Diagram *> m_list_diagram;
 	QWidget *m_parent;
+
+		///Copy of the data of an element needed to write its row
+	struct ElementData
+	{
+		int folio_index = 0;
+		QString folio_title;
+		QString folio_label;
+		QString name;
+		QString position;
+		autonum::FormulaContext context;
+		autonum::sequentialNumbers sequence;
+		QStringList formulas;
+	};
 	
 	// constructors, destructor
 	public:
@@ -47,15 +64,49 @@ class nomenclature
 	
 	// attributes
 	public:
+	enum ExportType {
+		FlatList,		///< one row per element
+		GroupedList		///< one row per element, followed by one row per article with its quantity
+	};
+	
+	private:
+		///Columns of the row of an element, see header()
+	enum Column {
+		FolioIndexColumn = 0,
+		FolioTitleColumn,
+		FolioLabelColumn,
+		NameColumn,
+		PositionColumn,
+		LabelColumn,
+		FormulaColumn,
+		DesignationColumn,
+		DescriptionColumn,
+		PlantColumn,
+		CommentColumn,
+		ManufacturerColumn,
+		ManufacturerReferenceColumn,
+		SupplierColumn,
+		QuantityColumn,
+		UnityColumn
+	};
 	
 	// methods
 	public:
 	bool saveToCSVFile();
+	bool saveToCSVFile(const QString &file_name, ExportType type, QString *error = nullptr) const;
 
 	
 	private:
-	QString getNomenclature ();
-	QString getElementInfo  (Element *elmt);
+	QVector<ElementData> elementsData() const;
+	static bool writeNomenclature(const QString &file_name,
+								  const QString &title,
+								  const QVector<ElementData> &elements_data,
+								  ExportType type,
+								  QAtomicInt &progress,
+								  const QAtomicInt &canceled,
+								  QString &error);
+	static QString header();
+	static QStringList elementInfo(const ElementData &data);
 	
 };
 
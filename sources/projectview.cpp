@@ -44,6 +44,9 @@ ProjectView::ProjectView(QETProject *project, QWidget *parent) :
 	QWidget(parent),
 	m_project(nullptr)
 {
+	QSettings settings;
+	m_max_diagram_views = settings.value("diagrameditor/max-diagram-views", 16).toInt();
+
 	initActions();
 	initWidgets();
 	initLayout();
@@ -57,10 +60,8 @@ ProjectView::ProjectView(QETProject *project, QWidget *parent) :
 */
 ProjectView::~ProjectView() {
 	// qDebug() << "Suppression du ProjectView" << ((void *)this);
-	foreach(int id, m_diagram_ids.keys()) {
-		DiagramView *diagram_view = m_diagram_ids.take(id);
-		delete diagram_view;
-	}
+	qDeleteAll(m_diagram_views);
+	m_diagram_views.clear();
 }
 
 /**
@@ -88,10 +89,18 @@ void ProjectView::setProject(QETProject *project) {
 }
 
 /**
-	@return la liste des schemas ouverts dans le projet
+	@return la liste des vues existantes des schemas du projet, dans l'ordre
+	des onglets. Les schemas dont l'onglet n'a pas encore ete active, ou dont
+	la vue a ete liberee, n'ont pas de vue.
 */
 QList<DiagramView *> ProjectView::diagram_views() const {
-	return(m_diagram_view_list);
+	QList<DiagramView *> views;
+	for (int i = 0 ; i < m_tab -> count() ; ++ i) {
+		if (DiagramView *dv = m_diagram_views.value(diagramAt(i))) {
+			views << dv;
+		}
+	}
+	return(views);
 }
 
 /**
@@ -99,10 +108,16 @@ QList<DiagramView *> ProjectView::diagram_views() const {
  * @return The current active diagram view or nullptr if there isn't diagramView in this project view.
  */
 DiagramView *ProjectView::currentDiagram() const {
-	int current_tab_index = m_tab -> currentIndex();
-	if (current_tab_index == -1)
-		return nullptr;
-	return(m_diagram_ids[current_tab_index]);
+	return(m_diagram_views.value(diagramAt(m_tab -> currentIndex())));
+}
+
+/**
+ * @brief ProjectView::diagramView
+ * @param diagram
+ * @return the view of @diagram, or nullptr if @diagram has no view yet
+ */
+DiagramView *ProjectView::diagramView(Diagram *diagram) const {
+	return(m_diagram_views.value(diagram));
 }
 
 /**
@@ -123,76 +138,32 @@ void ProjectView::closeEvent(QCloseEvent *qce) {
 	@brief change current diagramview to next folio
 */
 void ProjectView::changeTabDown(){
-	DiagramView *nextDiagramView = this->nextDiagram();
-	if (nextDiagramView!=nullptr){
-		rebuildDiagramsMap();
-		m_tab -> setCurrentWidget(nextDiagramView);
-	}
-}
-
-/**
-	@return next folio of current diagramview
-*/
-DiagramView *ProjectView::nextDiagram() {
-	int current_tab_index = m_tab -> currentIndex();
-	int next_tab_index = current_tab_index + 1;	//get next tab index
-	if (next_tab_index<m_diagram_ids.count()) //if next tab index >= greatest tab the last tab is activated so no need to change tab.
-		return(m_diagram_ids[next_tab_index]);
-	else
-		return nullptr;
+	int next_tab_index = m_tab -> currentIndex() + 1;
+	if (next_tab_index < m_tab -> count()) //if next tab index >= greatest tab the last tab is activated so no need to change tab.
+		m_tab -> setCurrentIndex(next_tab_index);
 }
 
 /**
 	@brief change current diagramview to previous tab
 */
 void ProjectView::changeTabUp(){
-	DiagramView *previousDiagramView = this->previousDiagram();
-	if (previousDiagramView!=nullptr){
-		rebuildDiagramsMap();
-		m_tab -> setCurrentWidget(previousDiagramView);
-	}
-}
-
-/**
-	@return previous folio of current diagramview
-*/
-DiagramView *ProjectView::previousDiagram() {
-	int current_tab_index = m_tab -> currentIndex();
-	int previous_tab_index = current_tab_index - 1;	//get previous tab index
-	if (previous_tab_index>=0) //if previous tab index = 0 then the first tab is activated so no need to change tab.
-		return(m_diagram_ids[previous_tab_index]);
-	else
-		return nullptr;
+	int previous_tab_index = m_tab -> currentIndex() - 1;
+	if (previous_tab_index >= 0) //if previous tab index = 0 then the first tab is activated so no need to change tab.
+		m_tab -> setCurrentIndex(previous_tab_index);
 }
 
 /**
 	@brief change current diagramview to last tab
 */
 void ProjectView::changeLastTab(){
-	DiagramView *lastDiagramView = this->lastDiagram();
-	m_tab->setCurrentWidget(lastDiagramView);
-}
-
-/**
-	@return last folio of current project
-*/
-DiagramView *ProjectView::lastDiagram(){
-	return(m_diagram_ids.last());
+	m_tab -> setCurrentIndex(m_tab -> count() - 1);
 }
 
 /**
 	@brief change current diagramview to first tab
 */
 void ProjectView::changeFirstTab(){
-	DiagramView *firstDiagramView = this->firstDiagram();
-	m_tab->setCurrentWidget(firstDiagramView);
-}
-
-/**
-	@return first folio of current project
-*/
-DiagramView *ProjectView::firstDiagram(){
-	return(m_diagram_ids.first());
+	m_tab -> setCurrentIndex(0);
 }
 
 
@@ -348,12 +319,11 @@ void ProjectView::addNewDiagram() {
 	if (m_project -> isReadOnly()) return;
 
 	Diagram *new_diagram = m_project -> addNewDiagram();
-	DiagramView *new_diagram_view = new DiagramView(new_diagram);
-	addDiagram(new_diagram_view);
+	addDiagram(new_diagram);
 
 	if (m_project -> diagrams().size() % 58 == 1 && m_project -> getFolioSheetsQuantity() != 0)
 		addNewDiagramFolioList();
-	showDiagram(new_diagram_view);
+	showDiagram(new_diagram);
 }
 
 /**
@@ -365,46 +335,136 @@ void ProjectView::addNewDiagramFolioList() {
 	int i = 1; //< Each new diagram is added  to the end of the project.
 			   //< We use @i to move the folio list at second position in the project
 	foreach (Diagram *d, m_project -> addNewDiagramFolioList()) {
-		DiagramView *new_diagram_view = new DiagramView(d);
-		addDiagram(new_diagram_view);
-		showDiagram(new_diagram_view);
-		m_tab->tabBar()->moveTab(diagram_views().size()-1, i);
+		addDiagram(d);
+		showDiagram(d);
+		m_tab->tabBar()->moveTab(m_tab->count()-1, i);
 		i++;
 	}
 }
 
 /**
  * @brief ProjectView::addDiagram
- * Add diagram view to this project view
- * @param diagram_view
+ * Add a tab for @diagram to this project view.
+ * The tab only contains an empty page, the diagram view
+ * is created when the tab is activated.
+ * @param diagram
  */
-void ProjectView::addDiagram(DiagramView *diagram_view)
+void ProjectView::addDiagram(Diagram *diagram)
 {
-	if (!diagram_view) 
+	if (!diagram)
 		return;
 
 		//Check if diagram isn't present in the project
-	if (m_diagram_ids.values().contains(diagram_view))
+	if (m_diagram_page.contains(diagram))
 		return;
 
-		// Add new tab for the diagram
-    m_tab->addTab(diagram_view, QET::Icons::Diagram, diagram_view -> title());
-	diagram_view->setFrameStyle(QFrame::Plain | QFrame::NoFrame);
+	diagram->undoStack().setClean();
+	diagram->loadElmtFolioSeq();
+	diagram->loadCndFolioSeq();
+
+	QWidget *page = new QWidget();
+	QVBoxLayout *page_layout = new QVBoxLayout(page);
+	page_layout->setContentsMargins(0, 0, 0, 0);
+	page_layout->setSpacing(0);
+	m_page_diagram.insert(page, diagram);
+	m_diagram_page.insert(diagram, page);
 
-	m_diagram_view_list << diagram_view;
+		// Add new tab for the diagram
+	m_tab->addTab(page, QET::Icons::Diagram, diagram->title());
 
-	rebuildDiagramsMap();
 	updateAllTabsTitle();
 	
+	connect(&diagram->border_and_titleblock, &BorderTitleBlock::titleBlockFolioChanged, this, [this, diagram]() {this->updateTabTitle(diagram);});
+	connect(&diagram->border_and_titleblock, &BorderTitleBlock::diagramTitleChanged,    this, [this, diagram]() {this->updateTabTitle(diagram);});
+
+	m_project -> setModified(true);
+}
+
+/**
+ * @brief ProjectView::createDiagramView
+ * Create the view of @diagram in its tab page,
+ * and restore its zoom and scroll position if it was released.
+ * @param diagram
+ * @return the new view
+ */
+DiagramView *ProjectView::createDiagramView(Diagram *diagram)
+{
+	QWidget *page = m_diagram_page.value(diagram);
+	if (!page)
+		return nullptr;
+
+	diagram->materialize();
+	DiagramView *diagram_view = new DiagramView(diagram);
+	diagram_view->setFrameStyle(QFrame::Plain | QFrame::NoFrame);
+	page->layout()->addWidget(diagram_view);
+	m_diagram_views.insert(diagram, diagram_view);
+
 	connect(diagram_view, SIGNAL(showDiagram(Diagram*)), this, SLOT(showDiagram(Diagram*)));
-	connect(diagram_view, SIGNAL(titleChanged(DiagramView *, const QString &)), this, SLOT(updateTabTitle(DiagramView *)));
 	connect(diagram_view, SIGNAL(findElementRequired(const ElementsLocation &)), this, SIGNAL(findElementRequired(const ElementsLocation &)));
 	connect(diagram_view, SIGNAL(editElementRequired(const ElementsLocation &)), this, SIGNAL(editElementRequired(const ElementsLocation &)));
-	connect(&diagram_view->diagram()->border_and_titleblock , &BorderTitleBlock::titleBlockFolioChanged, [this, diagram_view]() {this->updateTabTitle(diagram_view);});
+
+	if (m_view_states.contains(diagram))
+	{
+		DiagramViewState state = m_view_states.take(diagram);
+		diagram_view->setTransform(state.transform);
+			//Scroll bars ranges are only known once the view is laid out
+		QTimer::singleShot(0, diagram_view, [diagram_view, state]() {
+			diagram_view->horizontalScrollBar()->setValue(state.horizontal_value);
+			diagram_view->verticalScrollBar()->setValue(state.vertical_value);
+		});
+	}
 
 		// signal diagram view was added
 	emit(diagramAdded(diagram_view));
-	m_project -> setModified(true);
+	return diagram_view;
+}
+
+/**
+ * @brief ProjectView::releaseDiagramView
+ * Delete the view of @diagram, its zoom and scroll position are kept
+ * to be restored when the view is created again.
+ * The view is deleted later, because this method can be reached
+ * from a signal emitted by the view itself (see tabChanged).
+ * @param diagram
+ */
+void ProjectView::releaseDiagramView(Diagram *diagram)
+{
+	DiagramView *diagram_view = m_diagram_views.take(diagram);
+	m_activated_diagrams.removeAll(diagram);
+	if (!diagram_view)
+		return;
+
+	DiagramViewState state;
+	state.transform        = diagram_view->transform();
+	state.horizontal_value = diagram_view->horizontalScrollBar()->value();
+	state.vertical_value   = diagram_view->verticalScrollBar()->value();
+	m_view_states.insert(diagram, state);
+
+	disconnect(diagram_view, nullptr, this, nullptr);
+	diagram_view->hide();
+	diagram_view->deleteLater();
+}
+
+/**
+ * @brief ProjectView::releaseInactiveDiagramViews
+ * Release the views of the least recently activated tabs
+ * while there is more views than allowed by the settings.
+ * The view of the current tab is never released.
+ * @param previous : the diagram of the previous tab, its view is not released either
+ * because the tab change can be requested by this view.
+ */
+void ProjectView::releaseInactiveDiagramViews(Diagram *previous)
+{
+	if (m_max_diagram_views <= 0)
+		return;
+
+	Diagram *current = diagramAt(m_tab->currentIndex());
+	for (int i = m_activated_diagrams.size() - 1 ; i >= 0 && m_diagram_views.size() > m_max_diagram_views ; --i)
+	{
+		Diagram *diagram = m_activated_diagrams.at(i);
+		if (diagram != current && diagram != previous)
+			releaseDiagramView(diagram);
+	}
 }
 
 /**
@@ -415,14 +475,27 @@ void ProjectView::addDiagram(DiagramView *diagram_view)
 void ProjectView::removeDiagram(DiagramView *diagram_view)
 {
 	if (!diagram_view)
-        return;
+		return;
+
+	removeDiagram(diagram_view->diagram());
+}
+
+/**
+ * @brief ProjectView::removeDiagram
+ * Remove a diagram (folio) of the project
+ * @param diagram : diagram to remove
+ */
+void ProjectView::removeDiagram(Diagram *diagram)
+{
+	if (!diagram)
+		return;
 	if (m_project -> isReadOnly())
-        return;
-	if (!m_diagram_ids.values().contains(diagram_view))
-        return;
+		return;
+	if (!m_diagram_page.contains(diagram))
+		return;
 
 
-        //Ask confirmation to user.
+		//Ask confirmation to user.
 	int answer = QET::QetMessageBox::question(
 		this,
 		tr("Supprimer le folio ?", "message box title"),
@@ -434,34 +507,25 @@ void ProjectView::removeDiagram(DiagramView *diagram_view)
 		return;
 	}
 
-        //Remove the diagram view of the tabs widget
-	int index_to_remove = m_diagram_ids.key(diagram_view);
-	m_tab->removeTab(index_to_remove);
-	m_diagram_view_list.removeAll(diagram_view);
-	rebuildDiagramsMap();
-    
-	m_project -> removeDiagram(diagram_view -> diagram());
-	delete diagram_view;
-
-	emit(diagramRemoved(diagram_view));
-	
-        //Make definitve the withdrawal
-	m_project -> write();
-    updateAllTabsTitle();
-    m_project -> setModified(true);
+		//Remove the page of the diagram of the tabs widget
+	QWidget *page = m_diagram_page.take(diagram);
+	m_page_diagram.remove(page);
+	m_view_states.remove(diagram);
+	m_activated_diagrams.removeAll(diagram);
+	DiagramView *diagram_view = m_diagram_views.take(diagram);
+	m_tab->removeTab(m_tab->indexOf(page));
 
-}
+	if (diagram_view)
+		emit(diagramRemoved(diagram_view));
 
-/**
-	Enleve un schema du ProjectView
-	@param diagram Schema a enlever
-*/
-void ProjectView::removeDiagram(Diagram *diagram) {
-	if (!diagram) return;
+	m_project -> removeDiagram(diagram);
+	delete diagram_view;
+	delete page;
 
-	if (DiagramView *diagram_view = findDiagram(diagram)) {
-		removeDiagram(diagram_view);
-	}
+		//Make definitve the withdrawal
+	m_project -> write();
+	updateAllTabsTitle();
+	m_project -> setModified(true);
 }
 
 /**
@@ -470,17 +534,19 @@ void ProjectView::removeDiagram(Diagram *diagram) {
 */
 void ProjectView::showDiagram(DiagramView *diagram) {
 	if (!diagram) return;
-	m_tab -> setCurrentWidget(diagram);
+	showDiagram(diagram -> diagram());
 }
 
 /**
-	Active l'onglet adequat pour afficher le schema passe en parametre
+	Active l'onglet adequat pour afficher le schema passe en parametre ;
+	la vue du schema est creee si besoin.
 	@param diagram Schema a afficher
 */
 void ProjectView::showDiagram(Diagram *diagram) {
 	if (!diagram) return;
-	if (DiagramView *diagram_view = findDiagram(diagram)) {
-		m_tab -> setCurrentWidget(diagram_view);
+	int index = tabIndex(diagram);
+	if (index != -1) {
+		m_tab -> setCurrentIndex(index);
 	}
 }
 
@@ -514,28 +580,40 @@ void ProjectView::editDiagramProperties(DiagramView *diagram_view) {
 	Edite les proprietes du schema diagram
 */
 void ProjectView::editDiagramProperties(Diagram *diagram) {
-	editDiagramProperties(findDiagram(diagram));
+	showDiagram(diagram);
+	editDiagramProperties(diagramView(diagram));
 }
 
 /**
-	Deplace le schema diagram_view vers le haut / la gauche
+	Deplace l'onglet du schema diagram de offset onglets
+	@param diagram Schema a deplacer
+	@param offset Deplacement, negatif vers le haut / la gauche
 */
-void ProjectView::moveDiagramUp(DiagramView *diagram_view) {
-	if (!diagram_view) return;
+void ProjectView::moveDiagram(Diagram *diagram, int offset) {
+	int diagram_position = tabIndex(diagram);
+	if (diagram_position == -1) return;
 
-	int diagram_view_position = m_diagram_ids.key(diagram_view);
-	if (!diagram_view_position) {
-		// le schema est le premier du projet
+	int new_position = diagram_position + offset;
+	if (new_position == diagram_position || new_position < 0 || new_position >= m_tab -> count()) {
+		// le schema est deja le premier / le dernier du projet
 		return;
 	}
-	m_tab -> tabBar() -> moveTab(diagram_view_position, diagram_view_position - 1);
+	m_tab -> tabBar() -> moveTab(diagram_position, new_position);
+}
+
+/**
+	Deplace le schema diagram_view vers le haut / la gauche
+*/
+void ProjectView::moveDiagramUp(DiagramView *diagram_view) {
+	if (!diagram_view) return;
+	moveDiagramUp(diagram_view -> diagram());
 }
 
 /**
 	Deplace le schema diagram vers le haut / la gauche
 */
 void ProjectView::moveDiagramUp(Diagram *diagram) {
-	moveDiagramUp(findDiagram(diagram));
+	moveDiagram(diagram, -1);
 }
 
 /**
@@ -543,20 +621,14 @@ void ProjectView::moveDiagramUp(Diagram *diagram) {
 */
 void ProjectView::moveDiagramDown(DiagramView *diagram_view) {
 	if (!diagram_view) return;
-
-	int diagram_view_position = m_diagram_ids.key(diagram_view);
-	if (diagram_view_position + 1 == m_diagram_ids.count()) {
-		// le schema est le dernier du projet
-		return;
-	}
-	m_tab -> tabBar() -> moveTab(diagram_view_position, diagram_view_position + 1);
+	moveDiagramDown(diagram_view -> diagram());
 }
 
 /**
 	Deplace le schema diagram vers le bas / la droite
 */
 void ProjectView::moveDiagramDown(Diagram *diagram) {
-	moveDiagramDown(findDiagram(diagram));
+	moveDiagram(diagram, 1);
 }
 
 /*
@@ -565,13 +637,7 @@ void ProjectView::moveDiagramDown(Diagram *diagram) {
 void ProjectView::moveDiagramUpTop(DiagramView *diagram_view)
 {
 	if (!diagram_view) return;
-
-	int diagram_view_position = m_diagram_ids.key(diagram_view);
-	if (!diagram_view_position) {
-		// le schema est le premier du projet
-		return;
-	}
-	m_tab -> tabBar() -> moveTab(diagram_view_position, (diagram_views().size(), 0));
+	moveDiagramUpTop(diagram_view -> diagram());
 }
 
 /*
@@ -579,7 +645,7 @@ void ProjectView::moveDiagramUpTop(DiagramView *diagram_view)
  */
 void ProjectView::moveDiagramUpTop(Diagram *diagram)
 {
-	moveDiagramUpTop(findDiagram(diagram));
+	moveDiagram(diagram, -tabIndex(diagram));
 }
 
 /**
@@ -587,20 +653,14 @@ void ProjectView::moveDiagramUpTop(Diagram *diagram)
 */
 void ProjectView::moveDiagramUpx10(DiagramView *diagram_view) {
 	if (!diagram_view) return;
-
-	int diagram_view_position = m_diagram_ids.key(diagram_view);
-	if (!diagram_view_position) {
-		// le schema est le premier du projet
-		return;
-	}
-	m_tab -> tabBar() -> moveTab(diagram_view_position, diagram_view_position - 10);
+	moveDiagramUpx10(diagram_view -> diagram());
 }
 
 /**
 	Deplace le schema diagram vers le haut / la gauche x10
 */
 void ProjectView::moveDiagramUpx10(Diagram *diagram) {
-	moveDiagramUpx10(findDiagram(diagram));
+	moveDiagram(diagram, -10);
 }
 
 /**
@@ -608,20 +668,14 @@ void ProjectView::moveDiagramUpx10(Diagram *diagram) {
 */
 void ProjectView::moveDiagramDownx10(DiagramView *diagram_view) {
 	if (!diagram_view) return;
-
-	int diagram_view_position = m_diagram_ids.key(diagram_view);
-	if (diagram_view_position + 1 == m_diagram_ids.count()) {
-		// le schema est le dernier du projet
-		return;
-	}
-	m_tab -> tabBar() -> moveTab(diagram_view_position, diagram_view_position + 10);
+	moveDiagramDownx10(diagram_view -> diagram());
 }
 
 /**
 	Deplace le schema diagram vers le bas / la droite x10
 */
 void ProjectView::moveDiagramDownx10(Diagram *diagram) {
-	moveDiagramDownx10(findDiagram(diagram));
+	moveDiagram(diagram, 10);
 }
 
 /**
@@ -846,8 +900,8 @@ void ProjectView::initLayout() {
 /**
  * @brief ProjectView::loadDiagrams
  * Load diagrams of project.
- * We create a diagram view for each diagram,
- * and add it to the project view.
+ * We create a tab for each diagram, the diagram view
+ * is only created when the tab is activated.
  */
 void ProjectView::loadDiagrams()
 {
@@ -872,17 +926,18 @@ void ProjectView::loadDiagrams()
 			dialog->setProgressBar(dialog->progressBarValue()+1);
 		}
 		
-		DiagramView *sv = new DiagramView(diagram);
-		addDiagram(sv);
+		addDiagram(diagram);
 	}
 
-	this->currentDiagram()->diagram()->loadElmtFolioSeq();
-	this->currentDiagram()->diagram()->loadCndFolioSeq();
+	if (Diagram *current_diagram = diagramAt(m_tab -> currentIndex())) {
+		current_diagram->loadElmtFolioSeq();
+		current_diagram->loadCndFolioSeq();
+	}
 
 	// If project have the folios list, move it at the beginning of the project
 	if (m_project -> getFolioSheetsQuantity()) {
 		for (int i = 0; i < m_project->getFolioSheetsQuantity(); i++)
-		m_tab -> tabBar() -> moveTab(diagram_views().size()-1, + 1);
+		m_tab -> tabBar() -> moveTab(m_tab -> count()-1, + 1);
 		m_project->setModified(false);
 	}
 }
@@ -919,18 +974,17 @@ void ProjectView::adjustReadOnlyState() {
 
 /**
  * @brief ProjectView::updateTabTitle
- * Update the title of the tab which display the diagram view @diagram_view.
- * @param diagram : The diagram view.
+ * Update the title of the tab which display the diagram @diagram.
+ * @param diagram : The diagram.
  */
-void ProjectView::updateTabTitle(DiagramView *diagram_view)
+void ProjectView::updateTabTitle(Diagram *diagram)
 {
-    int diagram_tab_id = m_diagram_ids.key(diagram_view, -1);
+    int diagram_tab_id = tabIndex(diagram);
     
     if (diagram_tab_id != -1)
     {
         QSettings settings;
         QString title;
-        Diagram *diagram = diagram_view->diagram();
         
         if (settings.value("genericpanel/folio", false).toBool())
         {
@@ -953,8 +1007,8 @@ void ProjectView::updateTabTitle(DiagramView *diagram_view)
  */
 void ProjectView::updateAllTabsTitle()
 {
-	for (DiagramView *dv : m_diagram_ids.values())
-		updateTabTitle(dv);
+	for (Diagram *diagram : m_page_diagram.values())
+		updateTabTitle(diagram);
 }
 
 /**
@@ -967,42 +1021,29 @@ void ProjectView::tabMoved(int from, int to)
 		return;
 	
 	m_project->diagramOrderChanged(from, to);
-	rebuildDiagramsMap();
 	
 		//Rebuild the title of each diagram in range from - to
 	for (int i= qMin(from,to) ; i< qMax(from,to)+1 ; ++i)
 	{
-		DiagramView *dv = m_diagram_ids.value(i);
-		updateTabTitle(dv);
+		updateTabTitle(diagramAt(i));
 	}
 }
 
 /**
-	@param diagram Schema a trouver
-	@return le DiagramView correspondant au schema passe en parametre, ou 0 si
-	le schema n'est pas trouve
+	@param index Index d'un onglet
+	@return le schema affiche par l'onglet index, ou 0 si index n'est pas valide
 */
-DiagramView *ProjectView::findDiagram(Diagram *diagram) {
-	foreach(DiagramView *diagram_view, diagram_views()) {
-		if (diagram_view -> diagram() == diagram) {
-			return(diagram_view);
-		}
-	}
-	return(nullptr);
+Diagram *ProjectView::diagramAt(int index) const {
+	return(m_page_diagram.value(m_tab -> widget(index)));
 }
 
 /**
-	Reconstruit la map associant les index des onglets avec les DiagramView
+	@param diagram Schema a trouver
+	@return l'index de l'onglet du schema, ou -1 si le schema n'est pas trouve
 */
-void ProjectView::rebuildDiagramsMap() {
-	// vide la map
-	m_diagram_ids.clear();
-
-	foreach(DiagramView *diagram_view, m_diagram_view_list) {
-		int dv_idx = m_tab -> indexOf(diagram_view);
-		if (dv_idx == -1) continue;
-		m_diagram_ids.insert(dv_idx, diagram_view);
-	}
+int ProjectView::tabIndex(Diagram *diagram) const {
+	QWidget *page = m_diagram_page.value(diagram);
+	return(page ? m_tab -> indexOf(page) : -1);
 }
 
 /**
@@ -1010,6 +1051,7 @@ void ProjectView::rebuildDiagramsMap() {
  * Manage the tab change.
  * If tab_id == -1 (there is no diagram opened),
  * we display the fallback widget.
+ * The view of the diagram is created if needed.
  * @param tab_id
  */
 void ProjectView::tabChanged(int tab_id)
@@ -1019,15 +1061,29 @@ void ProjectView::tabChanged(int tab_id)
 	else if(m_tab->count() == 1)
 		setDisplayFallbackWidget(false);
 	
-	emit(diagramActivated(m_diagram_ids[tab_id]));
+	Diagram *diagram = diagramAt(tab_id);
+	DiagramView *diagram_view = nullptr;
+	if (diagram)
+	{
+		diagram_view = m_diagram_views.value(diagram);
+		if (!diagram_view)
+			diagram_view = createDiagramView(diagram);
+		m_activated_diagrams.removeAll(diagram);
+		m_activated_diagrams.prepend(diagram);
+	}
+
+	emit(diagramActivated(diagram_view));
 	
-	if (m_diagram_ids[tab_id] != nullptr)
-		m_diagram_ids[tab_id]->diagram()->diagramActivated();
+	if (diagram)
+		diagram->diagramActivated();
 
 		//Clear the event interface of the previous diagram
-	if (DiagramView *dv = m_diagram_ids[m_previous_tab_index])
-		dv->diagram()->clearEventInterface();
-	m_previous_tab_index = tab_id;
+	Diagram *previous = m_previous_diagram;
+	if (previous && previous != diagram)
+		previous->clearEventInterface();
+	m_previous_diagram = diagram;
+
+	releaseInactiveDiagramViews(previous);
 }
 
 /**
@@ -1036,10 +1092,7 @@ void ProjectView::tabChanged(int tab_id)
 */
 void ProjectView::tabDoubleClicked(int tab_id) {
 	// repere le schema concerne
-	DiagramView *diagram_view = m_diagram_ids[tab_id];
-	if (!diagram_view) return;
-
-	diagram_view -> editDiagramProperties();
+	editDiagramProperties(diagramAt(tab_id));
 }
 
 /**
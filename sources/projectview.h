@@ -19,6 +19,9 @@
 #define PROJECT_VIEW_H
 
 #include <QWidget>
+#include <QTransform>
+#include <QPointer>
+#include <QHash>
 
 #include "templatelocation.h"
 #include "qetresult.h"
@@ -34,6 +37,11 @@ class QVBoxLayout;
 /**
 	This class provides a widget displaying the diagrams of a particular
 	project using tabs.
+	The DiagramView of a folio is only created when its tab is activated for
+	the first time, until then the tab contains an empty page. The views of the
+	least recently activated tabs are released when their count exceed the
+	setting "diagrameditor/max-diagram-views" (0 for no limit), their zoom and
+	scroll position are restored when they are created again.
 */
 class ProjectView : public QWidget
 {
@@ -52,6 +60,7 @@ class ProjectView : public QWidget
 		void setProject(QETProject *);
 		QList<DiagramView *> diagram_views() const;
 		DiagramView *currentDiagram() const;
+		DiagramView *diagramView(Diagram *) const;
 		void closeEvent(QCloseEvent *) override;
 		void changeTabUp();
 		void changeTabDown();
@@ -61,7 +70,7 @@ class ProjectView : public QWidget
 	public slots:
 		void addNewDiagram();
 		void addNewDiagramFolioList();
-		void addDiagram(DiagramView *);
+		void addDiagram(Diagram *);
 		void removeDiagram(DiagramView *);
 		void removeDiagram(Diagram *);
 		void showDiagram(DiagramView *);
@@ -87,7 +96,7 @@ class ProjectView : public QWidget
 		QETResult doSave();
 		int cleanProject();
 		void updateWindowTitle();
-		void updateTabTitle(DiagramView *);
+		void updateTabTitle(Diagram *);
 		void updateAllTabsTitle();
 		void tabMoved(int, int);
 
@@ -106,12 +115,12 @@ class ProjectView : public QWidget
 		void initWidgets();
 		void initLayout();
 		void loadDiagrams();
-		DiagramView *findDiagram(Diagram *);
-		DiagramView *nextDiagram();
-		DiagramView *previousDiagram();
-		DiagramView *firstDiagram();
-		DiagramView *lastDiagram();
-		void rebuildDiagramsMap();
+		Diagram *diagramAt(int) const;
+		int tabIndex(Diagram *) const;
+		void moveDiagram(Diagram *, int);
+		DiagramView *createDiagramView(Diagram *);
+		void releaseDiagramView(Diagram *);
+		void releaseInactiveDiagramViews(Diagram *previous = nullptr);
 		bool tryClosing();
 		bool tryClosingElementEditors();
 		int tryClosingDiagrams();
@@ -132,9 +141,22 @@ class ProjectView : public QWidget
 		QWidget *fallback_widget_;
 		QLabel *fallback_label_;
 		QTabWidget *m_tab;
-		QMap<int, DiagramView *> m_diagram_ids;
-		int m_previous_tab_index = -1;
-		QList<DiagramView *> m_diagram_view_list;
+
+			///Zoom and scroll position of a released view
+		struct DiagramViewState {
+			QTransform transform;
+			int horizontal_value;
+			int vertical_value;
+		};
+
+		QHash<QWidget *, Diagram *> m_page_diagram;
+		QHash<Diagram *, QWidget *> m_diagram_page;
+		QHash<Diagram *, DiagramView *> m_diagram_views;
+		QHash<Diagram *, DiagramViewState> m_view_states;
+			///Diagrams which have a view, the most recently activated first
+		QList<Diagram *> m_activated_diagrams;
+		QPointer<Diagram> m_previous_diagram;
+		int m_max_diagram_views = 0;
 };
 
 #endif
@@ -40,6 +40,8 @@
 #define STRINGIFY(x) #x
 #include <QProcessEnvironment>
 #include "factory/elementfactory.h"
+#include "memoryreport.h"
+#include "qettrace.h"
 
 #include <KAutoSaveFile>
 
@@ -135,6 +137,7 @@ QETApp::~QETApp()
 	
 	ElementFactory::dropInstance();
 	ElementPictureFactory::dropInstance();
+	QetTrace::stop();
 }
 
 /**
@@ -1286,6 +1289,14 @@ void QETApp::openFiles(const QETArguments &args) {
 	openProjectFiles(args.projectFiles());
 	openElementFiles(args.elementFiles());
 	openTitleBlockTemplateFiles(args.titleBlockTemplateFiles());
+
+	if (args.printMemoryReportRequested())
+	{
+		for (QETProject *project : registeredProjects().values()) {
+			std::cout << qPrintable(MemoryReport::projectReport(project));
+		}
+		std::cout << qPrintable(MemoryReport::definitionsReport()) << std::endl;
+	}
 }
 
 /**
@@ -1564,6 +1575,10 @@ void QETApp::parseArguments() {
 		overrideLangDir(qet_arguments_.langDir());
 	}
 
+	if (qet_arguments_.traceFileSpecified()) {
+		QetTrace::start(qet_arguments_.traceFile());
+	}
+
 	if (qet_arguments_.printLicenseRequested()) {
 		printLicense();
 		non_interactive_execution_ = true;
@@ -1914,7 +1929,8 @@ void QETApp::printHelp() {
 		"Options disponibles : \n"
 		"  --help                        Afficher l'aide sur les options\n"
 		"  -v, --version                 Afficher la version\n"
-		"  --license                     Afficher la licence\n")
+		"  --license                     Afficher la licence\n"
+		"  --memory-report               Afficher l'occupation memoire des projets ouverts\n")
 #ifdef QET_ALLOW_OVERRIDE_CED_OPTION
 		+ tr("  --common-elements-dir=DIR     Definir le dossier de la collection d'elements\n")
 #endif
@@ -1925,6 +1941,9 @@ void QETApp::printHelp() {
 		+ tr("  --config-dir=DIR              Definir le dossier de configuration\n")
 #endif
 		+ tr("  --lang-dir=DIR                Definir le dossier contenant les fichiers de langue\n")
+#ifdef QET_ENABLE_TRACING
+		+ tr("  --trace=FICHIER               Enregistrer une trace d'execution (format Chrome trace_event)\n")
+#endif
 	);
 	std::cout << qPrintable(help) << std::endl;
 }
@@ -26,7 +26,8 @@ QETArguments::QETArguments(QObject *parent) :
 	QObject(parent),
 	print_help_(false),
 	print_license_(false),
-	print_version_(false)
+	print_version_(false),
+	print_memory_report_(false)
 {
 }
 
@@ -39,7 +40,8 @@ QETArguments::QETArguments(const QList<QString> &args, QObject *parent) :
 	QObject(parent),
 	print_help_(false),
 	print_license_(false),
-	print_version_(false)
+	print_version_(false),
+	print_memory_report_(false)
 {
 	parseArguments(args);
 }
@@ -65,9 +67,11 @@ common_tbt_dir_(qet_arguments.common_tbt_dir_),
 	config_dir_(qet_arguments.config_dir_),
 #endif
 	lang_dir_(qet_arguments.lang_dir_),
+	trace_file_(qet_arguments.trace_file_),
 	print_help_(qet_arguments.print_help_),
 	print_license_(qet_arguments.print_license_),
-	print_version_(qet_arguments.print_version_)
+	print_version_(qet_arguments.print_version_),
+	print_memory_report_(qet_arguments.print_memory_report_)
 {
 }
 
@@ -91,9 +95,11 @@ QETArguments &QETArguments::operator=(const QETArguments &qet_arguments) {
 	config_dir_ = qet_arguments.config_dir_;
 #endif
 	lang_dir_        = qet_arguments.lang_dir_;
+	trace_file_      = qet_arguments.trace_file_;
 	print_help_      = qet_arguments.print_help_;
 	print_license_   = qet_arguments.print_license_;
 	print_version_   = qet_arguments.print_version_;
+	print_memory_report_ = qet_arguments.print_memory_report_;
 	return(*this);
 }
 
@@ -181,6 +187,7 @@ void QETArguments::clear() {
 #ifdef QET_ALLOW_OVERRIDE_CD_OPTION
 	config_dir_.clear();
 #endif
+	trace_file_.clear();
 }
 
 /**
@@ -235,6 +242,8 @@ void QETArguments::handleFileArgument(const QString &file) {
 	  * --version
 	  * -v
 	  * --license
+	  * --memory-report
+	  * --trace=
 */
 void QETArguments::handleOptionArgument(const QString &option) {
 	if (option == QString("--help")) {
@@ -249,6 +258,10 @@ void QETArguments::handleOptionArgument(const QString &option) {
 		print_license_ = true;
 		options_ << option;
 		return;
+	} else if (option == QString("--memory-report")) {
+		print_memory_report_ = true;
+		options_ << option;
+		return;
 	}
 	
 #ifdef QET_ALLOW_OVERRIDE_CED_OPTION
@@ -281,6 +294,12 @@ void QETArguments::handleOptionArgument(const QString &option) {
 		return;
 	}
 	
+	QString trace_arg("--trace=");
+	if (option.startsWith(trace_arg)) {
+		trace_file_ = option.mid(trace_arg.length());
+		return;
+	}
+	
 	// a ce stade, l'option est inconnue
 	unknown_options_ << option;
 }
@@ -353,6 +372,22 @@ QString QETArguments::langDir() const {
 	return(lang_dir_);
 }
 
+/**
+	@return true si l'utilisateur a demande l'enregistrement d'une trace
+	d'execution
+*/
+bool QETArguments::traceFileSpecified() const {
+	return(!trace_file_.isEmpty());
+}
+
+/**
+	@return le fichier dans lequel la trace d'execution doit etre ecrite.
+	Si l'utilisateur n'en a pas specifie, une chaine vide est retournee.
+*/
+QString QETArguments::traceFile() const {
+	return(trace_file_);
+}
+
 /**
 	@return true si les arguments comportent une demande d'affichage de l'aide,
 	false sinon
@@ -376,3 +411,11 @@ bool QETArguments::printLicenseRequested() const {
 bool QETArguments::printVersionRequested() const {
 	return(print_version_);
 }
+
+/**
+	@return true si les arguments comportent une demande d'affichage de
+	l'occupation memoire des projets ouverts, false sinon
+*/
+bool QETArguments::printMemoryReportRequested() const {
+	return(print_memory_report_);
+}
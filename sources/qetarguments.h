@@ -56,9 +56,12 @@ class QETArguments : public QObject {
 #endif
 	virtual bool langDirSpecified() const;
 	virtual QString langDir() const;
+	virtual bool traceFileSpecified() const;
+	virtual QString traceFile() const;
 	virtual bool printHelpRequested() const;
 	virtual bool printLicenseRequested() const;
 	virtual bool printVersionRequested() const;
+	virtual bool printMemoryReportRequested() const;
 	virtual QList<QString> options() const;
 	virtual QList<QString> unknownOptions() const;
 	
@@ -85,8 +88,10 @@ class QETArguments : public QObject {
 	QString config_dir_;
 #endif
 	QString lang_dir_;
+	QString trace_file_;
 	bool print_help_;
 	bool print_license_;
 	bool print_version_;
+	bool print_memory_report_;
 };
 #endif
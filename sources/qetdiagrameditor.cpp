@@ -48,8 +48,11 @@
 #include "diagramcommands.h"
 #include "dialogwaiting.h"
 #include "addelementtextcommand.h"
+#include "undohistory.h"
 
 #include <QMessageBox>
+#include <QLabel>
+#include <QVBoxLayout>
 #include <QStandardPaths>
 #include <KAutoSaveFile>
 
@@ -197,13 +200,26 @@ void QETDiagramEditor::setUpUndoStack() {
 	undo_view -> setStatusTip  (tr("Cliquez sur une action pour revenir en arrière dans l'édition de votre schéma", "Status tip"));
 	undo_view -> setWhatsThis  (tr("Ce panneau liste les différentes actions effectuées sur le folio courant. Cliquer sur une action permet de revenir à l'état du schéma juste après son application.", "\"What's this\" tip"));
 
+		//Memory used by the undo list, kept under the budget by UndoHistory
+	m_undo_memory_label = new QLabel(this);
+	m_undo_memory_label -> setWordWrap(true);
+	connect(&undo_group, &QUndoGroup::indexChanged,       this, &QETDiagramEditor::slot_updateUndoMemory);
+	connect(&undo_group, &QUndoGroup::activeStackChanged, this, &QETDiagramEditor::slot_updateUndoMemory);
+
+	QWidget *undo_widget = new QWidget(this);
+	QVBoxLayout *undo_layout = new QVBoxLayout(undo_widget);
+	undo_layout -> setContentsMargins(0, 0, 0, 0);
+	undo_layout -> addWidget(undo_view);
+	undo_layout -> addWidget(m_undo_memory_label);
+
 	qdw_undo  = new QDockWidget(tr("Annulations", "dock title"), this);
 	qdw_undo -> setObjectName("diagram_undo");
 
 	qdw_undo -> setAllowedAreas(Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea);
 	qdw_undo -> setFeatures(QDockWidget::AllDockWidgetFeatures);
 	qdw_undo -> setMinimumWidth(160);
-	qdw_undo -> setWidget(undo_view);
+	qdw_undo -> setWidget(undo_widget);
+	slot_updateUndoMemory();
 
 	addDockWidget(Qt::LeftDockWidgetArea, qdw_undo);
 }
@@ -1185,10 +1201,8 @@ ProjectView *QETDiagramEditor::findProject(DiagramView *diagram_view) const {
 */
 ProjectView *QETDiagramEditor::findProject(Diagram *diagram) const {
 	foreach(ProjectView *project_view, openedProjects()) {
-		foreach(DiagramView *diagram_view, project_view -> diagram_views()) {
-			if (diagram_view -> diagram() == diagram) {
-				return(project_view);
-			}
+		if (project_view -> project() -> diagrams().contains(diagram)) {
+			return(project_view);
 		}
 	}
 	return(nullptr);
@@ -1467,6 +1481,26 @@ void QETDiagramEditor::slot_updateUndoStack()
 		undo_group.setActiveStack(currentProjectView()->project()->undoStack());
 }
 
+/**
+ * @brief QETDiagramEditor::slot_updateUndoMemory
+ * Display the memory used by the undo list of the current project,
+ * and the size of the data spilled to the disk.
+ */
+void QETDiagramEditor::slot_updateUndoMemory()
+{
+	ProjectView *pv = currentProjectView();
+	if (!pv || pv->project()->undoStack() != undo_group.activeStack())
+	{
+		m_undo_memory_label -> clear();
+		return;
+	}
+
+	UndoHistory *history = pv->project()->undoHistory();
+	m_undo_memory_label -> setText(tr("Mémoire : %1 Kio, %2 Kio sur le disque")
+								   .arg(history->memorySize() / 1024)
+								   .arg(history->spilledSize() / 1024));
+}
+
 /**
  * @brief QETDiagramEditor::slot_updateComplexActions
  * Manage the actions who need some conditions to be enable or not.
@@ -1507,8 +1541,8 @@ void QETDiagramEditor::slot_updateComplexActions()
 	m_rotate_selection -> setEnabled(!ro && diagram_->canRotateSelection());
 
 		//Action that need selected texts or texts group
-	QList<DiagramTextItem *> texts = DiagramContent(diagram_).selectedTexts();
-	QList<ElementTextItemGroup *> groups = DiagramContent(diagram_).selectedTextsGroup();
+	QList<DiagramTextItem *> texts = dc.selectedTexts();
+	QList<ElementTextItemGroup *> groups = dc.selectedTextsGroup();
 	int selected_texts = texts.count();
 	int selected_conductor_texts   = 0; for(DiagramTextItem *dti : texts) {if(dti->type() == ConductorTextItem::Type) selected_conductor_texts++;}
 	int selected_dynamic_elmt_text = 0; for(DiagramTextItem *dti : texts) {if(dti->type() == DynamicElementTextItem::Type) selected_dynamic_elmt_text++;}
@@ -2096,17 +2130,17 @@ void QETDiagramEditor::removeDiagramFromProject() {
 
 			// if the removed diagram was a folio sheet, then delete all the remaining folio sheets also.
 			if (isFolioList) {
-				foreach (DiagramView *diag, current_project -> diagram_views()) {
-					if (dynamic_cast<DiagramFolioList *>(diag -> diagram())) {
+				foreach (Diagram *diag, current_project -> project() -> diagrams()) {
+					if (dynamic_cast<DiagramFolioList *>(diag)) {
 						current_project -> removeDiagram(diag);
 					}
 				}
 
 			  // else if after diagram removal, the total diagram quantity becomes a factor of 58, then
 			  // remove one (last) folio sheet.
-			} else if (current_project -> diagram_views().size() % 58 == 0) {
-				foreach (DiagramView *diag, current_project -> diagram_views()) {
-					DiagramFolioList *ptr = dynamic_cast<DiagramFolioList *>(diag -> diagram());
+			} else if (current_project -> project() -> diagrams().size() % 58 == 0) {
+				foreach (Diagram *diag, current_project -> project() -> diagrams()) {
+					DiagramFolioList *ptr = dynamic_cast<DiagramFolioList *>(diag);
 					if (ptr && ptr -> getId() == current_project -> project() -> getFolioSheetsQuantity() - 1) {
 						current_project -> removeDiagram(diag);
 					}
@@ -2125,6 +2159,11 @@ void QETDiagramEditor::diagramWasAdded(DiagramView *dv)
 {
 	connect(dv, SIGNAL(selectionChanged()), this, SLOT(selectionChanged()));
 	connect(dv, SIGNAL(modeChanged()),      this, SLOT(slot_updateModeActions()));
+
+		//Views are created when their folio is displayed, apply the current mode
+	if (m_mode_visualise && m_mode_visualise->isChecked()) {
+		dv->setVisualisationMode();
+	}
 }
 
 /**
@@ -28,6 +28,7 @@
 #include "searchandreplacewidget.h"
 
 class QMdiSubWindow;
+class QLabel;
 class QETProject;
 class QETResult;
 class ProjectView;
@@ -107,6 +108,7 @@ class QETDiagramEditor : public QETMainWindow
 		void rowColumnGroupTriggered (QAction *action);
 		void slot_updateActions();
 		void slot_updateUndoStack();
+		void slot_updateUndoMemory();
 		void slot_updateModeActions();
 		void slot_updateComplexActions();
 		void slot_updatePasteAction();
@@ -207,6 +209,7 @@ class QETDiagramEditor : public QETMainWindow
 		QDockWidget *qdw_pa; /// Dock for the elements panel
 		QDockWidget *m_qdw_elmt_collection;
 		QDockWidget *qdw_undo; /// Dock for the undo list
+		QLabel *m_undo_memory_label; /// Memory used by the undo list of the current project
 		ElementsCollectionWidget *m_element_collection_widget;
 			
 		DiagramPropertiesEditorDockWidget *m_selection_properties_editor;
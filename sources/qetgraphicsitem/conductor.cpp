@@ -29,6 +29,7 @@
 #include "conductorpropertiesdialog.h"
 #include "QPropertyUndoCommand/qpropertyundocommand.h"
 #include "numerotationcontextcommands.h"
+#include "qettrace.h"
 
 #define PR(x) qDebug() << #x " = " << x;
 
@@ -157,6 +158,7 @@ bool Conductor::isValid() const {
 	@see QGraphicsPathItem::update()
 */
 void Conductor::updatePath(const QRectF &rect) {
+	QET_TRACE("Conductor::updatePath");
 	QPointF p1, p2;
 	p1 = terminal1 -> dockConductor();
 	p2 = terminal2 -> dockConductor();
@@ -342,6 +344,7 @@ QHash<ConductorSegmentProfile *, qreal> Conductor::shareOffsetBetweenSegments(
 	@param o2 Orientation de la borne 2
 */
 void Conductor::generateConductorPath(const QPointF &p1, Qet::Orientation o1, const QPointF &p2, Qet::Orientation o2) {
+	QET_TRACE("Conductor::generateConductorPath");
 	QPointF sp1, sp2, depart, newp1, newp2, arrivee, depart0, arrivee0;
 	Qet::Orientation ori_depart, ori_arrivee;
 	
@@ -1446,9 +1449,16 @@ void Conductor::setPath(const QPainterPath &path)
 	if(path == m_path)
 		return;
 	
+	Diagram *diagram_ = diagram();
+	if (diagram_) {
+		diagram_->itemGeometryAboutToChange(this);
+	}
 	prepareGeometryChange();
 	m_path = path;
 	update();
+	if (diagram_) {
+		diagram_->itemGeometryChanged(this);
+	}
 }
 
 QPainterPath Conductor::path() const
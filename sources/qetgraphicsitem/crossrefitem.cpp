@@ -87,7 +87,9 @@ void CrossRefItem::init()
 	
 	setUpConnection();
 	linkedChanged();
-	updateLabel();
+		//The bounding rect must be known as soon as the Xref is created
+		//(see MasterElement::aboutDeleteXref)
+	rebuildLabel();
 }
 
 /**
@@ -184,10 +186,36 @@ void CrossRefItem::updateProperties()
 
 /**
  * @brief CrossRefItem::updateLabel
- * Update the content of the item
+ * Update the content of the item.
+ * The update is done at the next turn of the event loop, so several calls
+ * (for example when a lot of linked elements are moved at once) are drawn only one time.
  */
 void CrossRefItem::updateLabel()
 {
+	if (m_label_update_scheduled)
+		return;
+	m_label_update_scheduled = true;
+	QMetaObject::invokeMethod(this, "rebuildLabel", Qt::QueuedConnection);
+}
+
+/**
+ * @brief CrossRefItem::rebuildLabel
+ * Draw the content of the item, only if what is displayed changed
+ * since the last draw (linked elements, their position, the properties...)
+ */
+void CrossRefItem::rebuildLabel()
+{
+	m_label_update_scheduled = false;
+		//The element can be removed from its diagram since the update was asked
+	if (!m_element->diagram())
+		return;
+
+	QStringList signature = labelSignature();
+	if (signature == m_label_signature && m_properties == m_drawn_properties)
+		return;
+	m_label_signature  = signature;
+	m_drawn_properties = m_properties;
+
 		//init the shape and bounding rect
 	m_shape_path    = QPainterPath();
 	prepareGeometryChange();
@@ -220,6 +248,31 @@ void CrossRefItem::updateLabel()
 	update();
 }
 
+/**
+ * @brief CrossRefItem::labelSignature
+ * @return a list of strings describing everything displayed by this Xref
+ * except the properties : if the list is the same between two updates,
+ * the drawing is already up to date.
+ */
+QStringList CrossRefItem::labelSignature() const
+{
+	QStringList signature;
+	signature << QETApp::diagramTextsFont(5).toString()
+			  << QString::number(m_element->isFree())
+			  << QString::number(reinterpret_cast<quintptr>(m_hovered_contact));
+
+	for (Element *elmt : m_element->linkedElements())
+	{
+		DiagramContext info = elmt->kindInformations();
+		signature << QString::number(reinterpret_cast<quintptr>(elmt))
+				  << elementPositionText(elmt)
+				  << info["type"].toString()
+				  << info["state"].toString()
+				  << info["number"].toString();
+	}
+	return signature;
+}
+
 /**
  * @brief CrossRefItem::autoPos
  * Calculate and set position automaticaly.
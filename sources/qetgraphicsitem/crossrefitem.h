@@ -84,8 +84,12 @@ class CrossRefItem : public QGraphicsObject
 		void hoverMoveEvent(QGraphicsSceneHoverEvent *event) override;
 		void hoverLeaveEvent(QGraphicsSceneHoverEvent *event) override;
 
+	private slots:
+		void rebuildLabel();
+
 	private:
 		void linkedChanged();
+		QStringList labelSignature() const;
 		void buildHeaderContact		();
 		void setUpCrossBoundingRect (QPainter &painter);
 		void drawAsCross			(QPainter &painter);
@@ -110,6 +114,9 @@ class CrossRefItem : public QGraphicsObject
 		ElementTextItemGroup *m_group = nullptr;
 		QList <QMetaObject::Connection> m_slave_connection;
 		QList <QMetaObject::Connection> m_update_connection;
+		QStringList    m_label_signature;
+		XRefProperties m_drawn_properties;
+		bool m_label_update_scheduled = false;
 };
 
 #endif // CROSSREFITEM_H
@@ -20,6 +20,7 @@
 #include "qetapp.h"
 #include "richtext/richtexteditor_p.h"
 #include "diagram.h"
+#include <QAbstractTextDocumentLayout>
 
 /**
  * @brief DiagramTextItem::DiagramTextItem
@@ -54,6 +55,14 @@ void DiagramTextItem::build()
 	setFlags(QGraphicsItem::ItemIsSelectable|QGraphicsItem::ItemIsMovable | QGraphicsItem::ItemSendsGeometryChanges);
 	setNoEditable(false);
 	setToolTip(tr("Maintenir ctrl pour un déplacement libre"));
+
+		//The bounding rect of the items of the diagram must grow when the text grows
+	connect(document()->documentLayout(), &QAbstractTextDocumentLayout::documentSizeChanged, this, [this]()
+	{
+		if (Diagram *diagram_ = diagram()) {
+			diagram_->itemGeometryChanged(this);
+		}
+	});
 }
 
 /**
@@ -260,6 +269,29 @@ void DiagramTextItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *o
 
 }
 
+/**
+ * @brief DiagramTextItem::itemChange
+ * Notify the diagram of the moves of this text, to keep up to date
+ * the bounding rect of the items of the diagram
+ * @param change
+ * @param value
+ * @return
+ */
+QVariant DiagramTextItem::itemChange(QGraphicsItem::GraphicsItemChange change, const QVariant &value)
+{
+	if (Diagram *diagram_ = diagram())
+	{
+		if (change == ItemPositionChange || change == ItemRotationChange) {
+			diagram_->itemGeometryAboutToChange(this);
+		}
+		else if (change == ItemPositionHasChanged || change == ItemRotationHasChanged) {
+			diagram_->itemGeometryChanged(this);
+		}
+	}
+
+	return QGraphicsTextItem::itemChange(change, value);
+}
+
 /**
  * @brief DiagramTextItem::focusInEvent
  * @param e
@@ -86,6 +86,7 @@ class DiagramTextItem : public QGraphicsTextItem
 
 	protected:
 		void paint(QPainter *, const QStyleOptionGraphicsItem *, QWidget *) override;
+		QVariant itemChange(GraphicsItemChange change, const QVariant &value) override;
 		void focusInEvent(QFocusEvent *) override;
 		void focusOutEvent(QFocusEvent *) override;
 
@@ -683,7 +683,7 @@ QVariant DynamicElementTextItem::itemChange(QGraphicsItem::GraphicsItemChange ch
 	if(change == QGraphicsItem::ItemSceneHasChanged && m_first_scene_change)
 	{
 		if(m_parent_element.isNull())
-			return QGraphicsObject::itemChange(change, value);
+			return DiagramTextItem::itemChange(change, value);
 		
 			//If the parent is slave, we keep aware about the changement of master.
 		if(m_parent_element.data()->linkType() == Element::Slave)
@@ -727,7 +727,7 @@ QVariant DynamicElementTextItem::itemChange(QGraphicsItem::GraphicsItemChange ch
 		}
 		
 		m_first_scene_change = false;
-		return QGraphicsObject::itemChange(change, value);
+		return DiagramTextItem::itemChange(change, value);
 	}
 	else if (change == QGraphicsItem::ItemParentHasChanged)
 	{
@@ -735,7 +735,7 @@ QVariant DynamicElementTextItem::itemChange(QGraphicsItem::GraphicsItemChange ch
 		updateXref();
 	}
 	
-	return QGraphicsObject::itemChange(change, value);
+	return DiagramTextItem::itemChange(change, value);
 }
 
 bool DynamicElementTextItem::sceneEventFilter(QGraphicsItem *watched, QEvent *event)
@@ -776,10 +776,10 @@ void DynamicElementTextItem::elementInfoChanged()
 		{
 			setupFormulaConnection();
 			
-			if (dc.value("formula").toString().isEmpty())
-				final_text = dc.value(m_info_name).toString();
+			if (dc.value(DiagramContext::Formula).toString().isEmpty())
+				final_text = dc.value(DiagramContext::Label).toString();
 			else
-				final_text = autonum::AssignVariables::formulaToLabel(dc.value("formula").toString(), element->rSequenceStruct(), element->diagram(), element);
+				final_text = autonum::AssignVariables::formulaToLabel(dc.value(DiagramContext::Formula).toString(), element->rSequenceStruct(), element->diagram(), element);
 		}
 		else
 			final_text = dc.value(m_info_name).toString();
@@ -957,7 +957,7 @@ void DynamicElementTextItem::setupFormulaConnection()
 			return;
 		
 		Diagram *diagram = element->diagram();
-		QString formula = element->elementInformations().value("formula").toString();
+		QString formula = element->elementInformations().value(DiagramContext::Formula).toString();
 
 			//Label is frozen, so we don't update it.
 		if (element->isFreezeLabel())
@@ -1047,10 +1047,10 @@ void DynamicElementTextItem::updateLabel()
 		
 		if(m_text_from == ElementInfo)
 		{
-			if(dc.value("formula").toString().isEmpty())
-				setPlainText(dc.value("label").toString());
+			if(dc.value(DiagramContext::Formula).toString().isEmpty())
+				setPlainText(dc.value(DiagramContext::Label).toString());
 			else
-				setPlainText(autonum::AssignVariables::formulaToLabel(dc.value("formula").toString(), element->rSequenceStruct(), element->diagram(), element));
+				setPlainText(autonum::AssignVariables::formulaToLabel(dc.value(DiagramContext::Formula).toString(), element->rSequenceStruct(), element->diagram(), element));
 		}
 		else if (m_text_from == CompositeText)
 			setPlainText(autonum::AssignVariables::replaceVariable(m_composite_text, dc));
@@ -73,6 +73,9 @@ Element::Element(const ElementsLocation &location, QGraphicsItem *parent, int *s
 	m_link_type (link_type),
 	m_location (location)
 {
+	const QDomElement xml_definition = location.xml();
+	m_definition = ElementDefinitionData::definition(location, xml_definition);
+
 	if(! (location.isElement() && location.exist()))
 	{
 		if (state)
@@ -82,7 +85,7 @@ Element::Element(const ElementsLocation &location, QGraphicsItem *parent, int *s
 		}
 	}
 	int elmt_state;
-	buildFromXml(location.xml(), &elmt_state);
+	buildFromXml(xml_definition, &elmt_state);
 	if (state) {
 		*state = elmt_state;
 	}
@@ -96,7 +99,7 @@ Element::Element(const ElementsLocation &location, QGraphicsItem *parent, int *s
 	setPrefix(autonum::elementPrefixForLocation(location));
 	m_uuid = QUuid::createUuid();
 	setZValue(10);
-	setFlags(QGraphicsItem::ItemIsMovable | QGraphicsItem::ItemIsSelectable);
+	setFlags(QGraphicsItem::ItemIsMovable | QGraphicsItem::ItemIsSelectable | QGraphicsItem::ItemSendsGeometryChanges);
 	setAcceptHoverEvents(true);
 	
 	connect(this, &Element::rotationChanged, [this]() {
@@ -113,6 +116,9 @@ Element::Element(const ElementsLocation &location, QGraphicsItem *parent, int *s
  */
 Element::~Element()
 {
+	if (Diagram *diagram_ = diagram()) {
+		diagram_->removeFromTerminalIndex(this);
+	}
 	qDeleteAll (m_dynamic_text_list);
 	qDeleteAll (m_terminals);
 }
@@ -181,16 +187,21 @@ void Element::displayHelpLine(bool b)
  * @param options
  * @param widget
  */
-void Element::paint(QPainter *painter, const QStyleOptionGraphicsItem *options, QWidget *)
+void Element::paint(QPainter *painter, const QStyleOptionGraphicsItem *options, QWidget *widget)
 {
 	if (m_must_highlight) {
 		drawHighlight(painter, options);
 	}
 	
-	if (options && options -> levelOfDetail < 1.0) {
-		painter->drawPicture(0, 0, m_low_zoom_picture);
+		//At far zoom in a view, the pixmap shared by the elements of this definition is used.
+		//Not when the scene is rendered for an export or a print (@widget is nullptr)
+	if (widget && options && options -> levelOfDetail < ElementDefinitionData::farZoomLevel()) {
+		QPixmap pixmap = m_definition->farZoomPixmap(options -> levelOfDetail, widget -> devicePixelRatioF());
+		painter->drawPixmap(m_definition->farZoomRect(), pixmap, QRectF(pixmap.rect()));
+	} else if (options && options -> levelOfDetail < 1.0) {
+		painter->drawPicture(0, 0, m_definition->low_zoom_picture);
 	} else {
-		painter->drawPicture(0, 0, m_picture);
+		painter->drawPicture(0, 0, m_definition->picture);
 	}
 	
 		//Draw the selection rectangle
@@ -396,12 +407,9 @@ bool Element::buildFromXml(const QDomElement &xml_def_elmt, int *state)
 		m_state = QET::GIOK;
 		return(false);
 	}
-		//Extract the names
-	m_names.fromXml(xml_def_elmt);
+		//The names and the kind informations are read once per definition, see ElementDefinitionData
 	setToolTip(name());
 
-		//load kind informations
-	m_kind_informations.fromXml(xml_def_elmt.firstChildElement("kindInformations"), "kindInformation");
 		//load element information
 	m_element_informations.fromXml(xml_def_elmt.firstChildElement("elementInformations"), "elementInformation");
 
@@ -452,10 +460,7 @@ bool Element::buildFromXml(const QDomElement &xml_def_elmt, int *state)
 		}
 	}
 
-	ElementPictureFactory *epf = ElementPictureFactory::instance();
-	epf->getPictures(m_location, const_cast<QPicture&>(m_picture), const_cast<QPicture&>(m_low_zoom_picture));
-	
-	if(!m_picture.isNull())
+	if(!m_definition->picture.isNull())
 		++ parsed_elements_count;
 
 		//They must be at least one parsed graphics part
@@ -720,7 +725,7 @@ bool Element::fromXml(QDomElement &e, QHash<int, Terminal *> &table_id_adr, bool
 		//We directly call setPos from QGraphicsObject, because QetGraphicsItem will snap to grid
 	QGraphicsObject::setPos(e.attribute("x").toDouble(), e.attribute("y").toDouble());
 	setZValue(e.attribute("z", QString::number(this->zValue())).toDouble());
-	setFlags(QGraphicsItem::ItemIsMovable | QGraphicsItem::ItemIsSelectable);
+	setFlags(QGraphicsItem::ItemIsMovable | QGraphicsItem::ItemIsSelectable | QGraphicsItem::ItemSendsGeometryChanges);
 	
 	// orientation
 	bool conv_ok;
@@ -841,14 +846,14 @@ bool Element::fromXml(QDomElement &e, QHash<int, Terminal *> &table_id_adr, bool
 		 * this mean the label was made before commit 4791 (0.51 dev). So we swap the value stored in "label" to "formula" as expected.
 		 * @TODO remove this code at version 0.7 or more (probably useless).
 		 */
-	if (dc["label"].toString().contains("%") && dc["formula"].toString().isNull())
+	if (dc.value(DiagramContext::Label).toString().contains("%") && dc.value(DiagramContext::Formula).toString().isNull())
 	{
-		dc.addValue("formula", dc["label"]);
+		dc.addValue(DiagramContext::Formula, dc.value(DiagramContext::Label));
 	}
 		//retrocompatibility with older version
-	if(dc.value("label").toString().isEmpty() &&
-	   !m_element_informations.value("label").toString().isEmpty())
-		dc.addValue("label", m_element_informations.value("label"));
+	if(dc.value(DiagramContext::Label).toString().isEmpty() &&
+	   !m_element_informations.value(DiagramContext::Label).toString().isEmpty())
+		dc.addValue(DiagramContext::Label, m_element_informations.value(DiagramContext::Label));
 	
 		//We must to block the update of the alignment when load the information
 		//otherwise the pos of the text will not be the same as it was at save time.
@@ -879,7 +884,7 @@ bool Element::fromXml(QDomElement &e, QHash<int, Terminal *> &table_id_adr, bool
 		
 		if((m_link_type != Master) ||
 		   ((m_link_type == Master) &&
-			(diagram()->project()->defaultXRefProperties(m_kind_informations["type"].toString()).snapTo() == XRefProperties::Label))
+			(diagram()->project()->defaultXRefProperties(m_definition->kind_informations["type"].toString()).snapTo() == XRefProperties::Label))
 		   )
 		{
 			if(!label.isEmpty() && la &&
@@ -1426,6 +1431,38 @@ bool comparPos(const Element *elmt1, const Element *elmt2) {
 	return elmt1->pos().x() <= elmt2->pos().x();
 }
 
+/**
+ * @brief Element::itemChange
+ * Keep up to date the index of terminals of the diagram,
+ * and the help lines of the terminals when they are displayed
+ * @param change
+ * @param value
+ * @return
+ */
+QVariant Element::itemChange(QGraphicsItem::GraphicsItemChange change, const QVariant &value)
+{
+	if (change == ItemSceneChange)
+	{
+		if (Diagram *diagram_ = diagram()) {
+			diagram_->removeFromTerminalIndex(this);
+		}
+	}
+	else if (change == ItemSceneHasChanged ||
+			 change == ItemPositionHasChanged ||
+			 change == ItemRotationHasChanged ||
+			 change == ItemTransformHasChanged)
+	{
+		if (Diagram *diagram_ = diagram()) {
+			diagram_->updateTerminalIndex(this);
+		}
+		for (Terminal *t : m_terminals) {
+			t->scheduleHelpLineUpdate();
+		}
+	}
+
+	return QetGraphicsItem::itemChange(change, value);
+}
+
 /**
  * @brief Element::mouseMoveEvent
  * @param event
@@ -1502,7 +1539,7 @@ void Element::setUpFormula(bool code_letter)
 	{
 		QString formula = diagram()->project()->elementAutoNumCurrentFormula();
 
-		m_element_informations.addValue("formula", formula);
+		m_element_informations.addValue(DiagramContext::Formula, formula);
 		
 		QString element_currentAutoNum = diagram()->project()->elementCurrentAutoNum();
 		NumerotationContext nc = diagram()->project()->elementAutoNum(element_currentAutoNum);
@@ -1516,7 +1553,7 @@ void Element::setUpFormula(bool code_letter)
 		{
 			DiagramContext dc = m_element_informations;
 			QString label = autonum::AssignVariables::formulaToLabel(formula, m_autoNum_seq, diagram(), this);
-			m_element_informations.addValue("label", label);
+			m_element_informations.addValue(DiagramContext::Label, label);
 			emit elementInfoChange(dc, m_element_informations);
 		}
 	}
@@ -1563,7 +1600,7 @@ void Element::freezeNewAddedElement() {
  * @return the human name of this element
  */
 QString Element::name() const {
-	return m_names.name(m_location.baseName());
+	return m_definition->names.name(m_location.baseName());
 }
 
 ElementsLocation Element::location() const {
@@ -23,7 +23,7 @@
 #include "diagramcontext.h"
 #include "assignvariables.h"
 #include "elementslocation.h"
-#include "nameslist.h"
+#include "elementdefinitiondata.h"
 
 #include <algorithm>
 #include <QPicture>
@@ -88,7 +88,7 @@ class Element : public QetGraphicsItem
 			//METHODS related to information
 		DiagramContext  elementInformations    ()const              {return m_element_informations;}
 		virtual void    setElementInformations (DiagramContext dc);
-		DiagramContext  kindInformations       () const             {return m_kind_informations;}	//@kind_information_ is used to store more information
+		DiagramContext  kindInformations       () const             {return m_definition->kind_informations;}	//@kind_information_ is used to store more information
 																									//about the herited class like contactelement for know
 																									// kind of contact (simple tempo) or number of contact show by the element.
 
@@ -156,6 +156,7 @@ class Element : public QetGraphicsItem
 		void paint(QPainter *, const QStyleOptionGraphicsItem *, QWidget *) override;
 		QRectF boundingRect() const override;
 	protected:
+		QVariant itemChange(GraphicsItemChange change, const QVariant &value) override;
 		void mouseMoveEvent    ( QGraphicsSceneMouseEvent *event ) override;
 		void mouseReleaseEvent ( QGraphicsSceneMouseEvent *event ) override;
 		void hoverEnterEvent   ( QGraphicsSceneHoverEvent * ) override;
@@ -174,16 +175,15 @@ class Element : public QetGraphicsItem
 		kind              m_link_type = Element::Simple;
 		
 			//ATTRIBUTES related to informations
-		DiagramContext m_element_informations, m_kind_informations;
+		DiagramContext m_element_informations;
 		autonum::sequentialNumbers m_autoNum_seq;
 		bool m_freeze_label = false;
 		QString m_F_str;
 		
 		ElementsLocation m_location;
-		NamesList m_names;
+			///Data of the definition, shared by every elements of the same definition
+		QSharedPointer<const ElementDefinitionData> m_definition;
 		QList <Terminal *> m_terminals;
-		const QPicture m_picture;
-		const QPicture m_low_zoom_picture;
 		
 	private:
 		bool m_must_highlight = false;
@@ -0,0 +1,232 @@
+/*
+	Copyright 2006-2019 The QElectroTech Team
+	This file is part of QElectroTech.
+	
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+	
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "elementdefinitiondata.h"
+#include "elementpicturefactory.h"
+
+#include <QPainter>
+#include <QSettings>
+#include <cmath>
+
+namespace {
+		///Value of the setting "diagrameditor/far_zoom_level", -1 when it must be read again
+	qreal far_zoom_level = -1;
+}
+
+/**
+ * @brief ElementDefinitionData::definition
+ * @param location : location of the element definition
+ * @param xml_definition : xml of the element definition
+ * @return the shared data of the definition at @location.
+ * If an element of this definition already exist, his data is returned,
+ * else a new data is created from @xml_definition.
+ */
+QSharedPointer<const ElementDefinitionData> ElementDefinitionData::definition(const ElementsLocation &location, const QDomElement &xml_definition)
+{
+	const Key key = ElementDefinitionData::key(location);
+	const QUuid uuid(xml_definition.firstChildElement("uuid").attribute("uuid"));
+
+		//A definition without uuid can't be identified, so it is never shared
+	if (!uuid.isNull())
+	{
+		QSharedPointer<const ElementDefinitionData> data = cache().value(key).toStrongRef();
+		if (data && data->uuid == uuid) {
+			return data;
+		}
+	}
+
+	ElementDefinitionData *data = new ElementDefinitionData();
+	data->uuid = uuid;
+	if (!xml_definition.isNull())
+	{
+		data->names.fromXml(xml_definition);
+		data->kind_informations.fromXml(xml_definition.firstChildElement("kindInformations"), "kindInformation");
+		ElementPictureFactory::instance()->getPictures(location, data->picture, data->low_zoom_picture);
+	}
+
+	QSharedPointer<const ElementDefinitionData> shared_data(data, &ElementDefinitionData::release);
+	if (!uuid.isNull())
+	{
+		data->m_key = key;
+		data->m_cached = true;
+		cache().insert(key, shared_data.toWeakRef());
+	}
+	return shared_data;
+}
+
+/**
+ * @brief ElementDefinitionData::invalidate
+ * The definition at @location was modified : the next elements created from
+ * this location get a new shared data, built from the new definition,
+ * even if the uuid didn't change. The elements which already use the old
+ * shared data keep it.
+ * @param location
+ */
+void ElementDefinitionData::invalidate(const ElementsLocation &location) {
+	cache().remove(key(location));
+}
+
+/**
+ * @brief ElementDefinitionData::definitions
+ * @return every shared data currently used by at least one element
+ */
+QList<QSharedPointer<const ElementDefinitionData>> ElementDefinitionData::definitions()
+{
+	QList<QSharedPointer<const ElementDefinitionData>> list;
+	for (const QWeakPointer<const ElementDefinitionData> &weak : cache())
+	{
+		QSharedPointer<const ElementDefinitionData> data = weak.toStrongRef();
+		if (data) {
+			list << data;
+		}
+	}
+	return list;
+}
+
+/**
+ * @brief ElementDefinitionData::memorySize
+ * @return an estimation of the memory used by this data, in bytes
+ */
+qint64 ElementDefinitionData::memorySize() const
+{
+	qint64 size = sizeof(ElementDefinitionData);
+	size += m_key.second.size() * qint64(sizeof(QChar));
+	for (const QString &lang : names.langs()) {
+		size += (lang.size() + names[lang].size()) * qint64(sizeof(QChar));
+	}
+	for (const QString &key : kind_informations.keys()) {
+		size += sizeof(QVariant) + kind_informations.value(key).toString().size() * qint64(sizeof(QChar));
+	}
+	size += picture.size() + low_zoom_picture.size();
+	for (const QPixmap &pixmap : m_far_zoom_pixmaps) {
+		size += qint64(pixmap.width()) * pixmap.height() * (pixmap.depth() / 8);
+	}
+	return size;
+}
+
+/**
+ * @brief ElementDefinitionData::farZoomRect
+ * @return the rectangle, in the coordinates of the element, covered by the pixmaps
+ * returned by farZoomPixmap()
+ */
+QRectF ElementDefinitionData::farZoomRect() const {
+	return QRectF(low_zoom_picture.boundingRect()).adjusted(-1, -1, 1, 1);
+}
+
+/**
+ * @brief ElementDefinitionData::farZoomPixmap
+ * Below farZoomLevel(), replaying the vector picture of each element cost more
+ * than drawing a pixmap : the low zoom picture is rasterized once for every
+ * elements of this definition (the rotation of an element is applied by the painter).
+ * The zoom is rounded up to a power of two, so a pixmap is used
+ * for a range of zoom and is never enlarged.
+ * @param level_of_detail : level of detail of the painter
+ * @param device_pixel_ratio : device pixel ratio of the widget where the pixmap is drawn,
+ * the pixmap is rasterized with as many pixels as the screen, so it isn't blurry on high dpi screens.
+ * @return the pixmap to draw in farZoomRect()
+ */
+QPixmap ElementDefinitionData::farZoomPixmap(qreal level_of_detail, qreal device_pixel_ratio) const
+{
+	int bucket = qBound(-6, int(std::ceil(std::log2(qMax(level_of_detail, 0.001)))), 0);
+	const QPair<int, int> key(bucket, qRound(device_pixel_ratio * 100));
+	auto it = m_far_zoom_pixmaps.constFind(key);
+	if (it != m_far_zoom_pixmaps.constEnd()) {
+		return it.value();
+	}
+
+	qreal scale = std::ldexp(1.0, bucket) * device_pixel_ratio;
+	QRectF rect = farZoomRect();
+	QPixmap pixmap(qMax(1, int(std::ceil(rect.width() * scale))),
+				   qMax(1, int(std::ceil(rect.height() * scale))));
+	pixmap.setDevicePixelRatio(device_pixel_ratio);
+	pixmap.fill(Qt::transparent);
+
+	QPainter painter(&pixmap);
+	painter.setRenderHint(QPainter::Antialiasing, true);
+	painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+	painter.scale(scale, scale);
+	painter.translate(-rect.topLeft());
+	painter.drawPicture(0, 0, low_zoom_picture);
+	painter.end();
+
+	m_far_zoom_pixmaps.insert(key, pixmap);
+	return pixmap;
+}
+
+/**
+ * @brief ElementDefinitionData::farZoomLevel
+ * @return the level of detail below which the elements are drawn with a pixmap.
+ * Read from the setting "diagrameditor/far_zoom_level" (0.5 by default, 0 to always
+ * draw the vector pictures) at the first call and after reloadSettings().
+ */
+qreal ElementDefinitionData::farZoomLevel()
+{
+	if (far_zoom_level < 0) {
+		far_zoom_level = qMax(0.0, QSettings().value("diagrameditor/far_zoom_level", 0.5).toReal());
+	}
+	return far_zoom_level;
+}
+
+/**
+ * @brief ElementDefinitionData::reloadSettings
+ * Must be called when the settings used by the element definitions are changed
+ */
+void ElementDefinitionData::reloadSettings() {
+	far_zoom_level = -1;
+}
+
+/**
+ * @brief ElementDefinitionData::release
+ * Deleter of the shared data, remove the data from the cache
+ * if it was not replaced by a newer definition
+ * @param data
+ */
+void ElementDefinitionData::release(ElementDefinitionData *data)
+{
+	if (data->m_cached)
+	{
+			//The entry can be the one of a newer data, if this data was invalidated
+		auto it = cache().find(data->m_key);
+		if (it != cache().end() && it.value().isNull()) {
+			cache().erase(it);
+		}
+	}
+	delete data;
+}
+
+/**
+ * @brief ElementDefinitionData::key
+ * The key isn't ElementsLocation::toString() : the project id used by toString()
+ * is only known once the project is registered, after the loading of its folios,
+ * so the embedded definitions of two projects would get the same key.
+ * @param location
+ * @return the key of the definition at @location in the cache : its project
+ * (nullptr for the definitions of the file system collections) and its collection path.
+ */
+ElementDefinitionData::Key ElementDefinitionData::key(const ElementsLocation &location) {
+	return Key(location.project(), location.collectionPath());
+}
+
+/**
+ * @brief ElementDefinitionData::cache
+ * @return the shared data of the definitions currently used, by project and collection path
+ */
+QHash<ElementDefinitionData::Key, QWeakPointer<const ElementDefinitionData>> &ElementDefinitionData::cache()
+{
+	static QHash<Key, QWeakPointer<const ElementDefinitionData>> cache;
+	return cache;
+}
@@ -0,0 +1,75 @@
+/*
+	Copyright 2006-2019 The QElectroTech Team
+	This file is part of QElectroTech.
+	
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+	
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef ELEMENTDEFINITIONDATA_H
+#define ELEMENTDEFINITIONDATA_H
+
+#include "diagramcontext.h"
+#include "elementslocation.h"
+#include "nameslist.h"
+
+#include <QHash>
+#include <QPair>
+#include <QPicture>
+#include <QPixmap>
+#include <QSharedPointer>
+#include <QUuid>
+
+/**
+ * @brief The ElementDefinitionData class
+ * Data of an element which only depend on its definition (names, kind informations, pictures...).
+ * This data is shared by every instances of the same definition : an element only keep a
+ * shared pointer to it, instead of a copy for each instance.
+ * The location isn't shared, each element keep its own location. The definitions are identified
+ * by their project and their collection path, so two projects which embed the same
+ * definition never share its data.
+ * The shared data is kept as long as an element use it, a definition modified (new uuid,
+ * or file modified on disk, see invalidate()) get a new shared data.
+ */
+class ElementDefinitionData
+{
+	public:
+		static QSharedPointer<const ElementDefinitionData> definition(const ElementsLocation &location, const QDomElement &xml_definition);
+		static QList<QSharedPointer<const ElementDefinitionData>> definitions();
+		static void invalidate(const ElementsLocation &location);
+
+		qint64 memorySize() const;
+		QRectF farZoomRect() const;
+		QPixmap farZoomPixmap(qreal level_of_detail, qreal device_pixel_ratio) const;
+		static qreal farZoomLevel();
+		static void reloadSettings();
+
+		QUuid uuid;
+		NamesList names;
+		DiagramContext kind_informations;
+		QPicture picture;
+		QPicture low_zoom_picture;
+
+	private:
+		ElementDefinitionData() {}
+		static void release(ElementDefinitionData *data);
+		typedef QPair<const QETProject *, QString> Key;
+		static Key key(const ElementsLocation &location);
+		static QHash<Key, QWeakPointer<const ElementDefinitionData>> &cache();
+
+		Key m_key;
+		bool m_cached = false;
+			///Rasterized low zoom picture, by zoom bucket and device pixel ratio (in percent), see farZoomPixmap()
+		mutable QHash<QPair<int, int>, QPixmap> m_far_zoom_pixmaps;
+};
+
+#endif // ELEMENTDEFINITIONDATA_H
@@ -72,6 +72,61 @@ QET::GraphicsItemState QetGraphicsItem::state() const {
 	return m_state;
 }
 
+/**
+ * @brief QetGraphicsItem::itemChange
+ * Notify the diagram of the moves and the scale changes of this item, to keep up to date
+ * the bounding rect of the items of the diagram
+ * @param change
+ * @param value
+ * @return
+ */
+QVariant QetGraphicsItem::itemChange(QGraphicsItem::GraphicsItemChange change, const QVariant &value)
+{
+	if (Diagram *diagram_ = diagram())
+	{
+		if (change == ItemPositionChange ||
+			change == ItemRotationChange ||
+			change == ItemScaleChange ||
+			change == ItemTransformChange) {
+			diagram_->itemGeometryAboutToChange(this);
+		}
+		else if (change == ItemPositionHasChanged ||
+				 change == ItemRotationHasChanged ||
+				 change == ItemScaleHasChanged ||
+				 change == ItemTransformHasChanged) {
+			diagram_->itemGeometryChanged(this);
+		}
+	}
+
+	return QGraphicsObject::itemChange(change, value);
+}
+
+/**
+ * @brief QetGraphicsItem::prepareItemGeometryChange
+ * Same as prepareGeometryChange, and notify the diagram that the
+ * bounding rect of this item is about to change.
+ * Must be followed by a call of itemGeometryChanged once the geometry is changed.
+ */
+void QetGraphicsItem::prepareItemGeometryChange()
+{
+	prepareGeometryChange();
+	if (Diagram *diagram_ = diagram()) {
+		diagram_->itemGeometryAboutToChange(this);
+	}
+}
+
+/**
+ * @brief QetGraphicsItem::itemGeometryChanged
+ * Notify the diagram that the bounding rect of this item has changed
+ * (see prepareItemGeometryChange).
+ */
+void QetGraphicsItem::itemGeometryChanged()
+{
+	if (Diagram *diagram_ = diagram()) {
+		diagram_->itemGeometryChanged(this);
+	}
+}
+
 /**
  * @brief QetGraphicsItem::mousePressEvent
  *handle the mouse click
@@ -47,6 +47,9 @@ class QetGraphicsItem : public QGraphicsObject
 
 		//protected method
 	protected:
+		QVariant itemChange(GraphicsItemChange change, const QVariant &value) override;
+		void prepareItemGeometryChange();
+		void itemGeometryChanged();
 		void mousePressEvent(QGraphicsSceneMouseEvent *event) override;
 		void mouseDoubleClickEvent(QGraphicsSceneMouseEvent *event) override;
 		void mouseMoveEvent(QGraphicsSceneMouseEvent *event) override;
@@ -105,13 +105,15 @@ void QetShapeItem::setP2(const QPointF &P2)
 {
 	if (m_shapeType == Polygon && m_polygon.last() != P2)
 	{
-		prepareGeometryChange();
+		prepareItemGeometryChange();
 		m_polygon.replace(m_polygon.size()-1, P2);
+		itemGeometryChanged();
 	}
 	else if (P2 != m_P2)
 	{
-		prepareGeometryChange();
+		prepareItemGeometryChange();
 		m_P2 = P2;
+		itemGeometryChanged();
 	}
 }
 
@@ -124,9 +126,10 @@ void QetShapeItem::setP2(const QPointF &P2)
 bool QetShapeItem::setLine(const QLineF &line)
 {
 	if (Q_UNLIKELY(m_shapeType != Line)) return false;
-	prepareGeometryChange();
+	prepareItemGeometryChange();
 	m_P1 = line.p1();
 	m_P2 = line.p2();
+	itemGeometryChanged();
 	adjusteHandlerPos();
 	return true;
 }
@@ -141,9 +144,10 @@ bool QetShapeItem::setRect(const QRectF &rect)
 {
 	if (Q_LIKELY(m_shapeType == Rectangle || m_shapeType == Ellipse))
 	{
-		prepareGeometryChange();
+		prepareItemGeometryChange();
 		m_P1 = rect.topLeft();
 		m_P2 = rect.bottomRight();
+		itemGeometryChanged();
 		adjusteHandlerPos();
 		return true;
 	}
@@ -162,8 +166,9 @@ bool QetShapeItem::setPolygon(const QPolygonF &polygon)
 	if (Q_UNLIKELY(m_shapeType != Polygon)) {
 		return false;
 	}
-	prepareGeometryChange();
+	prepareItemGeometryChange();
 	m_polygon = polygon;
+	itemGeometryChanged();
 	adjusteHandlerPos();
 	return true;
 }
@@ -214,8 +219,9 @@ int QetShapeItem::pointsCount() const {
  */
 void QetShapeItem::setNextPoint(QPointF P)
 {
-	prepareGeometryChange();
+	prepareItemGeometryChange();
 	m_polygon.append(Diagram::snapToGrid(P));
+	itemGeometryChanged();
 }
 
 /**
@@ -230,6 +236,7 @@ void QetShapeItem::removePoints(int number)
 	if ((pointsCount()-2) < number)
 		number = pointsCount() - 2;
 
+	prepareItemGeometryChange();
 	int i = 0;
 	do
 	{
@@ -239,6 +246,7 @@ void QetShapeItem::removePoints(int number)
 		setTransformOriginPoint(boundingRect().center());
 
 	} while (i < number);
+	itemGeometryChanged();
 }
 
 /**
@@ -394,7 +402,7 @@ QVariant QetShapeItem::itemChange(QGraphicsItem::GraphicsItemChange change, cons
 		}
 	}
 
-    return QGraphicsItem::itemChange(change, value);
+    return QetGraphicsItem::itemChange(change, value);
 }
 
 /**
@@ -727,8 +735,9 @@ void QetShapeItem::handlerMouseMoveEvent(QetGraphicsHandlerItem *qghi, QGraphics
 	switch (m_shapeType)
 	{
 		case Line:
-			prepareGeometryChange();
+			prepareItemGeometryChange();
 			m_vector_index == 0 ? m_P1 = new_pos : m_P2 = new_pos;
+			itemGeometryChanged();
 			adjusteHandlerPos();
 			break;
 
@@ -767,8 +776,9 @@ void QetShapeItem::handlerMouseMoveEvent(QetGraphicsHandlerItem *qghi, QGraphics
 			}
 
 		case Polygon:
-			prepareGeometryChange();
+			prepareItemGeometryChange();
 			m_polygon.replace(m_vector_index, new_pos);
+			itemGeometryChanged();
 			adjusteHandlerPos();
 			break;
 	}	//End switch
@@ -952,17 +962,17 @@ QDomElement QetShapeItem::toXml(QDomDocument &document) const
 /**
  * @brief QetShapeItem::toDXF
  * Draw this element to the dxf document
- * @param filepath file path of the the dxf document
+ * @param dxf the dxf document
  * @return true if draw success
  */
-bool QetShapeItem::toDXF(const QString &filepath,const QPen &pen)
+bool QetShapeItem::toDXF(Createdxf &dxf,const QPen &pen)
 {
 
     switch (m_shapeType)
 	{
-        case Line:      Createdxf::drawLine     (filepath, QLineF(mapToScene(m_P1), mapToScene(m_P2)), Createdxf::getcolorCode(pen.color().red(),pen.color().green(),pen.color().blue()));              return true;
-        case Rectangle: Createdxf::drawRectangle(filepath, QRectF(mapToScene(m_P1), mapToScene(m_P2)).normalized(), Createdxf::getcolorCode(pen.color().red(),pen.color().green(),pen.color().blue())); return true;
-        case Ellipse:   Createdxf::drawEllipse  (filepath, QRectF(mapToScene(m_P1), mapToScene(m_P2)).normalized(), Createdxf::getcolorCode(pen.color().red(),pen.color().green(),pen.color().blue())); return true;
+        case Line:      dxf.drawLine     (QLineF(mapToScene(m_P1), mapToScene(m_P2)), Createdxf::getcolorCode(pen.color().red(),pen.color().green(),pen.color().blue()));              return true;
+        case Rectangle: dxf.drawRectangle(QRectF(mapToScene(m_P1), mapToScene(m_P2)).normalized(), Createdxf::getcolorCode(pen.color().red(),pen.color().green(),pen.color().blue())); return true;
+        case Ellipse:   dxf.drawEllipse  (QRectF(mapToScene(m_P1), mapToScene(m_P2)).normalized(), Createdxf::getcolorCode(pen.color().red(),pen.color().green(),pen.color().blue())); return true;
 		default: return false;
 	}
 }
@@ -262,66 +262,6 @@ void Terminal::paint(QPainter *p, const QStyleOptionGraphicsItem *options, QWidg
 		p -> drawEllipse(QRectF(c.x() - 2.5, c.y() - 2.5, 5.0, 5.0));
 	} else p -> drawPoint(c);
 
-		//Draw help line if needed,
-	if (diagram() && m_draw_help_line)
-	{
-			//Draw the help line with same orientation of terminal
-			//Only if there isn't docked conductor
-		if (conductors().isEmpty())
-		{
-			if (!m_help_line)
-				m_help_line = new QGraphicsLineItem(this);
-			QPen pen;
-			pen.setColor(Qt::darkBlue);
-
-			QLineF line(HelpLine());
-
-			if (diagram() -> project() -> autoConductor())
-			{
-				Terminal *t = alignedWithTerminal();
-				if (t)
-				{
-					line.setP2(t -> dockConductor());
-					pen.setColor(Qt::darkGreen);
-				}
-			}
-
-				//Map the line (in scene coordinate) to m_help_line coordinate
-			line.setP1(m_help_line -> mapFromScene(line.p1()));
-			line.setP2(m_help_line -> mapFromScene(line.p2()));
-			m_help_line -> setPen(pen);
-			m_help_line -> setLine(line);
-		}
-
-			//Draw the help line perpendicular to the terminal
-		if (!m_help_line_a)
-		{
-			m_help_line_a = new QGraphicsLineItem(this);
-			QPen pen;
-			pen.setColor(Diagram::background_color == Qt::darkGray ? Qt::lightGray : Qt::darkGray);
-			m_help_line_a -> setPen(pen);
-		}
-
-		QRectF rect = diagram() -> border_and_titleblock.insideBorderRect();
-		QLineF line;
-
-		if (Qet::isHorizontal(orientation()))
-		{
-			line.setP1(QPointF(dockConductor().x(), rect.topLeft().y()));
-			line.setP2(QPointF(dockConductor().x(), rect.bottomLeft().y()));
-		}
-		else
-		{
-			line.setP1(QPointF(rect.topLeft().x(), dockConductor().y()));
-			line.setP2(QPointF(rect.topRight().x(), dockConductor().y()));
-		}
-
-			//Map the line (in scene coordinate) to m_help_line_a coordinate
-		line.setP1(m_help_line_a -> mapFromScene(line.p1()));
-		line.setP2(m_help_line_a -> mapFromScene(line.p2()));
-		m_help_line_a -> setLine(line);
-	}
-
 	p -> restore();
 }
 
@@ -329,26 +269,116 @@ void Terminal::paint(QPainter *p, const QStyleOptionGraphicsItem *options, QWidg
  * @brief Terminal::drawHelpLine
  * @param draw : true, display the help line
  * false, hide it.
+ * The help line is updated at the next turn of the event loop, see updateHelpLine()
  */
 void Terminal::drawHelpLine(bool draw)
 {
-	if (m_draw_help_line == draw) return;
+	if (draw)
+	{
+		m_draw_help_line = true;
+		scheduleHelpLineUpdate();
+		return;
+	}
 
-	m_draw_help_line = draw;
+	if (!m_draw_help_line) return;
 
-	if (!draw)
+	m_draw_help_line = false;
+
+	if (m_help_line)
 	{
-		if (m_help_line)
-		{
-			delete m_help_line;
-			m_help_line = nullptr;
-		}
-		if (m_help_line_a)
+		delete m_help_line;
+		m_help_line = nullptr;
+	}
+	if (m_help_line_a)
+	{
+		delete m_help_line_a;
+		m_help_line_a = nullptr;
+	}
+}
+
+/**
+ * @brief Terminal::scheduleHelpLineUpdate
+ * If the help line is displayed, update it at the next turn of the event loop.
+ * Called each time the parent element move, the help line is
+ * computed once for all the moves done during this turn.
+ */
+void Terminal::scheduleHelpLineUpdate()
+{
+	if (!m_draw_help_line || m_help_line_update_scheduled) {
+		return;
+	}
+	m_help_line_update_scheduled = true;
+	QMetaObject::invokeMethod(this, "updateHelpLine", Qt::QueuedConnection);
+}
+
+/**
+ * @brief Terminal::updateHelpLine
+ * Create or update the help lines items according to the current position of the terminal.
+ * The help lines are not computed in paint(), because moving the help line items
+ * while the scene is painted, cause a new paint of the scene.
+ */
+void Terminal::updateHelpLine()
+{
+	m_help_line_update_scheduled = false;
+	if (!m_draw_help_line || !diagram()) {
+		return;
+	}
+
+		//Draw the help line with same orientation of terminal
+		//Only if there isn't docked conductor
+	if (conductors().isEmpty())
+	{
+		if (!m_help_line)
+			m_help_line = new QGraphicsLineItem(this);
+		QPen pen;
+		pen.setColor(Qt::darkBlue);
+
+		QLineF line(HelpLine());
+
+		if (diagram() -> project() -> autoConductor())
 		{
-			delete m_help_line_a;
-			m_help_line_a = nullptr;
+			Terminal *t = alignedWithTerminal();
+			if (t)
+			{
+				line.setP2(t -> dockConductor());
+				pen.setColor(Qt::darkGreen);
+			}
 		}
+
+			//Map the line (in scene coordinate) to m_help_line coordinate
+		line.setP1(m_help_line -> mapFromScene(line.p1()));
+		line.setP2(m_help_line -> mapFromScene(line.p2()));
+		m_help_line -> setPen(pen);
+		m_help_line -> setLine(line);
 	}
+
+		//Draw the help line perpendicular to the terminal
+	if (!m_help_line_a)
+	{
+		m_help_line_a = new QGraphicsLineItem(this);
+		QPen pen;
+		pen.setColor(Diagram::background_color == Qt::darkGray ? Qt::lightGray : Qt::darkGray);
+		m_help_line_a -> setPen(pen);
+	}
+
+	QRectF rect = diagram() -> border_and_titleblock.insideBorderRect();
+	QLineF line;
+
+	if (Qet::isHorizontal(orientation()))
+	{
+		line.setP1(QPointF(dockConductor().x(), rect.topLeft().y()));
+		line.setP2(QPointF(dockConductor().x(), rect.bottomLeft().y()));
+	}
+	else
+	{
+		line.setP1(QPointF(rect.topLeft().x(), dockConductor().y()));
+		line.setP2(QPointF(rect.topRight().x(), dockConductor().y()));
+	}
+
+		//Map the line (in scene coordinate) to m_help_line_a coordinate
+	line.setP1(m_help_line_a -> mapFromScene(line.p1()));
+	line.setP2(m_help_line_a -> mapFromScene(line.p2()));
+	m_help_line_a -> setLine(line);
 }
 
 /**
@@ -414,32 +444,29 @@ Terminal* Terminal::alignedWithTerminal() const
 {
 	QLineF line(HelpLine());
 
-	QPainterPath path;
-	path.moveTo(line.p1());
-	path.lineTo(line.p2());
-
-		//Get all QGraphicsItem in the alignement of this terminal
-	QList <QGraphicsItem *> qgi_list = diagram() -> items(path);
+		//Get the terminals on the axis of this terminal, from the index of the diagram
+	QList <Terminal *> axis_terminals;
+	if (Qet::isHorizontal(orientation()))
+		axis_terminals = diagram() -> terminalsOnAxis(Qt::Horizontal, line.p1().y());
+	else
+		axis_terminals = diagram() -> terminalsOnAxis(Qt::Vertical, line.p1().x());
 
 		//Remove all terminals of the parent element
 	foreach (Terminal *t, parent_element_ -> terminals())
-		qgi_list.removeAll(t);
+		axis_terminals.removeAll(t);
 
-	if (qgi_list.isEmpty()) return nullptr;
+	if (axis_terminals.isEmpty()) return nullptr;
 
 		//Get terminals only if orientation is opposed with this terminal
 	QList <Terminal *>  available_terminals;
-	foreach (QGraphicsItem *qgi, qgi_list)
+	foreach (Terminal *tt, axis_terminals)
 	{
-		if (Terminal *tt = qgraphicsitem_cast <Terminal *> (qgi))
+			//Call QET::lineContainsPoint to be sure the line intersect
+			//the dock point and not an other part of terminal
+		if (Qet::isOpposed(orientation(), tt -> orientation()) &&
+			QET::lineContainsPoint(line, tt -> dockConductor()))
 		{
-				//Call QET::lineContainsPoint to be sure the line intersect
-				//the dock point and not an other part of terminal
-			if (Qet::isOpposed(orientation(), tt -> orientation()) &&
-				QET::lineContainsPoint(line, tt -> dockConductor()))
-			{
-				available_terminals << tt;
-			}
+			available_terminals << tt;
 		}
 	}
 
@@ -53,6 +53,7 @@ class Terminal : public QGraphicsObject
 	
 		void   paint        (QPainter *, const QStyleOptionGraphicsItem *, QWidget *) override;
 		void   drawHelpLine (bool draw = true);
+		void   scheduleHelpLineUpdate();
 		QLineF HelpLine     () const;
 		QRectF boundingRect () const override;
 	
@@ -88,6 +89,9 @@ class Terminal : public QGraphicsObject
 	void mousePressEvent  (QGraphicsSceneMouseEvent *) override;
 	void mouseMoveEvent   (QGraphicsSceneMouseEvent *) override;
 	void mouseReleaseEvent(QGraphicsSceneMouseEvent *) override;
+
+	private slots:
+		void updateHelpLine();
 	
 		// attributes
 	public:
@@ -107,6 +111,7 @@ class Terminal : public QGraphicsObject
 	
 	private:
 		bool               m_draw_help_line;
+		bool               m_help_line_update_scheduled = false;
 		QGraphicsLineItem *m_help_line;
 		QGraphicsLineItem *m_help_line_a;
 
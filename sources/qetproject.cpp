@@ -31,11 +31,13 @@
 #include "importelementdialog.h"
 #include "numerotationcontextcommands.h"
 #include "assignvariables.h"
+#include "undohistory.h"
 
 #include <QTimer>
 #include <QStandardPaths>
 #include <utility>
 #include <KAutoSaveFile>
+#include "qettrace.h"
 
 static int BACKUP_INTERVAL = 120000; //interval in ms of backup = 2min
 
@@ -122,6 +124,7 @@ void QETProject::init()
 
 	m_undo_stack = new QUndoStack(this);
 	connect(m_undo_stack, SIGNAL(cleanChanged(bool)), this, SLOT(undoStackChanged(bool)));
+	m_undo_history = new UndoHistory(m_undo_stack, this);
 
 	m_save_backup_timer.setInterval(BACKUP_INTERVAL);
 	connect(&m_save_backup_timer, &QTimer::timeout, this, &QETProject::writeBackup);
@@ -150,6 +153,7 @@ void QETProject::init()
  */
 QETProject::ProjectState QETProject::openFile(QFile *file)
 {
+	QET_TRACE("QETProject::openFile");
 	bool opened_here = file->isOpen() ? false : true;
 	if (!file->isOpen() && !file->open(QIODevice::ReadOnly | QIODevice::Text)) {
 		return FileOpenFailed;
@@ -809,6 +813,7 @@ void QETProject::autoFolioNumberingSelectedFolios(int from, int to, const QStrin
 	@return un document XML representant le projet 
 */
 QDomDocument QETProject::toXml() {
+	QET_TRACE("QETProject::toXml");
 	// racine du projet
 	QDomDocument xml_doc;
 	QDomElement project_root = xml_doc.createElement("project");
@@ -881,6 +886,7 @@ bool QETProject::close() {
  */
 QETResult QETProject::write()
 {
+	QET_TRACE("QETProject::write");
 		// this operation requires a filepath
 	if (m_file_path.isEmpty())
 		return(QString("unable to save project to file: no filepath was specified"));
@@ -1245,6 +1251,7 @@ void QETProject::setModified(bool modified) {
  */
 void QETProject::readProjectXml(QDomDocument &xml_project)
 {
+	QET_TRACE("QETProject::readProjectXml");
 	QDomElement root_elmt = xml_project.documentElement();
 	m_state = ProjectParsingRunning;
 	
@@ -1314,6 +1321,7 @@ void QETProject::readProjectXml(QDomDocument &xml_project)
  */
 void QETProject::readDiagramsXml(QDomDocument &xml_project)
 {
+	QET_TRACE("QETProject::readDiagramsXml");
 	QMultiMap<int, Diagram *> loaded_diagrams;
 	
 	//@TODO try to solve a weird bug (dialog is black) since port to Qt5 with the DialogWaiting
@@ -1333,6 +1341,10 @@ void QETProject::readDiagramsXml(QDomDocument &xml_project)
 		//Search the diagrams in the project
 	QDomNodeList diagram_nodes = xml_project.elementsByTagName("diagram");
 	
+		//The folios are kept dehydrated until they are needed
+	QSettings settings;
+	const bool dehydrate_folios = settings.value("diagrameditor/dehydrate-folios", true).toBool();
+	
 	if(dlgWaiting)
 		dlgWaiting->setProgressBarRange(0, diagram_nodes.length()*3);
 	
@@ -1345,7 +1357,8 @@ void QETProject::readDiagramsXml(QDomDocument &xml_project)
 		{
 			QDomElement diagram_xml_element = diagram_nodes.at(i).toElement();
 			Diagram *diagram = new Diagram(this);
-			bool diagram_loading = diagram -> initFromXml(diagram_xml_element);
+			bool diagram_loading = dehydrate_folios ? diagram -> initDehydratedFromXml(diagram_xml_element) :
+													  diagram -> initFromXml(diagram_xml_element);
 			if (diagram_loading)
 			{
 				if(dlgWaiting)
@@ -1394,6 +1407,7 @@ void QETProject::readDiagramsXml(QDomDocument &xml_project)
  */
 void QETProject::readElementsCollectionXml(QDomDocument &xml_project)
 {
+	QET_TRACE("QETProject::readElementsCollectionXml");
 		//Get the embedded elements collection of the project
 	QDomNodeList collection_roots = xml_project.elementsByTagName("collection");
 	QDomElement collection_root;
@@ -1420,6 +1434,7 @@ void QETProject::readElementsCollectionXml(QDomDocument &xml_project)
  */
 void QETProject::readProjectPropertiesXml(QDomDocument &xml_project)
 {
+	QET_TRACE("QETProject::readProjectPropertiesXml");
 	foreach (QDomElement e, QET::findInDomElement(xml_project.documentElement(), "properties"))
 		m_project_properties.fromXml(e);
 }
@@ -1432,6 +1447,7 @@ void QETProject::readProjectPropertiesXml(QDomDocument &xml_project)
  */
 void QETProject::readDefaultPropertiesXml(QDomDocument &xml_project)
 {
+	QET_TRACE("QETProject::readDefaultPropertiesXml");
 		// Find xml element where is stored properties for new diagram
 	QDomNodeList newdiagrams_nodes = xml_project.elementsByTagName("newdiagrams");
 	if (newdiagrams_nodes.isEmpty()) return;
@@ -1732,6 +1748,10 @@ bool QETProject::projectWasModified() {
 /**
 	Indique a chaque schema du projet quel est son numero de folio et combien de
 	folio le projet contient.
+	Only the folios whose titleblock informations really changed (index, total,
+	autonum, previous and next folio, project-wide properties...) get a new
+	context and are repainted, the others keep their rendered titleblock.
+	The folio lists are always repainted.
 */
 void QETProject::updateDiagramsFolioData()
 {
@@ -1742,38 +1762,53 @@ void QETProject::updateDiagramsFolioData()
 	project_wide_properties.addValue("projectpath", filePath());
 	project_wide_properties.addValue("projectfilename", QFileInfo(filePath()).baseName());
 	
+	QSet<Diagram *> changed_diagrams;
 	for (int i = 0 ; i < total_folio ; ++ i)
 	{
-		QString autopagenum = m_diagrams_list[i]->border_and_titleblock.autoPageNum();
-		NumerotationContext nC = folioAutoNum(autopagenum);
-		NumerotationContextCommands nCC = NumerotationContextCommands(nC);
+		Diagram *diagram = m_diagrams_list.at(i);
+		BorderTitleBlock &titleblock = diagram->border_and_titleblock;
+		QString autopagenum = titleblock.autoPageNum();
+		bool changed = false;
 		
-		if ((m_diagrams_list[i]->border_and_titleblock.folio().contains("%autonum")) && 
-			(!autopagenum.isNull()))
+		if (titleblock.folio().contains("%autonum") && !autopagenum.isNull())
 		{
-			m_diagrams_list[i] -> border_and_titleblock.setFolioData(i + 1, total_folio, nCC.toRepresentedString(), project_wide_properties);
-			m_diagrams_list[i]->project()->addFolioAutoNum(autopagenum,nCC.next());
+			NumerotationContextCommands nCC = NumerotationContextCommands(folioAutoNum(autopagenum));
+			changed = titleblock.setFolioData(i + 1, total_folio, nCC.toRepresentedString(), project_wide_properties);
+			addFolioAutoNum(autopagenum, nCC.next());
 		}
 		else {
-			m_diagrams_list[i] -> border_and_titleblock.setFolioData(i + 1, total_folio, nullptr, project_wide_properties);
+			changed = titleblock.setFolioData(i + 1, total_folio, nullptr, project_wide_properties);
 		}
 		
 		if (i > 0)
 		{
-			m_diagrams_list.at(i)->border_and_titleblock.setPreviousFolioNum(m_diagrams_list.at(i-1)->border_and_titleblock.finalfolio());
-			m_diagrams_list.at(i-1)->border_and_titleblock.setNextFolioNum(m_diagrams_list.at(i)->border_and_titleblock.finalfolio());
-			
-			if (i == total_folio-1) {
-				m_diagrams_list.at(i)->border_and_titleblock.setNextFolioNum(QString());
+			Diagram *previous_diagram = m_diagrams_list.at(i-1);
+			if (titleblock.setPreviousFolioNum(previous_diagram->border_and_titleblock.finalfolio())) {
+				changed = true;
+			}
+			if (previous_diagram->border_and_titleblock.setNextFolioNum(titleblock.finalfolio())) {
+				changed_diagrams.insert(previous_diagram);
 			}
 		}
-		else {
-			m_diagrams_list.at(i)->border_and_titleblock.setPreviousFolioNum(QString());
+		else if (titleblock.setPreviousFolioNum(QString())) {
+			changed = true;
+		}
+		
+		if (i == total_folio-1 && titleblock.setNextFolioNum(QString())) {
+			changed = true;
+		}
+		
+		if (changed) {
+			changed_diagrams.insert(diagram);
 		}
 	}
 	
+		//The folio lists paint the informations of the others folios,
+		//they are always repainted
 	for (Diagram *d : m_diagrams_list) {
-		d->update();
+		if (changed_diagrams.contains(d) || dynamic_cast<DiagramFolioList *>(d)) {
+			d->update();
+		}
 	}
 }
 
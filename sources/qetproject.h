@@ -33,6 +33,7 @@ class TitleBlockTemplate;
 class MoveTitleBlockTemplatesHandler;
 class NumerotationContext;
 class QUndoStack;
+class UndoHistory;
 class XmlElementCollection;
 class QTimer;
 class KAutoSaveFile;
@@ -162,6 +163,7 @@ class QETProject : public QObject
 		DiagramContext projectProperties();
 		void setProjectProperties(const DiagramContext &);
 		QUndoStack* undoStack() {return m_undo_stack;}
+		UndoHistory* undoHistory() {return m_undo_history;}
 	
 	public slots:
 		Diagram *addNewDiagram();
@@ -249,6 +251,8 @@ class QETProject : public QObject
 		DiagramContext m_project_properties;
 			/// undo stack for this project
 		QUndoStack *m_undo_stack;
+			/// memory budget of the undo stack
+		UndoHistory *m_undo_history;
 			/// Conductor auto numerotation
 		QHash <QString, NumerotationContext> m_conductor_autonum;//Title and NumContext hash
 		QString m_current_conductor_autonum;
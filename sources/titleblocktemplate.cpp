@@ -1252,15 +1252,15 @@ void TitleBlockTemplate::render(QPainter &painter, const DiagramContext &diagram
 	@param titleblock_width Width of the titleblock to render
 */
 void TitleBlockTemplate::renderDxf(QRectF &title_block_rect, const DiagramContext &diagram_context,
-								   int titleblock_width, QString &file_path, int color) const {
+								   int titleblock_width, Createdxf &dxf, int color) const {
 	QList<int> widths = columnsWidth(titleblock_width);
 
 	// draw the titleblock border
 	double xCoord    = title_block_rect.topLeft().x();
-	double yCoord    = Createdxf::sheetHeight - title_block_rect.bottomLeft().y()*Createdxf::yScale;
-	double recWidth  = title_block_rect.width()  * Createdxf::xScale;
-	double recHeight = title_block_rect.height() * Createdxf::yScale;
-	Createdxf::drawRectangle(file_path, xCoord, yCoord, recWidth, recHeight, color);
+	double yCoord    = Createdxf::sheetHeight - title_block_rect.bottomLeft().y()*dxf.yScale();
+	double recWidth  = title_block_rect.width()  * dxf.xScale();
+	double recHeight = title_block_rect.height() * dxf.yScale();
+	dxf.drawRectangle(xCoord, yCoord, recWidth, recHeight, color);
 
 	// run through each individual cell
 	for (int j = 0 ; j < rows_heights_.count() ; ++ j) {
@@ -1279,15 +1279,15 @@ void TitleBlockTemplate::renderDxf(QRectF &title_block_rect, const DiagramContex
 			double w = lengthRange(cells_[i][j] -> num_col, cells_[i][j] -> num_col + 1 + col_span, widths);
 			double h = lengthRange(cells_[i][j] -> num_row, cells_[i][j] -> num_row + 1 + row_span, rows_heights_);
 
-			x = xCoord + x*Createdxf::xScale;
-			h *= Createdxf::yScale;
-			y = yCoord + recHeight - h - y*Createdxf::yScale;
-			w *= Createdxf::xScale;
+			x = xCoord + x*dxf.xScale();
+			h *= dxf.yScale();
+			y = yCoord + recHeight - h - y*dxf.yScale();
+			w *= dxf.xScale();
 
-			Createdxf::drawRectangle(file_path, x, y, w, h, color);
+			dxf.drawRectangle(x, y, w, h, color);
 			if (cells_[i][j] -> type() == TitleBlockCell::TextCell) {
 				QString final_text = finalTextForCell(*cells_[i][j], diagram_context);
-				renderTextCellDxf(file_path, final_text, *cells_[i][j], x, y, w, h, color);
+				renderTextCellDxf(dxf, final_text, *cells_[i][j], x, y, w, h, color);
 			}
 		}
 	}
@@ -1430,7 +1430,7 @@ void TitleBlockTemplate::renderTextCell(QPainter &painter, const QString &text,
 }
 
 
-void TitleBlockTemplate::renderTextCellDxf(QString &file_path, const QString &text,
+void TitleBlockTemplate::renderTextCellDxf(Createdxf &dxf, const QString &text,
 										   const TitleBlockCell &cell,
 										   qreal x, qreal y, qreal w, qreal h, int color) const {
 	if (text.isEmpty()) return;
@@ -1459,7 +1459,7 @@ void TitleBlockTemplate::renderTextCellDxf(QString &file_path, const QString &te
 
 	if ( cell.alignment & Qt::AlignTop ) {
 		vAlign = 3;
-		y += h - textHeight*Createdxf::yScale;
+		y += h - textHeight*dxf.yScale();
 		if (!hALigned)
 			x2 = x;
 	} else if ( cell.alignment & Qt::AlignVCenter ) {
@@ -1476,14 +1476,14 @@ void TitleBlockTemplate::renderTextCellDxf(QString &file_path, const QString &te
 		QFontMetricsF font_metrics(text_font);
 		QRectF font_rect = font_metrics.boundingRect(QRect(-10000, -10000, 10000, 10000), cell.alignment, text);
 
-		if (font_rect.width()*Createdxf::xScale > w) {
-			qreal ratio = qreal(w) / qreal(font_rect.width()*Createdxf::xScale);
+		if (font_rect.width()*dxf.xScale() > w) {
+			qreal ratio = qreal(w) / qreal(font_rect.width()*dxf.xScale());
 			textHeight *= ratio;
 		}
 	}
 
-	Createdxf::drawTextAligned(file_path, text, x,
-							   y, textHeight*Createdxf::yScale, 0, 0, hAlign, vAlign, x2, color, 0);
+	dxf.drawTextAligned(text, x,
+						y, textHeight*dxf.yScale(), 0, 0, hAlign, vAlign, x2, color, 0);
 
 }
 
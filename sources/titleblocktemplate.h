@@ -23,6 +23,7 @@
 #include "titleblockcell.h"
 #include "dimension.h"
 #include "qet.h"
+class Createdxf;
 
 /**
 	This class represents an title block template for an electric diagram.
@@ -97,7 +98,7 @@ class TitleBlockTemplate : public QObject {
 	QPixmap bitmapLogo(const QString &) const;
 	
 	void render(QPainter &, const DiagramContext &, int) const;
-	void renderDxf(QRectF &, const DiagramContext &, int, QString &, int) const;
+	void renderDxf(QRectF &, const DiagramContext &, int, Createdxf &, int) const;
 	void renderCell(QPainter &, const TitleBlockCell &, const DiagramContext &, const QRect &) const;
 	void applyCellSpans();
 	void forgetSpanning();
@@ -133,7 +134,7 @@ class TitleBlockTemplate : public QObject {
 	QString finalTextForCell(const TitleBlockCell &, const DiagramContext &) const;
 	QString interpreteVariables(const QString &, const DiagramContext &) const;
 	void renderTextCell(QPainter &, const QString &, const TitleBlockCell &, const QRectF &) const;
-	void renderTextCellDxf(QString &, const QString &, const TitleBlockCell &, qreal, qreal, qreal, qreal, int) const;
+	void renderTextCellDxf(Createdxf &, const QString &, const TitleBlockCell &, qreal, qreal, qreal, qreal, int) const;
 	
 	// attributes
 	private:
@@ -86,9 +86,9 @@ void TitleBlockTemplateRenderer::render(QPainter *provided_painter, int titleblo
 }
 
 
-void TitleBlockTemplateRenderer::renderDxf(QRectF &title_block_rect, int titleblock_width, QString &file_path, int color) {
+void TitleBlockTemplateRenderer::renderDxf(QRectF &title_block_rect, int titleblock_width, Createdxf &dxf, int color) {
 	if (!m_titleblock_template) return;
-	m_titleblock_template -> renderDxf(title_block_rect, m_context, titleblock_width, file_path, color);
+	m_titleblock_template -> renderDxf(title_block_rect, m_context, titleblock_width, dxf, color);
 }
 
 /**
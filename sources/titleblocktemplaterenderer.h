@@ -21,6 +21,7 @@
 #include "diagramcontext.h"
 
 class TitleBlockTemplate;
+class Createdxf;
 
 class TitleBlockTemplateRenderer : public QObject
 {
@@ -38,7 +39,7 @@ class TitleBlockTemplateRenderer : public QObject
 		
 		int height() const;
 		void render(QPainter *, int);
-		void renderDxf(QRectF &, int, QString &, int);
+		void renderDxf(QRectF &, int, Createdxf &, int);
 		void invalidateRenderedTemplate();
 		void setUseCache(bool);
 		bool useCache() const;
@@ -19,6 +19,8 @@
 #include "ui_generalconfigurationpage.h"
 #include "qeticons.h"
 #include "qetapp.h"
+#include "diagramview.h"
+#include "elementdefinitiondata.h"
 
 #include <QSettings>
 #include <QFontDialog>
@@ -173,6 +175,8 @@ void GeneralConfigurationPage::applyConf()
 	settings.setValue("diagrameditor/viewmode", view_mode) ;
 	settings.setValue("diagrameditor/highlight-integrated-elements", ui->m_highlight_integrated_elements->isChecked());
 	settings.setValue("diagrameditor/zoom-out-beyond-of-folio", ui->m_zoom_out_beyond_folio->isChecked());
+	DiagramView::reloadSettings();
+	ElementDefinitionData::reloadSettings();
 	settings.setValue("diagrameditor/autosave-interval", ui->m_autosave_sb->value());
 		//Grid step and key navigation
 	settings.setValue("diagrameditor/Xgrid", ui->DiagramEditor_xGrid_sb->value());
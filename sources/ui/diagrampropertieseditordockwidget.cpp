@@ -42,7 +42,7 @@ DiagramPropertiesEditorDockWidget::DiagramPropertiesEditorDockWidget(QWidget *pa
 /**
  * @brief DiagramPropertiesEditorDockWidget::setDiagram
  * Set the diagram to edit the selection.
- * Connect the diagram signal selectionChanged() to this slot selectionChanged();
+ * Connect the diagram signal compressedSelectionChanged() to this slot selectionChanged();
  * If diagram = nullptr, we just disconnect all signal and remove editor.
  * @param diagram
  * @param diagram
@@ -53,14 +53,14 @@ void DiagramPropertiesEditorDockWidget::setDiagram(Diagram *diagram)
 
 	if (m_diagram)
 	{
-		disconnect(m_diagram, SIGNAL(selectionChanged()), this, SLOT(selectionChanged()));
+		disconnect(m_diagram, SIGNAL(compressedSelectionChanged()), this, SLOT(selectionChanged()));
 		disconnect(m_diagram, SIGNAL(destroyed()),        this, SLOT(diagramWasDeleted()));
 	}
 
 	if (diagram)
 	{
 		m_diagram = diagram;
-		connect(m_diagram, SIGNAL(selectionChanged()), this, SLOT(selectionChanged()), Qt::QueuedConnection);
+		connect(m_diagram, SIGNAL(compressedSelectionChanged()), this, SLOT(selectionChanged()));
 		connect(m_diagram, SIGNAL(destroyed()),        this, SLOT(diagramWasDeleted()));
 		selectionChanged();
 	}
@@ -81,7 +81,10 @@ void DiagramPropertiesEditorDockWidget::selectionChanged()
 {
 	if (!m_diagram) return;
 	
-	int count_ = m_diagram->selectedItems().size();
+		//Called once per turn of the event loop with the final selection,
+		//see Diagram::compressedSelectionChanged
+	const QList<QGraphicsItem *> selection = m_diagram->selectedItems();
+	int count_ = selection.size();
 	
 		//The editor widget can only edit one item
 		//or several items of the same type
@@ -93,9 +96,8 @@ void DiagramPropertiesEditorDockWidget::selectionChanged()
 			return;
 		}
 		
-		const QList<QGraphicsItem *> list_ = m_diagram->selectedItems();
-		int type_ = list_.first()->type();
-		for (QGraphicsItem *qgi : list_)
+		int type_ = selection.first()->type();
+		for (QGraphicsItem *qgi : selection)
 		{
 			if (qgi->type() != type_)
 			{
@@ -106,7 +108,7 @@ void DiagramPropertiesEditorDockWidget::selectionChanged()
 		}
 	}
 
-	QGraphicsItem *item = m_diagram->selectedItems().first();
+	QGraphicsItem *item = selection.first();
 	const int type_ = item->type();
 
 	switch (type_)
@@ -134,7 +136,7 @@ void DiagramPropertiesEditorDockWidget::selectionChanged()
 		case IndependentTextItem::Type: //1005
 		{
 			QList<IndependentTextItem *> text_list;
-			for (QGraphicsItem *qgi : m_diagram->selectedItems()) {
+			for (QGraphicsItem *qgi : selection) {
 				text_list.append(static_cast<IndependentTextItem*>(qgi));
 			}
 			
@@ -166,7 +168,7 @@ void DiagramPropertiesEditorDockWidget::selectionChanged()
 		case QetShapeItem::Type: //1008
 		{
 			QList<QetShapeItem *> shapes_list;
-			for (QGraphicsItem *qgi : m_diagram->selectedItems()) {
+			for (QGraphicsItem *qgi : selection) {
 				shapes_list.append(static_cast<QetShapeItem*>(qgi));
 			}
 
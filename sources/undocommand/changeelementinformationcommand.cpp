@@ -18,6 +18,18 @@
 #include "changeelementinformationcommand.h"
 #include "element.h"
 #include <QObject>
+#include <QDomDocument>
+
+namespace {
+	qint64 contextSize(const DiagramContext &context)
+	{
+		qint64 size = sizeof(DiagramContext);
+		for (const QString &key : context.keys()) {
+			size += sizeof(QVariant) + context.value(key).toString().size() * qint64(sizeof(QChar));
+		}
+		return size;
+	}
+}
 
 /**
  * @brief ChangeElementInformationCommand::ChangeElementInformationCommand
@@ -40,7 +52,10 @@ bool ChangeElementInformationCommand::mergeWith(const QUndoCommand *other)
 	if (id() != other->id()) return false;
 	ChangeElementInformationCommand const *undo = static_cast<const ChangeElementInformationCommand*>(other);
 	if (m_element != undo->m_element) return false;
+	rehydrate();
 	m_new_info = undo->m_new_info;
+		//The spilled data is now outdated
+	m_spill_offset = -1;
 	return true;
 }
 
@@ -48,6 +63,7 @@ bool ChangeElementInformationCommand::mergeWith(const QUndoCommand *other)
  * @brief ChangeElementInformationCommand::undo
  */
 void ChangeElementInformationCommand::undo() {
+	rehydrate();
 	m_element -> setElementInformations(m_old_info);
 }
 
@@ -55,5 +71,75 @@ void ChangeElementInformationCommand::undo() {
  * @brief ChangeElementInformationCommand::redo
  */
 void ChangeElementInformationCommand::redo() {
+	rehydrate();
 	m_element -> setElementInformations(m_new_info);
 }
+
+/**
+ * @brief ChangeElementInformationCommand::memorySize
+ * @return the estimated memory used by the informations kept by this command
+ */
+qint64 ChangeElementInformationCommand::memorySize() const
+{
+	if (m_spilled) {
+		return 0;
+	}
+	return contextSize(m_old_info) + contextSize(m_new_info);
+}
+
+/**
+ * @brief ChangeElementInformationCommand::spill
+ * Write the old and new informations to @file and free them
+ * @param file
+ * @return the number of bytes freed
+ */
+qint64 ChangeElementInformationCommand::spill(const QSharedPointer<UndoSpillFile> &file)
+{
+	if (m_spilled) {
+		return 0;
+	}
+
+		//The data is perhaps already in the file, if this command was rehydrated
+	if (m_spill_offset < 0)
+	{
+		QDomDocument document;
+		QDomElement root = document.createElement("informations");
+		QDomElement old_info = document.createElement("old");
+		QDomElement new_info = document.createElement("new");
+		m_old_info.toXml(old_info, "elementInformation");
+		m_new_info.toXml(new_info, "elementInformation");
+		root.appendChild(old_info);
+		root.appendChild(new_info);
+		document.appendChild(root);
+
+		m_spill_offset = file->write(document.toByteArray(-1));
+		if (m_spill_offset < 0) {
+			return 0;
+		}
+		m_spill_file = file;
+	}
+
+	qint64 freed = memorySize();
+	m_old_info = DiagramContext();
+	m_new_info = DiagramContext();
+	m_spilled = true;
+	return freed;
+}
+
+/**
+ * @brief ChangeElementInformationCommand::rehydrate
+ * Read back the informations spilled to the disk
+ */
+void ChangeElementInformationCommand::rehydrate()
+{
+	if (!m_spilled) {
+		return;
+	}
+
+	QDomDocument document;
+	document.setContent(m_spill_file->read(m_spill_offset));
+	QDomElement root = document.documentElement();
+	m_old_info.fromXml(root.firstChildElement("old"), "elementInformation");
+	m_new_info.fromXml(root.firstChildElement("new"), "elementInformation");
+	m_spilled = false;
+}
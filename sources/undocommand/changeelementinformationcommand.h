@@ -20,14 +20,17 @@
 
 #include <QUndoCommand>
 #include "diagramcontext.h"
+#include "undohistory.h"
 
 class Element;
 
 /**
  * @brief The ChangeElementInformationCommand class
  * This class manage undo/redo to change the element information.
+ * When the undo history is over its memory budget, the old and new
+ * informations are spilled to the disk and read back at the next undo/redo.
  */
-class ChangeElementInformationCommand : public QUndoCommand
+class ChangeElementInformationCommand : public QUndoCommand, public SpillableUndoCommand
 {
 	public:
 		ChangeElementInformationCommand(Element *elmt, DiagramContext &old_info, DiagramContext &new_info, QUndoCommand *parent = nullptr);
@@ -37,10 +40,19 @@ class ChangeElementInformationCommand : public QUndoCommand
 		void undo() override;
 		void redo() override;
 
+		qint64 memorySize() const override;
+		qint64 spill(const QSharedPointer<UndoSpillFile> &file) override;
+
+	private:
+		void rehydrate();
+
 	private:
 		Element       *m_element;
 		DiagramContext m_old_info,
 					   m_new_info;
+		QSharedPointer<UndoSpillFile> m_spill_file;
+		qint64 m_spill_offset = -1;
+		bool m_spilled = false;
 };
 
 #endif // CHANGEELEMENTINFORMATIONCOMMAND_H
@@ -19,6 +19,44 @@
 #include "changetitleblockcommand.h"
 #include "diagram.h"
 
+#include <QDomDocument>
+
+namespace {
+	qint64 propertiesSize(const TitleBlockProperties &properties)
+	{
+		qint64 size = sizeof(TitleBlockProperties);
+		const QStringList strings {properties.title, properties.author, properties.filename,
+								   properties.plant, properties.locmach, properties.indexrev,
+								   properties.version, properties.folio, properties.auto_page_num,
+								   properties.location, properties.template_name};
+		for (const QString &str : strings) {
+			size += str.size() * qint64(sizeof(QChar));
+		}
+		for (const QString &key : properties.context.keys()) {
+			size += sizeof(QVariant) + properties.context.value(key).toString().size() * qint64(sizeof(QChar));
+		}
+		return size;
+	}
+
+	/**
+	 * @brief propertiesToXml
+	 * TitleBlockProperties::toXml don't write the location, it is written here
+	 */
+	QDomElement propertiesToXml(QDomDocument &document, const QString &tag_name, const TitleBlockProperties &properties)
+	{
+		QDomElement e = document.createElement(tag_name);
+		properties.toXml(e);
+		e.setAttribute("location", properties.location);
+		return e;
+	}
+
+	void propertiesFromXml(const QDomElement &e, TitleBlockProperties &properties)
+	{
+		properties.fromXml(e);
+		properties.location = e.attribute("location");
+	}
+}
+
 /**
  * @brief ChangeTitleBlockCommand::ChangeTitleBlockCommand
  * @param d
@@ -40,8 +78,27 @@ ChangeTitleBlockCommand::ChangeTitleBlockCommand(
 
 ChangeTitleBlockCommand::~ChangeTitleBlockCommand() {}
 
+/**
+ * @brief ChangeTitleBlockCommand::mergeWith
+ * Merge @other if it change the title block of the same diagram
+ * @param other
+ * @return
+ */
+bool ChangeTitleBlockCommand::mergeWith(const QUndoCommand *other)
+{
+	if (id() != other->id()) return false;
+	const ChangeTitleBlockCommand *undo = static_cast<const ChangeTitleBlockCommand *>(other);
+	if (diagram != undo->diagram) return false;
+	rehydrate();
+	new_titleblock = undo->new_titleblock;
+		//The spilled data is now outdated
+	m_spill_offset = -1;
+	return true;
+}
+
 void ChangeTitleBlockCommand::undo()
 {
+	rehydrate();
 	diagram -> showMe();
 	diagram -> border_and_titleblock.importTitleBlock(old_titleblock);
 	diagram -> invalidate(diagram -> border_and_titleblock.borderAndTitleBlockRect());
@@ -49,7 +106,73 @@ void ChangeTitleBlockCommand::undo()
 
 void ChangeTitleBlockCommand::redo()
 {
+	rehydrate();
 	diagram -> showMe();
 	diagram -> border_and_titleblock.importTitleBlock(new_titleblock);
 	diagram -> invalidate(diagram -> border_and_titleblock.borderAndTitleBlockRect());
 }
+
+/**
+ * @brief ChangeTitleBlockCommand::memorySize
+ * @return the estimated memory used by the properties kept by this command
+ */
+qint64 ChangeTitleBlockCommand::memorySize() const
+{
+	if (m_spilled) {
+		return 0;
+	}
+	return propertiesSize(old_titleblock) + propertiesSize(new_titleblock);
+}
+
+/**
+ * @brief ChangeTitleBlockCommand::spill
+ * Write the old and new properties to @file and free them
+ * @param file
+ * @return the number of bytes freed
+ */
+qint64 ChangeTitleBlockCommand::spill(const QSharedPointer<UndoSpillFile> &file)
+{
+	if (m_spilled) {
+		return 0;
+	}
+
+		//The data is perhaps already in the file, if this command was rehydrated
+	if (m_spill_offset < 0)
+	{
+		QDomDocument document;
+		QDomElement root = document.createElement("titleblocks");
+		root.appendChild(propertiesToXml(document, "old", old_titleblock));
+		root.appendChild(propertiesToXml(document, "new", new_titleblock));
+		document.appendChild(root);
+
+		m_spill_offset = file->write(document.toByteArray(-1));
+		if (m_spill_offset < 0) {
+			return 0;
+		}
+		m_spill_file = file;
+	}
+
+	qint64 freed = memorySize();
+	old_titleblock = TitleBlockProperties();
+	new_titleblock = TitleBlockProperties();
+	m_spilled = true;
+	return freed;
+}
+
+/**
+ * @brief ChangeTitleBlockCommand::rehydrate
+ * Read back the properties spilled to the disk
+ */
+void ChangeTitleBlockCommand::rehydrate()
+{
+	if (!m_spilled) {
+		return;
+	}
+
+	QDomDocument document;
+	document.setContent(m_spill_file->read(m_spill_offset));
+	QDomElement root = document.documentElement();
+	propertiesFromXml(root.firstChildElement("old"), old_titleblock);
+	propertiesFromXml(root.firstChildElement("new"), new_titleblock);
+	m_spilled = false;
+}
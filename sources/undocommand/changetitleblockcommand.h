@@ -21,13 +21,16 @@
 #include <QUndoCommand>
 
 #include "titleblockproperties.h"
+#include "undohistory.h"
 
 class Diagram;
 /**
  * @brief The ChangeTitleBlockCommand class
  * This command changes the title block properties for a particular diagram.
+ * Consecutive changes of the same title block are merged, and the properties
+ * are spilled to the disk when the undo history is over its memory budget.
  */
-class ChangeTitleBlockCommand : public QUndoCommand
+class ChangeTitleBlockCommand : public QUndoCommand, public SpillableUndoCommand
 {
 	public:
 		ChangeTitleBlockCommand(Diagram *, const TitleBlockProperties &, const TitleBlockProperties &, QUndoCommand * = nullptr);
@@ -36,13 +39,24 @@ class ChangeTitleBlockCommand : public QUndoCommand
 		ChangeTitleBlockCommand(const ChangeTitleBlockCommand &);
 	
 	public:
+		int id() const override {return 7;}
+		bool mergeWith(const QUndoCommand *other) override;
 		void undo() override;
 		void redo() override;
+
+		qint64 memorySize() const override;
+		qint64 spill(const QSharedPointer<UndoSpillFile> &file) override;
 	
+	private:
+		void rehydrate();
+
 	private:
 		Diagram *diagram;
 		TitleBlockProperties old_titleblock;
 		TitleBlockProperties new_titleblock;
+		QSharedPointer<UndoSpillFile> m_spill_file;
+		qint64 m_spill_offset = -1;
+		bool m_spilled = false;
 };
 
 #endif // CHANGETITLEBLOCKCOMMAND_H
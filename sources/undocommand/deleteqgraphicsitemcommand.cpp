@@ -25,6 +25,7 @@
 #include "addelementtextcommand.h"
 #include "terminal.h"
 #include "diagramcommands.h"
+#include "memoryreport.h"
 
 /**
  * @brief DeleteQGraphicsItemCommand::DeleteQGraphicsItemCommand
@@ -278,3 +279,24 @@ void DeleteQGraphicsItemCommand::redo()
 	
 	QUndoCommand::redo();
 }
+
+/**
+ * @brief DeleteQGraphicsItemCommand::memorySize
+ * @return the estimated memory used by the removed elements and conductors,
+ * only when they are removed from the diagram (this command is done)
+ */
+qint64 DeleteQGraphicsItemCommand::memorySize() const
+{
+	qint64 size = 0;
+	for (Element *element : m_removed_contents.m_elements) {
+		if (!element->scene()) {
+			size += MemoryReport::elementSize(element);
+		}
+	}
+	for (Conductor *conductor : m_removed_contents.conductors()) {
+		if (!conductor->scene()) {
+			size += MemoryReport::conductorSize(conductor);
+		}
+	}
+	return size;
+}
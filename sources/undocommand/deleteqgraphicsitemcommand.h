@@ -20,12 +20,19 @@
 
 #include <QUndoCommand>
 #include "diagramcontent.h"
+#include "undohistory.h"
 
 class Diagram;
 class ElementTextItemGroup;
 class Terminal;
 
-class DeleteQGraphicsItemCommand : public QUndoCommand
+/**
+ * @brief The DeleteQGraphicsItemCommand class
+ * Remove items from a diagram. The removed items are kept alive by this command
+ * and are reported to the undo history as the memory used by the command.
+ * The items are not spilled : older commands of the stack keep pointers to them.
+ */
+class DeleteQGraphicsItemCommand : public QUndoCommand, public SpillableUndoCommand
 {
 	public:
 		DeleteQGraphicsItemCommand(Diagram *diagram, const DiagramContent &content, QUndoCommand * parent = nullptr);
@@ -40,6 +47,8 @@ class DeleteQGraphicsItemCommand : public QUndoCommand
 	public:
 		void undo() override;
 		void redo() override;
+
+		qint64 memorySize() const override;
 		
 		// attributes
 	private:
@@ -0,0 +1,263 @@
+/*
+	Copyright 2006-2019 The QElectroTech Team
+	This file is part of QElectroTech.
+	
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+	
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "undohistory.h"
+
+#include <QDataStream>
+#include <QSettings>
+#include <QUndoStack>
+
+/**
+ * @brief UndoSpillFile::write
+ * Append @data to the file
+ * @param data
+ * @return the offset to give to read() to retrieve @data, or -1 if the file can't be written
+ */
+qint64 UndoSpillFile::write(const QByteArray &data)
+{
+	if (!m_file.isOpen() && !m_file.open()) {
+		return -1;
+	}
+
+	qint64 offset = m_file.size();
+	if (!m_file.seek(offset)) {
+		return -1;
+	}
+	QDataStream stream(&m_file);
+	stream << qCompress(data);
+	if (stream.status() != QDataStream::Ok) {
+		return -1;
+	}
+	return offset;
+}
+
+/**
+ * @brief UndoSpillFile::read
+ * @param offset
+ * @return the data stored at @offset
+ */
+QByteArray UndoSpillFile::read(qint64 offset)
+{
+	if (!m_file.isOpen() || !m_file.seek(offset)) {
+		return QByteArray();
+	}
+
+	QByteArray data;
+	QDataStream stream(&m_file);
+	stream >> data;
+	return qUncompress(data);
+}
+
+/**
+ * @brief UndoSpillFile::size
+ * @return the size of the file in bytes
+ */
+qint64 UndoSpillFile::size() const {
+	return m_file.isOpen() ? m_file.size() : 0;
+}
+
+/**
+ * @brief SpillableUndoCommand::spill
+ * Store the data of the command in @file and free it from the memory.
+ * The default implementation does nothing : the command only report its memory.
+ * @param file
+ * @return the number of bytes freed
+ */
+qint64 SpillableUndoCommand::spill(const QSharedPointer<UndoSpillFile> &file)
+{
+	Q_UNUSED(file)
+	return 0;
+}
+
+/**
+ * @brief UndoHistory::UndoHistory
+ * @param stack : the undo stack to watch
+ * @param parent
+ */
+UndoHistory::UndoHistory(QUndoStack *stack, QObject *parent) :
+	QObject(parent),
+	m_stack(stack),
+	m_file(new UndoSpillFile())
+{
+	QSettings settings;
+	m_budget = settings.value("diagrameditor/undo_memory_budget", 32).toLongLong() * 1024 * 1024;
+	if (m_stack->count() == 0) {
+		m_stack->setUndoLimit(settings.value("diagrameditor/undo_limit", 0).toInt());
+	}
+	connect(m_stack, &QUndoStack::indexChanged, this, &UndoHistory::stackIndexChanged);
+	stackIndexChanged();
+}
+
+/**
+ * @brief UndoHistory::memorySize
+ * @return the estimated memory used by the commands of the stack, in bytes
+ */
+qint64 UndoHistory::memorySize() const {
+	return m_memory_size;
+}
+
+/**
+ * @brief UndoHistory::spilledSize
+ * @return the size of the data spilled to the disk, in bytes
+ */
+qint64 UndoHistory::spilledSize() const {
+	return m_file->size();
+}
+
+/**
+ * @brief UndoHistory::setBudget
+ * @param budget : the memory budget of the stack in bytes, 0 or less to disable it
+ */
+void UndoHistory::setBudget(qint64 budget)
+{
+	m_budget = budget;
+	enforceBudget();
+}
+
+/**
+ * @brief UndoHistory::commandSize
+ * @param command
+ * @return the estimated memory used by @command and its children, in bytes
+ */
+qint64 UndoHistory::commandSize(const QUndoCommand *command)
+{
+	qint64 size = sizeof(QUndoCommand) + command->text().size() * qint64(sizeof(QChar));
+	if (const SpillableUndoCommand *suc = dynamic_cast<const SpillableUndoCommand *>(command)) {
+		size += suc->memorySize();
+	}
+	for (int i = 0 ; i < command->childCount() ; ++i) {
+		size += commandSize(command->child(i));
+	}
+	return size;
+}
+
+namespace {
+	/**
+	 * @brief spillCommand
+	 * Spill @command and its children to @file
+	 * @return the number of bytes freed
+	 */
+	qint64 spillCommand(QUndoCommand *command, const QSharedPointer<UndoSpillFile> &file)
+	{
+		qint64 freed = 0;
+		if (SpillableUndoCommand *suc = dynamic_cast<SpillableUndoCommand *>(command)) {
+			freed += suc->spill(file);
+		}
+		for (int i = 0 ; i < command->childCount() ; ++i) {
+			freed += spillCommand(const_cast<QUndoCommand *>(command->child(i)), file);
+		}
+		return freed;
+	}
+}
+
+/**
+ * @brief UndoHistory::stackIndexChanged
+ * Update the list of the commands and their size, then enforce the budget.
+ * Commands are only added or removed at the end of the stack (push, redo commands
+ * discarded by a push) or at its beginning (undo limit). The size of the commands
+ * between the previous and the new index is estimated again, because they were
+ * just pushed, merged, undone or redone.
+ */
+void UndoHistory::stackIndexChanged()
+{
+	const int count = m_stack->count();
+
+		//Oldest commands deleted by the undo limit
+	int first = 0;
+	while (first < m_commands.size() && (count == 0 || m_commands.at(first) != m_stack->command(0))) {
+		m_memory_size -= m_sizes.at(first);
+		++first;
+	}
+	m_commands.remove(0, first);
+	m_sizes.remove(0, first);
+	m_spilled.remove(0, first);
+
+		//Commands deleted or replaced at the end of the stack
+	int common = qMin(m_commands.size(), count);
+	while (common > 0 && m_commands.at(common - 1) != m_stack->command(common - 1)) {
+		--common;
+	}
+	for (int i = common ; i < m_commands.size() ; ++i) {
+		m_memory_size -= m_sizes.at(i);
+	}
+	m_commands.resize(common);
+	m_sizes.resize(common);
+	m_spilled.resize(common);
+
+		//New commands
+	for (int i = common ; i < count ; ++i)
+	{
+		m_commands << m_stack->command(i);
+		m_sizes << 0;
+		m_spilled << false;
+		updateCommandSize(i);
+	}
+
+	const int index = m_stack->index();
+	for (int i = qMin(index, m_index) - 1 ; i <= qMax(index, m_index) ; ++i) {
+		updateCommandSize(i);
+	}
+	m_index = index;
+
+	enforceBudget();
+	emit sizeChanged();
+}
+
+/**
+ * @brief UndoHistory::updateCommandSize
+ * Estimate again the size of the command at @index of the stack, if any.
+ * A spilled command read back its data when it is undone or redone,
+ * so it can be spilled again.
+ * @param index
+ */
+void UndoHistory::updateCommandSize(int index)
+{
+	if (index < 0 || index >= m_commands.size()) {
+		return;
+	}
+	const qint64 size = commandSize(m_commands.at(index));
+	m_memory_size += size - m_sizes.at(index);
+	m_sizes[index] = size;
+	m_spilled[index] = false;
+}
+
+/**
+ * @brief UndoHistory::enforceBudget
+ * If the commands of the stack use more memory than the budget,
+ * spill the oldest commands until the budget is respected.
+ * The command at the current index is never spilled, he is the most likely to be undone.
+ * Each command is only spilled once : the commands which can't be spilled
+ * are not checked again at each change of the stack.
+ */
+void UndoHistory::enforceBudget()
+{
+	if (m_budget <= 0) {
+		return;
+	}
+
+	const int last = qMin(m_stack->index() - 1, m_commands.size());
+	for (int i = 0 ; i < last && m_memory_size > m_budget ; ++i)
+	{
+		if (m_spilled.at(i)) {
+			continue;
+		}
+		m_spilled[i] = true;
+		const qint64 freed = spillCommand(const_cast<QUndoCommand *>(m_commands.at(i)), m_file);
+		m_sizes[i] -= freed;
+		m_memory_size -= freed;
+	}
+}
@@ -0,0 +1,113 @@
+/*
+	Copyright 2006-2019 The QElectroTech Team
+	This file is part of QElectroTech.
+	
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+	
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef UNDOHISTORY_H
+#define UNDOHISTORY_H
+
+#include <QObject>
+#include <QSharedPointer>
+#include <QTemporaryFile>
+#include <QVector>
+
+class QUndoStack;
+class QUndoCommand;
+
+/**
+ * @brief The UndoSpillFile class
+ * Temporary file where the undo commands store their data when the undo history
+ * is over its memory budget. Each data is compressed and appended to the file,
+ * and retrieved with the offset returned by write().
+ */
+class UndoSpillFile
+{
+	public:
+		qint64 write(const QByteArray &data);
+		QByteArray read(qint64 offset);
+		qint64 size() const;
+
+	private:
+		QTemporaryFile m_file;
+};
+
+/**
+ * @brief The SpillableUndoCommand class
+ * Interface of the undo commands which can report the memory they use,
+ * and store their data in an UndoSpillFile when they are old enough.
+ * A spilled command read back its data from the file at the next undo or redo.
+ */
+class SpillableUndoCommand
+{
+	public:
+		virtual ~SpillableUndoCommand() {}
+		virtual qint64 memorySize() const = 0;
+		virtual qint64 spill(const QSharedPointer<UndoSpillFile> &file);
+};
+
+/**
+ * @brief The UndoHistory class
+ * Keep the memory used by the commands of an undo stack under a budget.
+ * The memory of each command is estimated when it is pushed, and estimated again
+ * when it is undone, redone or merged; a running total is kept.
+ * If the budget is exceeded, the oldest spillable commands are spilled to a temporary file.
+ * The budget is read from the setting "diagrameditor/undo_memory_budget" (in MiB).
+ *
+ * Some commands (delete, cut, paste) keep graphics items and can't be spilled.
+ * The history isn't limited : the budget is only enforced by spilling the commands.
+ * A limit of the number of commands can still be set through the setting
+ * "diagrameditor/undo_limit" (0 by default, for no limit), it's applied at construction
+ * because QUndoStack only accepts an undo limit while the stack is empty.
+ */
+class UndoHistory : public QObject
+{
+	Q_OBJECT
+
+	public:
+		UndoHistory(QUndoStack *stack, QObject *parent = nullptr);
+
+		qint64 memorySize() const;
+		qint64 spilledSize() const;
+		qint64 budget() const {return m_budget;}
+		void setBudget(qint64 budget);
+
+		static qint64 commandSize(const QUndoCommand *command);
+
+	signals:
+			///Emitted when the memory used by the commands or spilled to the disk changed
+		void sizeChanged();
+
+	public slots:
+		void enforceBudget();
+
+	private slots:
+		void stackIndexChanged();
+
+	private:
+		void updateCommandSize(int index);
+
+	private:
+		QUndoStack *m_stack;
+		QSharedPointer<UndoSpillFile> m_file;
+		qint64 m_budget;
+			///The commands of the stack, their size and if they were already spilled, in the order of the stack
+		QVector<const QUndoCommand *> m_commands;
+		QVector<qint64> m_sizes;
+		QVector<bool> m_spilled;
+		qint64 m_memory_size = 0;
+		int m_index = 0;
+};
+
+#endif // UNDOHISTORY_H
@@ -0,0 +1,232 @@
+/*
+	Copyright 2006-2019 The QElectroTech Team
+	This file is part of QElectroTech.
+	
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+	
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "qettrace.h"
+
+#include <QAtomicInt>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QThread>
+#include <QVector>
+
+/**
+	Number of events kept by each thread, the oldest events are overwritten
+*/
+#define QET_TRACE_BUFFER_SIZE 65536
+
+namespace {
+	struct Event
+	{
+		const char *name;
+		qint64 begin;
+		qint64 end;
+	};
+
+	/**
+	 * @brief The Buffer struct
+	 * Ring buffer of the events of a thread.
+	 * The mutex is only shared with the writing of the trace, so it is never contended
+	 * while recording.
+	 */
+	struct Buffer
+	{
+		QMutex mutex;
+		QVector<Event> events;
+		int next = 0;
+		bool full = false;
+		int thread_id = 0;
+		QString thread_name;
+	};
+
+	/**
+	 * @brief The Registry struct
+	 * Own the buffers of every thread which recorded at least one event.
+	 * The buffers are kept when their thread end, to be written in the trace.
+	 */
+	struct Registry
+	{
+		~Registry() {qDeleteAll(buffers);}
+
+		QMutex mutex;
+		QList<Buffer *> buffers;
+		QElapsedTimer timer;
+		QString file_path;
+	};
+
+	QAtomicInt enabled(0);
+
+	Registry &registry()
+	{
+		static Registry registry;
+		return registry;
+	}
+
+	/**
+	 * @brief threadBuffer
+	 * @return the buffer of the current thread, created at the first call
+	 */
+	Buffer *threadBuffer()
+	{
+		static thread_local Buffer *buffer = nullptr;
+		if (!buffer)
+		{
+			buffer = new Buffer();
+			buffer->events.resize(QET_TRACE_BUFFER_SIZE);
+			buffer->thread_name = QThread::currentThread()->objectName();
+			if (buffer->thread_name.isEmpty() && QCoreApplication::instance() &&
+				QThread::currentThread() == QCoreApplication::instance()->thread()) {
+				buffer->thread_name = "Main thread";
+			}
+
+			Registry &r = registry();
+			QMutexLocker locker(&r.mutex);
+			buffer->thread_id = r.buffers.size() + 1;
+			r.buffers << buffer;
+		}
+		return buffer;
+	}
+}
+
+/**
+ * @brief QetTrace::start
+ * Start the recording of the events
+ * @param file_path : the file written by stop()
+ */
+void QetTrace::start(const QString &file_path)
+{
+	Registry &r = registry();
+	{
+		QMutexLocker locker(&r.mutex);
+		r.file_path = file_path;
+		if (!r.timer.isValid()) {
+			r.timer.start();
+		}
+	}
+	enabled.store(1);
+}
+
+/**
+ * @brief QetTrace::stop
+ * Stop the recording and write the events in the file given to start()
+ * @return true if the recording was started and the file is written
+ */
+bool QetTrace::stop()
+{
+	if (!enabled.load()) {
+		return false;
+	}
+	enabled.store(0);
+
+	QString file_path;
+	{
+		QMutexLocker locker(&registry().mutex);
+		file_path = registry().file_path;
+	}
+	return writeChromeTrace(file_path);
+}
+
+/**
+ * @brief QetTrace::isEnabled
+ * @return true if the events are recorded
+ */
+bool QetTrace::isEnabled() {
+	return enabled.load();
+}
+
+/**
+ * @brief QetTrace::now
+ * @return the time elapsed since the start of the recording, in nanoseconds
+ */
+qint64 QetTrace::now() {
+	return registry().timer.nsecsElapsed();
+}
+
+/**
+ * @brief QetTrace::record
+ * Record an event of the current thread
+ * @param name : name of the event, must be a string literal
+ * @param begin
+ * @param end
+ */
+void QetTrace::record(const char *name, qint64 begin, qint64 end)
+{
+	Buffer *buffer = threadBuffer();
+	QMutexLocker locker(&buffer->mutex);
+	buffer->events[buffer->next] = Event{name, begin, end};
+	if (++buffer->next == QET_TRACE_BUFFER_SIZE) {
+		buffer->next = 0;
+		buffer->full = true;
+	}
+}
+
+/**
+ * @brief QetTrace::writeChromeTrace
+ * Write the recorded events in @file_path, in the Chrome trace_event json format
+ * @param file_path
+ * @return true if the file is written
+ */
+bool QetTrace::writeChromeTrace(const QString &file_path)
+{
+	QJsonArray events;
+	const qint64 pid = QCoreApplication::applicationPid();
+
+	Registry &r = registry();
+	QMutexLocker registry_locker(&r.mutex);
+	for (Buffer *buffer : r.buffers)
+	{
+		QMutexLocker locker(&buffer->mutex);
+
+		QJsonObject thread_name;
+		thread_name.insert("name", "thread_name");
+		thread_name.insert("ph", "M");
+		thread_name.insert("pid", pid);
+		thread_name.insert("tid", buffer->thread_id);
+		thread_name.insert("args", QJsonObject{{"name", buffer->thread_name.isEmpty()
+													   ? QString("Thread %1").arg(buffer->thread_id)
+													   : buffer->thread_name}});
+		events.append(thread_name);
+
+		const int count = buffer->full ? QET_TRACE_BUFFER_SIZE : buffer->next;
+		const int first = buffer->full ? buffer->next : 0;
+		for (int i = 0 ; i < count ; ++i)
+		{
+			const Event &event = buffer->events.at((first + i) % QET_TRACE_BUFFER_SIZE);
+			QJsonObject json;
+			json.insert("name", QString::fromLatin1(event.name));
+			json.insert("ph", "X");
+			json.insert("pid", pid);
+			json.insert("tid", buffer->thread_id);
+			json.insert("ts", event.begin / 1000.0);
+			json.insert("dur", (event.end - event.begin) / 1000.0);
+			events.append(json);
+		}
+	}
+
+	QFile file(file_path);
+	if (!file.open(QIODevice::WriteOnly)) {
+		return false;
+	}
+	QJsonObject trace;
+	trace.insert("traceEvents", events);
+	trace.insert("displayTimeUnit", "ms");
+	return file.write(QJsonDocument(trace).toJson(QJsonDocument::Compact)) >= 0;
+}
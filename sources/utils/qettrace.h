@@ -0,0 +1,77 @@
+/*
+	Copyright 2006-2019 The QElectroTech Team
+	This file is part of QElectroTech.
+	
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+	
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef QETTRACE_H
+#define QETTRACE_H
+
+#include <QString>
+#include <QtGlobal>
+
+/**
+	Tracing of the hot paths of QElectroTech.
+	A QET_TRACE("name") placed at the beginning of a block records the duration
+	of the block, in a ring buffer owned by the current thread.
+	Recording is started with the --trace=FILE option, the events are written
+	at the end of the execution in FILE, in the Chrome trace_event json format
+	(to open with chrome://tracing or https://ui.perfetto.dev).
+	When QET_ENABLE_TRACING is not defined, QET_TRACE expands to nothing ;
+	else, when the recording is not started, a QET_TRACE only cost a test.
+	The name given to QET_TRACE must be a string literal.
+*/
+namespace QetTrace
+{
+	void start(const QString &file_path);
+	bool stop();
+	bool isEnabled();
+	bool writeChromeTrace(const QString &file_path);
+
+	void record(const char *name, qint64 begin, qint64 end);
+	qint64 now();
+
+	/**
+	 * @brief The Scope class
+	 * Record the duration of its lifetime, used through QET_TRACE
+	 */
+	class Scope
+	{
+		public:
+			explicit Scope(const char *name) :
+				m_name(name),
+				m_begin(isEnabled() ? now() : -1)
+			{}
+			~Scope() {
+				if (m_begin >= 0) {
+					record(m_name, m_begin, now());
+				}
+			}
+
+		private:
+			Q_DISABLE_COPY(Scope)
+			const char *m_name;
+			const qint64 m_begin;
+	};
+}
+
+#ifdef QET_ENABLE_TRACING
+#define QET_TRACE_CONCAT_(a, b) a##b
+#define QET_TRACE_CONCAT(a, b) QET_TRACE_CONCAT_(a, b)
+#define QET_TRACE(name) QetTrace::Scope QET_TRACE_CONCAT(qet_trace_scope_, __LINE__)(name)
+#else
+#define QET_TRACE(name)
+#endif
+
+#endif // QETTRACE_H